@@ -0,0 +1,956 @@
+#include "MockServer.hpp"
+#include "../../TarkovAPI/src/Constants.hpp"
+
+#include <chrono>
+#include <thread>
+#include <random>
+#include <algorithm>
+#include <iterator>
+#include <iostream>
+
+#include <zlib.h>
+#include <fmt/format.h>
+
+namespace TarkovAPI
+{
+    namespace
+    {
+        enum MockIdKind : uint32_t
+        {
+            KIND_TEMPLATE = 1,
+            KIND_TRADER,
+            KIND_ASSORT_ITEM,
+            KIND_PROFILE,
+            KIND_PROFILE_ITEM,
+            KIND_OFFER,
+            KIND_DIALOG,
+            KIND_MAIL_ITEM,
+            KIND_CREATED_ITEM
+        };
+
+        static constexpr auto STASH_TEMPLATE_ID = "566abbc34bdc2d92178b4576";
+        static constexpr auto EQUIPMENT_TEMPLATE_ID = "55d7217a4bdc2d86028b456d";
+        static constexpr auto STASH_WIDTH = 10;
+        static constexpr auto STASH_HEIGHT = 28;
+
+        static const char* TRADER_NICKNAMES[] = { "Prapor", "Therapist", "Fence", "Skier", "Peacekeeper", "Mechanic", "Ragman", "Jaeger" };
+        static constexpr auto TRADER_COUNT = sizeof(TRADER_NICKNAMES) / sizeof(TRADER_NICKNAMES[0]);
+
+        void CloseSocket(socket_t sock)
+        {
+#ifdef _WIN32
+            closesocket(sock);
+#else
+            close(sock);
+#endif
+        }
+
+        void ShutdownSocket(socket_t sock)
+        {
+#ifdef _WIN32
+            shutdown(sock, SD_BOTH);
+#else
+            shutdown(sock, SHUT_RDWR);
+#endif
+        }
+
+        bool SendAll(socket_t sock, const std::string& data)
+        {
+            size_t sent = 0;
+            while (sent < data.size())
+            {
+                auto ret = send(sock, data.data() + sent, static_cast<int>(data.size() - sent), 0);
+                if (ret <= 0)
+                {
+                    return false;
+                }
+                sent += static_cast<size_t>(ret);
+            }
+            return true;
+        }
+
+        int64_t GetUnixTime()
+        {
+            return std::chrono::duration_cast<std::chrono::seconds>(std::chrono::system_clock::now().time_since_epoch()).count();
+        }
+
+        uint64_t GetIdIndex(const std::string& id)
+        {
+            return (id.size() == 24) ? std::strtoull(id.substr(8).c_str(), nullptr, 16) : 0;
+        }
+
+        // First templates are the ones client code looks up by name
+        std::string GetTemplateId(size_t index)
+        {
+            switch (index)
+            {
+            case 0:
+                return STASH_TEMPLATE_ID;
+            case 1:
+                return ROUBLE_ITEM_ID;
+            case 2:
+                return USD_ITEM_ID;
+            case 3:
+                return EURO_ITEM_ID;
+            case 4:
+                return EQUIPMENT_TEMPLATE_ID;
+            default:
+                return MockServer::MakeId(KIND_TEMPLATE, index);
+            }
+        }
+        std::string GetTemplateName(size_t index)
+        {
+            switch (index)
+            {
+            case 0:
+                return "Stash";
+            case 1:
+                return "Roubles";
+            case 2:
+                return "Dollars";
+            case 3:
+                return "Euros";
+            case 4:
+                return "Default Inventory";
+            default:
+                return fmt::format("Mock item {}", index);
+            }
+        }
+        int32_t GetTemplateWidth(size_t index)
+        {
+            return (index < 5) ? 1 : static_cast<int32_t>(1 + index % 3);
+        }
+        int32_t GetTemplateHeight(size_t index)
+        {
+            return (index < 5) ? 1 : static_cast<int32_t>(1 + (index / 3) % 2);
+        }
+        int64_t GetTemplatePrice(size_t index)
+        {
+            return 1000 + static_cast<int64_t>((index * 7919) % 100000);
+        }
+    }
+
+    MockServer::MockServer(const MockServerConfig& config) :
+        m_kConfig(config), m_nListenSocket(static_cast<socket_t>(-1))
+    {
+        m_kConfig.items = std::max<size_t>(m_kConfig.items, 8);
+    }
+    MockServer::~MockServer()
+    {
+        Stop();
+
+#ifdef _WIN32
+        WSACleanup();
+#endif
+    }
+
+    std::string MockServer::MakeId(uint32_t kind, uint64_t index)
+    {
+        return fmt::format("{:08x}{:016x}", kind, index);
+    }
+
+    std::string MockServer::Compress(const std::string& data)
+    {
+        auto out = std::string(compressBound(static_cast<uLong>(data.size())), '\0');
+
+        auto out_size = static_cast<uLongf>(out.size());
+        auto ret = compress2(reinterpret_cast<Bytef*>(&out[0]), &out_size, reinterpret_cast<const Bytef*>(data.data()), static_cast<uLong>(data.size()), Z_DEFAULT_COMPRESSION);
+        if (Z_OK != ret)
+        {
+            throw std::runtime_error(fmt::format("compress2 failed: {}", ret));
+        }
+
+        out.resize(out_size);
+        return out;
+    }
+
+    bool MockServer::Listen()
+    {
+#ifdef _WIN32
+        WSADATA wsa_data{};
+        if (WSAStartup(MAKEWORD(2, 2), &wsa_data))
+        {
+            return false;
+        }
+#endif
+
+        m_nListenSocket = socket(AF_INET, SOCK_STREAM, IPPROTO_TCP);
+        if (m_nListenSocket == static_cast<socket_t>(-1))
+        {
+            return false;
+        }
+
+        auto reuse = 1;
+        setsockopt(m_nListenSocket, SOL_SOCKET, SO_REUSEADDR, reinterpret_cast<const char*>(&reuse), sizeof(reuse));
+
+        sockaddr_in addr{};
+        addr.sin_family = AF_INET;
+        addr.sin_port = htons(m_kConfig.port);
+        addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+
+        if (bind(m_nListenSocket, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) || listen(m_nListenSocket, SOMAXCONN))
+        {
+            CloseSocket(m_nListenSocket);
+            m_nListenSocket = static_cast<socket_t>(-1);
+            return false;
+        }
+
+        auto addr_size = static_cast<socklen_t>(sizeof(addr));
+        if (!getsockname(m_nListenSocket, reinterpret_cast<sockaddr*>(&addr), &addr_size))
+        {
+            m_kConfig.port = ntohs(addr.sin_port);
+        }
+
+        m_bRunning = true;
+        return true;
+    }
+
+    void MockServer::Run()
+    {
+        while (m_bRunning)
+        {
+            auto client = accept(m_nListenSocket, nullptr, nullptr);
+            if (client == static_cast<socket_t>(-1))
+            {
+                continue;
+            }
+
+            auto no_delay = 1;
+            setsockopt(client, IPPROTO_TCP, TCP_NODELAY, reinterpret_cast<const char*>(&no_delay), sizeof(no_delay));
+
+            auto finished = std::vector <std::thread>();
+            {
+                std::lock_guard <std::mutex> lock(m_pkConnectionMutex);
+
+                // Stop already collected connections, nobody would join this one
+                if (!m_bRunning)
+                {
+                    CloseSocket(client);
+                    break;
+                }
+
+                finished.swap(m_vFinished);
+                m_pkConnections.emplace(client, std::thread(&MockServer::HandleConnection, this, client));
+            }
+
+            for (auto& thread : finished)
+            {
+                thread.join();
+            }
+        }
+    }
+
+    void MockServer::Stop()
+    {
+        if (!m_bRunning.exchange(false))
+        {
+            return;
+        }
+
+#ifndef _WIN32
+        shutdown(m_nListenSocket, SHUT_RDWR);
+#endif
+        CloseSocket(m_nListenSocket);
+        m_nListenSocket = static_cast<socket_t>(-1);
+
+        // Wake connections blocked in recv, sockets are closed by their own thread
+        auto threads = std::vector <std::thread>();
+        {
+            std::lock_guard <std::mutex> lock(m_pkConnectionMutex);
+
+            for (auto& [client, thread] : m_pkConnections)
+            {
+                ShutdownSocket(client);
+                threads.emplace_back(std::move(thread));
+            }
+            m_pkConnections.clear();
+
+            std::move(m_vFinished.begin(), m_vFinished.end(), std::back_inserter(threads));
+            m_vFinished.clear();
+        }
+
+        for (auto& thread : threads)
+        {
+            thread.join();
+        }
+    }
+
+    uint16_t MockServer::GetPort() const
+    {
+        return m_kConfig.port;
+    }
+
+    uint64_t MockServer::GetRequestCount() const
+    {
+        return m_nRequests;
+    }
+
+    void MockServer::ApplyLatency() const
+    {
+        thread_local std::mt19937 rng{ std::random_device{}() };
+
+        auto delay = m_kConfig.latency_ms;
+        if (m_kConfig.jitter_ms)
+        {
+            delay += std::uniform_int_distribution<uint32_t>(0, m_kConfig.jitter_ms)(rng);
+        }
+        if (delay)
+        {
+            std::this_thread::sleep_for(std::chrono::milliseconds(delay));
+        }
+    }
+
+    void MockServer::HandleConnection(socket_t client)
+    {
+        auto buffer = std::string();
+        char chunk[16 * 1024];
+
+        while (m_bRunning)
+        {
+            auto header_end = buffer.find("\r\n\r\n");
+            if (header_end == std::string::npos)
+            {
+                auto received = recv(client, chunk, sizeof(chunk), 0);
+                if (received <= 0)
+                {
+                    break;
+                }
+                buffer.append(chunk, static_cast<size_t>(received));
+                continue;
+            }
+
+            auto header = buffer.substr(0, header_end);
+            std::transform(header.begin(), header.end(), header.begin(), [](char c) { return static_cast<char>(std::tolower(static_cast<unsigned char>(c))); });
+
+            // Request line: POST /path?query HTTP/1.1
+            auto path_begin = buffer.find(' ');
+            auto path_end = buffer.find(' ', path_begin + 1);
+            if (path_begin == std::string::npos || path_end == std::string::npos || path_end > header_end)
+            {
+                break;
+            }
+            auto path = buffer.substr(path_begin + 1, path_end - path_begin - 1);
+            path = path.substr(0, path.find('?'));
+
+            size_t content_length = 0;
+            auto length_pos = header.find("\r\ncontent-length:");
+            if (length_pos != std::string::npos)
+            {
+                content_length = std::strtoull(header.c_str() + length_pos + 17, nullptr, 10);
+            }
+            if (header.find("\r\nexpect: 100-continue") != std::string::npos && buffer.size() < header_end + 4 + content_length)
+            {
+                SendAll(client, "HTTP/1.1 100 Continue\r\n\r\n");
+            }
+            auto keep_alive = header.find("\r\nconnection: close") == std::string::npos;
+
+            auto received = 1;
+            while (received > 0 && buffer.size() < header_end + 4 + content_length)
+            {
+                received = static_cast<int>(recv(client, chunk, sizeof(chunk), 0));
+                if (received > 0)
+                {
+                    buffer.append(chunk, static_cast<size_t>(received));
+                }
+            }
+            if (received <= 0)
+            {
+                break;
+            }
+
+            auto body = buffer.substr(header_end + 4, content_length);
+            buffer.erase(0, header_end + 4 + content_length);
+
+            m_nRequests++;
+            ApplyLatency();
+
+            auto payload = std::string();
+            auto status = std::string("200 OK");
+            try
+            {
+                payload = Route(path, body);
+                if (payload.empty())
+                {
+                    status = "404 Not Found";
+                    payload = "Not Found";
+                }
+            }
+            catch (const std::exception& ex)
+            {
+                status = "500 Internal Server Error";
+                payload = ex.what();
+            }
+
+            auto response = fmt::format(
+                "HTTP/1.1 {}\r\nContent-Type: application/json\r\nContent-Length: {}\r\nConnection: {}\r\n\r\n",
+                status, payload.size(), keep_alive ? "keep-alive" : "close"
+            );
+            response += payload;
+
+            if (!SendAll(client, response) || !keep_alive)
+            {
+                break;
+            }
+        }
+
+        // Closed under lock, so Stop never shuts down a socket number already reused by accept
+        std::lock_guard <std::mutex> lock(m_pkConnectionMutex);
+
+        auto it = m_pkConnections.find(client);
+        if (it != m_pkConnections.end())
+        {
+            m_vFinished.emplace_back(std::move(it->second));
+            m_pkConnections.erase(it);
+        }
+        CloseSocket(client);
+    }
+
+    std::string MockServer::GetCachedPayload(const std::string& key, const std::function<json()>& builder, int64_t client_crc)
+    {
+        auto select = [client_crc](const CachedPayload& cached) {
+            return (client_crc && client_crc == cached.crc) ? cached.not_modified : cached.payload;
+        };
+
+        {
+            std::lock_guard <std::mutex> lock(m_pkCacheMutex);
+
+            auto it = m_pkPayloadCache.find(key);
+            if (it != m_pkPayloadCache.end())
+            {
+                return select(it->second);
+            }
+        }
+
+        auto data = builder();
+        auto dump = data.dump();
+
+        auto cached = CachedPayload{};
+        cached.crc = static_cast<int64_t>(crc32(0L, reinterpret_cast<const Bytef*>(dump.data()), static_cast<uInt>(dump.size())));
+        cached.payload = Compress(CachedEnvelope(std::move(data), cached.crc).dump());
+        cached.not_modified = Compress(CachedEnvelope(json(), cached.crc).dump());
+
+        std::lock_guard <std::mutex> lock(m_pkCacheMutex);
+        return select(m_pkPayloadCache.emplace(key, std::move(cached)).first->second);
+    }
+
+    json MockServer::Envelope(json&& data, int64_t err, const std::string& errmsg)
+    {
+        auto j = json::object();
+        j["err"] = err;
+        j["errmsg"] = errmsg.empty() ? json() : json(errmsg);
+        j["data"] = std::move(data);
+        return j;
+    }
+
+    json MockServer::CachedEnvelope(json&& data, int64_t crc)
+    {
+        auto j = Envelope(std::move(data));
+        j["crc"] = crc;
+        return j;
+    }
+
+    std::string MockServer::Route(const std::string& path, const std::string& body)
+    {
+        auto starts_with = [&path](const char* prefix) {
+            return path.compare(0, std::char_traits<char>::length(prefix), prefix) == 0;
+        };
+        auto tail = [&path](const char* prefix) {
+            return path.substr(std::char_traits<char>::length(prefix));
+        };
+        auto request = [&body]() {
+            return body.empty() ? json::object() : json::parse(body, nullptr, false);
+        };
+        auto request_crc = [&request]() {
+            auto j = request();
+            return (j.is_object() && j.contains("crc") && j["crc"].is_number()) ? j["crc"].get<int64_t>() : int64_t(0);
+        };
+
+        // Launcher
+        if (path == "/launcher/GetLauncherDistrib")
+            return Compress(Envelope(BuildLauncherDistrib()).dump());
+        if (path == "/launcher/GetPatchList")
+            return Compress(Envelope(BuildPatchList()).dump());
+        if (path == "/launcher/login")
+            return Compress(Envelope(BuildLogin()).dump());
+        if (path == "/launcher/hardwareCode/activate")
+            return Compress(Envelope(json()).dump());
+        if (path == "/launcher/game/start")
+            return Compress(Envelope(BuildGameStart()).dump());
+
+        // Game
+        if (path == "/client/game/keepalive")
+            return Compress(Envelope(json{ { "msg", "OK" }, { "utc_time", GetUnixTime() } }).dump());
+        if (path == "/client/game/profile/list")
+            return Compress(Envelope(BuildProfiles()).dump());
+        if (path == "/client/game/profile/select")
+            return Compress(Envelope(json{ { "status", "ok" } }).dump());
+        if (path == "/client/game/profile/items/moving")
+            return Compress(Envelope(BuildItemsMoving(request())).dump());
+        if (path == "/client/friend/list")
+            return Compress(Envelope(json{ { "Friends", json::array() }, { "Ignore", json::array() }, { "InIgnoreList", json::array() } }).dump());
+        if (path == "/client/weather")
+            return Compress(Envelope(json{ { "weather", { { "cloud", 0.1 }, { "wind_speed", 2 }, { "rain", 1 }, { "fog", 0.0 }, { "temp", 18 } } }, { "acceleration", 7 } }).dump());
+        if (path == "/client/items")
+            return GetCachedPayload(path, [this]() { return BuildItems(); }, request_crc());
+        if (path == "/client/items/prices")
+            return GetCachedPayload(path, [this]() { return BuildItemPrices(); }, request_crc());
+        if (path == "/client/locations")
+            return GetCachedPayload(path, [this]() { return BuildLocations(); }, request_crc());
+        if (starts_with("/client/locale/"))
+            return GetCachedPayload("/client/locale/", [this]() { return BuildLocale(); }, request_crc());
+
+        // Trading
+        if (path == "/client/trading/api/getTradersList")
+            return Compress(Envelope(BuildTraders()).dump());
+        if (starts_with("/client/trading/api/getTraderAssort/"))
+        {
+            auto trader_id = tail("/client/trading/api/getTraderAssort/");
+            return GetCachedPayload(path, [this, trader_id]() { return BuildTraderAssort(trader_id); });
+        }
+        if (starts_with("/client/trading/api/getUserAssortPrice/trader/"))
+            return Compress(Envelope(json::object()).dump());
+        if (starts_with("/client/trading/api/getTrader/"))
+            return Compress(Envelope(BuildTrader(tail("/client/trading/api/getTrader/"))).dump());
+
+        // Flea market
+        if (path == "/client/ragfair/find")
+            return Compress(Envelope(BuildMarketOffers(request())).dump());
+        if (path == "/client/ragfair/itemMarketPrice")
+            return Compress(Envelope(BuildMarketPrice(request())).dump());
+
+        // Mail
+        if (path == "/client/mail/dialog/list")
+            return Compress(Envelope(BuildMailList()).dump());
+        if (path == "/client/mail/dialog/view" || path == "/client/mail/dialog/getAllAttachments")
+            return Compress(Envelope(BuildMailView(request())).dump());
+
+        return std::string();
+    }
+
+    json MockServer::BuildLauncherDistrib() const
+    {
+        return json{ { "Version", LAUNCHER_VERSION } };
+    }
+
+    json MockServer::BuildPatchList() const
+    {
+        return json::array({ json{ { "Version", GAME_VERSION } } });
+    }
+
+    json MockServer::BuildLogin() const
+    {
+        return json{
+            { "access_token", "mock-access-token" },
+            { "token_type", "Bearer" },
+            { "expires_in", 86400 },
+            { "refresh_token", "mock-refresh-token" }
+        };
+    }
+
+    json MockServer::BuildGameStart() const
+    {
+        return json{ { "session", "mock-session" }, { "aid", 1234567 } };
+    }
+
+    json MockServer::BuildProfiles() const
+    {
+        auto stash_id = MakeId(KIND_PROFILE_ITEM, 0);
+        auto equipment_id = MakeId(KIND_PROFILE_ITEM, 1);
+
+        auto items = json::array();
+        items.push_back(json{ { "_id", stash_id }, { "_tpl", STASH_TEMPLATE_ID } });
+        items.push_back(json{ { "_id", equipment_id }, { "_tpl", EQUIPMENT_TEMPLATE_ID } });
+
+        // Shelf packing from top left corner, stops when main stash grid is full
+        auto x = 0, y = 0, row_height = 0;
+        for (size_t i = 0; i < m_kConfig.stash_items; ++i)
+        {
+            auto template_index = (i < 3) ? 1 : 5 + (i * 13) % (m_kConfig.items - 5); // First stacks are roubles
+            auto width = GetTemplateWidth(template_index);
+            auto height = GetTemplateHeight(template_index);
+
+            if (x + width > STASH_WIDTH)
+            {
+                x = 0;
+                y += row_height;
+                row_height = 0;
+            }
+            if (y + height > STASH_HEIGHT)
+            {
+                break;
+            }
+
+            auto item = json{
+                { "_id", MakeId(KIND_PROFILE_ITEM, 2 + i) },
+                { "_tpl", GetTemplateId(template_index) },
+                { "parentId", stash_id },
+                { "slotId", "hideout" },
+                { "location", { { "x", x }, { "y", y }, { "r", 0 } } }
+            };
+            if (template_index == 1)
+            {
+                item["upd"] = json{ { "StackObjectsCount", 500000 } };
+            }
+            items.push_back(std::move(item));
+
+            x += width;
+            row_height = std::max(row_height, height);
+        }
+
+        auto pmc = json{
+            { "_id", MakeId(KIND_PROFILE, 1) },
+            { "aid", 1234567 },
+            { "savage", MakeId(KIND_PROFILE, 2) },
+            { "Info", { { "Nickname", "MockPlayer" }, { "LowerNickname", "mockplayer" }, { "Side", "Usec" }, { "Level", 42 }, { "GameVersion", "standard" } } },
+            { "Inventory", { { "items", std::move(items) }, { "equipment", equipment_id }, { "stash", stash_id }, { "fastPanel", json::object() } } }
+        };
+        auto scav = json{
+            { "_id", MakeId(KIND_PROFILE, 2) },
+            { "aid", 1234567 },
+            { "Info", { { "Nickname", "MockScav" }, { "LowerNickname", "mockscav" }, { "Side", "Savage" }, { "Level", 1 } } },
+            { "Inventory", { { "items", json::array() }, { "fastPanel", json::object() } } }
+        };
+        return json::array({ std::move(scav), std::move(pmc) });
+    }
+
+    json MockServer::BuildItems() const
+    {
+        auto items = json::object();
+        for (size_t i = 0; i < m_kConfig.items; ++i)
+        {
+            auto id = GetTemplateId(i);
+            auto props = json{
+                { "Name", GetTemplateName(i) },
+                { "ShortName", fmt::format("M{}", i) },
+                { "Description", fmt::format("Generated template #{} for offline tests", i) },
+                { "Width", GetTemplateWidth(i) },
+                { "Height", GetTemplateHeight(i) },
+                { "StackMaxSize", (i >= 1 && i <= 3) ? 500000 : 1 },
+                { "Weight", 0.1 * static_cast<double>(i % 50) },
+                { "CreditsPrice", GetTemplatePrice(i) }
+            };
+            if (i == 0)
+            {
+                props["Grids"] = json::array({ json{
+                    { "_name", "hideout" },
+                    { "_id", MakeId(KIND_TEMPLATE, 0) },
+                    { "_parent", id },
+                    { "_props", { { "filters", json::array() }, { "cellsH", STASH_WIDTH }, { "cellsV", STASH_HEIGHT } } }
+                } });
+            }
+
+            items[id] = json{ { "_id", id }, { "_name", fmt::format("mock_item_{}", i) }, { "_parent", "" }, { "_type", "Item" }, { "_props", std::move(props) } };
+        }
+        return items;
+    }
+
+    json MockServer::BuildItemPrices() const
+    {
+        auto prices = json::object();
+        for (size_t i = 0; i < m_kConfig.items; ++i)
+        {
+            prices[GetTemplateId(i)] = GetTemplatePrice(i);
+        }
+        return prices;
+    }
+
+    json MockServer::BuildLocations() const
+    {
+        auto locations = json::object();
+        for (auto name : { "bigmap", "factory4_day", "Interchange", "Shoreline", "Woods", "RezervBase" })
+        {
+            locations[name] = json{ { "Id", name }, { "Enabled", true }, { "MaxPlayers", 12 } };
+        }
+        return json{ { "locations", std::move(locations) }, { "paths", json::array() } };
+    }
+
+    json MockServer::BuildLocale() const
+    {
+        auto templates = json::object();
+        for (size_t i = 0; i < m_kConfig.items; ++i)
+        {
+            templates[GetTemplateId(i)] = json{
+                { "Name", GetTemplateName(i) },
+                { "ShortName", fmt::format("M{}", i) },
+                { "Description", fmt::format("Generated template #{} for offline tests", i) }
+            };
+        }
+
+        auto trading = json::object();
+        for (size_t i = 0; i < TRADER_COUNT; ++i)
+        {
+            trading[MakeId(KIND_TRADER, i)] = json{
+                { "FullName", TRADER_NICKNAMES[i] },
+                { "FirstName", TRADER_NICKNAMES[i] },
+                { "Nickname", TRADER_NICKNAMES[i] },
+                { "Location", "Mock" },
+                { "Description", "" }
+            };
+        }
+
+        return json{
+            { "interface", { { "Attention", "Attention" } } },
+            { "templates", std::move(templates) },
+            { "trading", std::move(trading) },
+            { "mail", json::object() },
+            { "quest", json::object() },
+            { "preset", json::object() },
+            { "handbook", json::object() },
+            { "locations", json::object() }
+        };
+    }
+
+    json MockServer::BuildTraders() const
+    {
+        auto traders = json::array();
+        for (size_t i = 0; i < TRADER_COUNT; ++i)
+        {
+            traders.push_back(BuildTrader(MakeId(KIND_TRADER, i)));
+        }
+        return traders;
+    }
+
+    json MockServer::BuildTrader(const std::string& trader_id) const
+    {
+        auto index = GetIdIndex(trader_id) % TRADER_COUNT;
+
+        // Staggered resupply timers, each trader restocks once per hour
+        auto now = GetUnixTime();
+        auto supply_next_time = now - now % 3600 + 3600 + static_cast<int64_t>(index) * 60;
+
+        return json{
+            { "_id", trader_id },
+            { "working", true },
+            { "nickname", TRADER_NICKNAMES[index] },
+            { "currency", index == 4 ? "USD" : "RUB" },
+            { "supply_next_time", supply_next_time },
+            { "loyaltyLevels", json::array({
+                json{ { "minLevel", 1 }, { "minSalesSum", 0 }, { "minStanding", 0 } },
+                json{ { "minLevel", 15 }, { "minSalesSum", 1000000 }, { "minStanding", 0.2 } },
+                json{ { "minLevel", 25 }, { "minSalesSum", 3000000 }, { "minStanding", 0.4 } },
+                json{ { "minLevel", 35 }, { "minSalesSum", 6000000 }, { "minStanding", 0.6 } }
+            }) }
+        };
+    }
+
+    json MockServer::BuildTraderAssort(const std::string& trader_id) const
+    {
+        auto trader_index = GetIdIndex(trader_id) % TRADER_COUNT;
+
+        auto items = json::array();
+        auto barter_scheme = json::object();
+        auto loyal_level_items = json::object();
+
+        for (size_t i = 0; i < m_kConfig.assort; ++i)
+        {
+            auto template_index = 5 + (trader_index * 131 + i * 17) % (m_kConfig.items - 5);
+            auto id = MakeId(KIND_ASSORT_ITEM, trader_index * 1000000 + template_index);
+            if (barter_scheme.contains(id))
+            {
+                continue;
+            }
+
+            items.push_back(json{
+                { "_id", id },
+                { "_tpl", GetTemplateId(template_index) },
+                { "parentId", "hideout" },
+                { "slotId", "hideout" },
+                { "upd", { { "StackObjectsCount", 100 + i }, { "UnlimitedCount", i % 5 == 0 }, { "BuyRestrictionMax", 10 }, { "BuyRestrictionCurrent", 0 } } }
+            });
+
+            // Every fourth offer is a barter, rest are sold for money
+            auto costs = json::array();
+            if (i % 4 == 3)
+            {
+                auto barter_index = 5 + (template_index * 7) % (m_kConfig.items - 5);
+                costs.push_back(json{ { "_tpl", GetTemplateId(barter_index) }, { "count", 1 + i % 3 } });
+            }
+            else
+            {
+                costs.push_back(json{ { "_tpl", ROUBLE_ITEM_ID }, { "count", GetTemplatePrice(template_index) } });
+            }
+            barter_scheme[id] = json::array({ std::move(costs) });
+            loyal_level_items[id] = 1 + i % 4;
+        }
+
+        return json{
+            { "items", std::move(items) },
+            { "barter_scheme", std::move(barter_scheme) },
+            { "loyal_level_items", std::move(loyal_level_items) }
+        };
+    }
+
+    json MockServer::BuildMarketOffers(const json& filter) const
+    {
+        auto limit = m_kConfig.offers;
+        auto page = size_t{ 0 };
+        auto wanted = std::string();
+
+        if (filter.is_object())
+        {
+            if (filter.contains("limit") && filter["limit"].is_number_unsigned())
+                limit = std::min(limit, filter["limit"].get<size_t>());
+            if (filter.contains("page") && filter["page"].is_number_unsigned())
+                page = filter["page"].get<size_t>();
+            if (filter.contains("handbookId") && filter["handbookId"].is_string())
+                wanted = filter["handbookId"].get<std::string>();
+        }
+
+        auto now = GetUnixTime();
+        auto offers = json::array();
+        for (size_t i = 0; i < limit; ++i)
+        {
+            auto index = page * limit + i;
+            auto template_index = 5 + (index * 29) % (m_kConfig.items - 5);
+            auto tpl = wanted.empty() ? GetTemplateId(template_index) : wanted;
+            auto item_id = MakeId(KIND_OFFER, 1000000 + index);
+            auto price = GetTemplatePrice(template_index) + static_cast<int64_t>(i) * 100;
+
+            offers.push_back(json{
+                { "_id", MakeId(KIND_OFFER, index) },
+                { "intId", index },
+                { "user", { { "id", MakeId(KIND_PROFILE, 100 + index % 50) }, { "memberType", 0 }, { "nickname", fmt::format("Seller{}", index % 50) }, { "rating", 1.0 } } },
+                { "root", item_id },
+                { "items", json::array({ json{ { "_id", item_id }, { "_tpl", tpl }, { "upd", { { "StackObjectsCount", 1 } } } } }) },
+                { "requirements", json::array({ json{ { "_tpl", ROUBLE_ITEM_ID }, { "count", price } } }) },
+                { "itemsCost", price },
+                { "requirementsCost", price },
+                { "summaryCost", price },
+                { "sellInOnePiece", false },
+                { "startTime", now - 600 },
+                { "endTime", now + 43200 },
+                { "loyaltyLevel", 1 }
+            });
+        }
+
+        return json{ { "offers", std::move(offers) }, { "offersCount", m_kConfig.offers * 10 }, { "selectedCategory", wanted } };
+    }
+
+    json MockServer::BuildMarketPrice(const json& request) const
+    {
+        auto tpl = (request.is_object() && request.contains("templateId") && request["templateId"].is_string()) ? request["templateId"].get<std::string>() : std::string();
+        auto price = static_cast<double>(GetTemplatePrice(GetIdIndex(tpl)));
+
+        return json{ { "templateId", tpl }, { "min", price * 0.8 }, { "max", price * 1.5 }, { "avg", price } };
+    }
+
+    // Acknowledges every known action with plausible inventory changes, unknown or malformed actions are reported in badRequest
+    json MockServer::BuildItemsMoving(const json& request) const
+    {
+        auto created = json::array();
+        auto changed = json::array();
+        auto deleted = json::array();
+        auto bad_request = json::array();
+
+        auto actions = (request.is_object() && request.contains("data") && request["data"].is_array()) ? request["data"] : json::array();
+        for (size_t i = 0; i < actions.size(); ++i)
+        {
+            const auto& action = actions[i];
+            auto name = (action.is_object() && action.contains("Action") && action["Action"].is_string()) ? action["Action"].get<std::string>() : std::string();
+            auto item = (action.is_object() && action.contains("item") && action["item"].is_string()) ? action["item"].get<std::string>() : std::string();
+
+            if (name == "Move" && !item.empty() && action.contains("to"))
+            {
+                auto change = json{ { "_id", item }, { "parentId", action["to"].value("id", "") }, { "slotId", action["to"].value("container", "") } };
+                if (action["to"].contains("location"))
+                {
+                    change["location"] = action["to"]["location"];
+                }
+                changed.push_back(std::move(change));
+            }
+            else if ((name == "Merge" || name == "Transfer") && !item.empty() && action.contains("with"))
+            {
+                if (name == "Merge")
+                    deleted.push_back(json{ { "_id", item } });
+                else
+                    changed.push_back(json{ { "_id", item } });
+                changed.push_back(json{ { "_id", action["with"] } });
+            }
+            else if (name == "TradingConfirm" && action.value("type", "") == "buy_from_trader" && action.contains("item_id"))
+            {
+                auto template_index = GetIdIndex(action["item_id"].get<std::string>()) % 1000000;
+                created.push_back(json{
+                    { "_id", MakeId(KIND_CREATED_ITEM, m_nCreatedItems++) },
+                    { "_tpl", GetTemplateId(template_index % m_kConfig.items) },
+                    { "upd", { { "StackObjectsCount", action.value("count", 1) } } }
+                });
+            }
+            else if (name == "TradingConfirm" && action.value("type", "") == "sell_to_trader" && action.contains("items"))
+            {
+                for (const auto& sold : action["items"])
+                {
+                    deleted.push_back(json{ { "_id", sold.value("id", "") } });
+                }
+            }
+            else if (name == "RagFairBuyOffer" && action.contains("offers"))
+            {
+                for (const auto& offer : action["offers"])
+                {
+                    created.push_back(json{ { "_id", MakeId(KIND_CREATED_ITEM, m_nCreatedItems++) }, { "_tpl", GetTemplateId(GetIdIndex(offer.value("id", "")) % m_kConfig.items) } });
+                }
+            }
+            else if (name == "RagFairAddOffer" && action.contains("items"))
+            {
+                for (const auto& listed : action["items"])
+                {
+                    deleted.push_back(json{ { "_id", listed } });
+                }
+            }
+            else
+            {
+                bad_request.push_back(json{ { "index", i }, { "err", ErrorCodes::InvalidParameters }, { "errmsg", fmt::format("Unsupported action: {}", name) } });
+            }
+        }
+
+        return json{
+            { "items", { { "new", std::move(created) }, { "change", std::move(changed) }, { "del", std::move(deleted) } } },
+            { "badRequest", std::move(bad_request) }
+        };
+    }
+
+    json MockServer::BuildMailList() const
+    {
+        auto now = GetUnixTime();
+        auto dialogs = json::array();
+        for (size_t i = 0; i < m_kConfig.mails; ++i)
+        {
+            auto dialog_id = MakeId(KIND_DIALOG, i);
+            dialogs.push_back(json{
+                { "_id", dialog_id },
+                { "type", 2 },
+                { "message", { { "_id", MakeId(KIND_DIALOG, 1000000 + i) }, { "uid", dialog_id }, { "type", 8 }, { "dt", now - 60 * static_cast<int64_t>(i) }, { "hasRewards", true } } },
+                { "new", 1 },
+                { "attachmentsNew", 1 },
+                { "pinned", false }
+            });
+        }
+        return dialogs;
+    }
+
+    json MockServer::BuildMailView(const json& request) const
+    {
+        auto dialog_id = (request.is_object() && request.contains("dialogId") && request["dialogId"].is_string()) ? request["dialogId"].get<std::string>() : MakeId(KIND_DIALOG, 0);
+        auto dialog_index = GetIdIndex(dialog_id);
+        auto stash_id = MakeId(KIND_MAIL_ITEM, dialog_index * 1000);
+
+        auto now = GetUnixTime();
+        auto message = json{
+            { "_id", MakeId(KIND_DIALOG, 1000000 + dialog_index) },
+            { "uid", dialog_id },
+            { "type", 8 },
+            { "dt", now - 60 },
+            { "templateId", "5bdabfb886f7743e152e867e 0" },
+            { "hasRewards", true },
+            { "rewardCollected", false },
+            { "maxStorageTime", 172800 },
+            { "items", {
+                { "stash", stash_id },
+                { "data", json::array({
+                    json{ { "_id", MakeId(KIND_MAIL_ITEM, dialog_index * 1000 + 1) }, { "_tpl", ROUBLE_ITEM_ID }, { "parentId", stash_id }, { "slotId", "main" }, { "upd", { { "StackObjectsCount", 10000 } } } }
+                }) }
+            } }
+        };
+
+        return json{ { "messages", json::array({ std::move(message) }) }, { "profiles", json::array() }, { "hasMessagesWithRewards", true } };
+    }
+};
@@ -0,0 +1,122 @@
+#pragma once
+#include <cstdint>
+#include <string>
+#include <map>
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <atomic>
+#include <functional>
+
+#include <json.hpp>
+
+#ifdef _WIN32
+#include <winsock2.h>
+#include <ws2tcpip.h>
+#else
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <arpa/inet.h>
+#include <unistd.h>
+#endif
+
+namespace TarkovAPI
+{
+	using json = nlohmann::json;
+
+#ifdef _WIN32
+	using socket_t = SOCKET;
+#else
+	using socket_t = int;
+#endif
+
+	struct MockServerConfig
+	{
+		uint16_t port{ 8080 }; // 0 picks a free port
+		uint32_t latency_ms{ 0 }; // Added before every response
+		uint32_t jitter_ms{ 0 }; // Random extra latency in [0, jitter_ms]
+
+		// Payload size knobs
+		size_t items{ 2000 }; // Item templates in items/locale/prices
+		size_t assort{ 200 }; // Items per trader assort
+		size_t stash_items{ 100 };
+		size_t offers{ 50 }; // Maximum flea market offers per page
+		size_t mails{ 10 };
+	};
+
+	// Minimal HTTP/1.1 stand-in for EFT backend, serves zlib compressed {err, errmsg, data} bodies like live servers
+	// Every route is served from one host, clients should be redirected with OverrideEndpoints("http://127.0.0.1:<port>")
+	class MockServer
+	{
+	public:
+		explicit MockServer(const MockServerConfig& config);
+		virtual ~MockServer();
+
+		MockServer(const MockServer&) = delete;
+		MockServer& operator=(const MockServer&) = delete;
+
+		bool Listen();
+		void Run(); // Blocks until Stop
+		void Stop();
+
+		uint16_t GetPort() const; // Actual port, when configured port is 0
+		uint64_t GetRequestCount() const;
+
+		static std::string MakeId(uint32_t kind, uint64_t index);
+		static std::string Compress(const std::string& data);
+
+	protected:
+		void HandleConnection(socket_t client);
+		void ApplyLatency() const;
+
+		std::string Route(const std::string& path, const std::string& body);
+		// Answers with null data when client already has payload with same crc, like live servers
+		std::string GetCachedPayload(const std::string& key, const std::function<json()>& builder, int64_t client_crc = 0);
+
+		static json Envelope(json&& data, int64_t err = 0, const std::string& errmsg = "");
+		static json CachedEnvelope(json&& data, int64_t crc); // static data carries crc of its dump
+
+		json BuildLauncherDistrib() const;
+		json BuildPatchList() const;
+		json BuildLogin() const;
+		json BuildGameStart() const;
+		json BuildProfiles() const;
+		json BuildItems() const;
+		json BuildItemPrices() const;
+		json BuildLocations() const;
+		json BuildLocale() const;
+		json BuildTraders() const;
+		json BuildTrader(const std::string& trader_id) const;
+		json BuildTraderAssort(const std::string& trader_id) const;
+		json BuildMarketOffers(const json& filter) const;
+		json BuildMarketPrice(const json& request) const;
+		json BuildItemsMoving(const json& request) const;
+		json BuildMailList() const;
+		json BuildMailView(const json& request) const;
+
+	private:
+		struct CachedPayload
+		{
+			std::string payload;
+			std::string not_modified; // payload without data
+			int64_t crc;
+		};
+
+		MockServerConfig m_kConfig;
+
+		socket_t m_nListenSocket;
+		std::atomic <bool> m_bRunning{ false };
+		std::atomic <uint64_t> m_nRequests{ 0 };
+		mutable std::atomic <uint64_t> m_nCreatedItems{ 0 };
+
+		// Connection threads by client socket, threads which returned wait in m_vFinished until joined
+		std::mutex m_pkConnectionMutex;
+		std::map <socket_t, std::thread> m_pkConnections;
+		std::vector <std::thread> m_vFinished;
+
+		// Large static payloads are generated and compressed once, so load tests measure client instead of server
+		std::mutex m_pkCacheMutex;
+		std::map <std::string, CachedPayload> m_pkPayloadCache;
+	};
+};
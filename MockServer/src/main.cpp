@@ -0,0 +1,78 @@
+#include "MockServer.hpp"
+
+#include <iostream>
+#include <cstring>
+#include <cstdlib>
+
+using namespace TarkovAPI;
+
+static void PrintUsage(const char* name)
+{
+    std::cout
+        << "Usage: " << name << " [options]\n"
+        << "  --port <n>          Listen port on 127.0.0.1 (default 8080)\n"
+        << "  --latency <ms>      Fixed delay before every response\n"
+        << "  --jitter <ms>       Random extra delay in [0, ms]\n"
+        << "  --items <n>         Item templates in items/locale/prices payloads\n"
+        << "  --assort <n>        Items per trader assort\n"
+        << "  --stash-items <n>   Items in profile stash\n"
+        << "  --offers <n>        Flea market offers per page\n"
+        << "  --mails <n>         Mail dialogs\n"
+        << "\nPoint the client at it with: TARKOVAPI_ENDPOINT=http://127.0.0.1:<port>" << std::endl;
+}
+
+int main(int argc, char* argv[])
+{
+    auto config = MockServerConfig{};
+
+    for (auto i = 1; i < argc; ++i)
+    {
+        auto has_value = i + 1 < argc;
+        auto value = has_value ? std::strtoull(argv[i + 1], nullptr, 10) : 0;
+
+        if (!std::strcmp(argv[i], "--help") || !std::strcmp(argv[i], "-h"))
+        {
+            PrintUsage(argv[0]);
+            return EXIT_SUCCESS;
+        }
+        else if (!has_value)
+        {
+            PrintUsage(argv[0]);
+            return EXIT_FAILURE;
+        }
+        else if (!std::strcmp(argv[i], "--port"))
+            config.port = static_cast<uint16_t>(value);
+        else if (!std::strcmp(argv[i], "--latency"))
+            config.latency_ms = static_cast<uint32_t>(value);
+        else if (!std::strcmp(argv[i], "--jitter"))
+            config.jitter_ms = static_cast<uint32_t>(value);
+        else if (!std::strcmp(argv[i], "--items"))
+            config.items = static_cast<size_t>(value);
+        else if (!std::strcmp(argv[i], "--assort"))
+            config.assort = static_cast<size_t>(value);
+        else if (!std::strcmp(argv[i], "--stash-items"))
+            config.stash_items = static_cast<size_t>(value);
+        else if (!std::strcmp(argv[i], "--offers"))
+            config.offers = static_cast<size_t>(value);
+        else if (!std::strcmp(argv[i], "--mails"))
+            config.mails = static_cast<size_t>(value);
+        else
+        {
+            PrintUsage(argv[0]);
+            return EXIT_FAILURE;
+        }
+        ++i;
+    }
+
+    auto server = MockServer(config);
+    if (!server.Listen())
+    {
+        std::cout << "Mock server could not listen on port " << config.port << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    std::cout << "Mock EFT backend listening on http://127.0.0.1:" << config.port << std::endl;
+    server.Run();
+
+    return EXIT_SUCCESS;
+}
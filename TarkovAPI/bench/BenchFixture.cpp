@@ -0,0 +1,138 @@
+#include "BenchFixture.hpp"
+#include "../src/Constants.hpp"
+
+#include <iostream>
+
+namespace TarkovAPI
+{
+    namespace bench
+    {
+        BenchFixture& BenchFixture::Instance()
+        {
+            static BenchFixture instance;
+            return instance;
+        }
+
+        BenchFixture::BenchFixture()
+        {
+            // Sizes are close to live payloads
+            m_kConfig.port = 0;
+            m_kConfig.items = 4000;
+            m_kConfig.assort = 300;
+            m_kConfig.stash_items = 200;
+            m_kConfig.offers = 100;
+
+            m_pkServer = std::make_unique<PayloadSource>(m_kConfig);
+        }
+        BenchFixture::~BenchFixture()
+        {
+            Shutdown();
+        }
+
+        void BenchFixture::StartServer()
+        {
+            if (m_kServerThread.joinable())
+            {
+                return;
+            }
+
+            if (!m_pkServer->Listen())
+            {
+                throw std::runtime_error("Mock server could not listen");
+            }
+            m_kServerThread = std::thread(&MockServer::Run, m_pkServer.get());
+
+            OverrideEndpoints(fmt::format("http://127.0.0.1:{}", m_pkServer->GetPort()));
+        }
+
+        void BenchFixture::Shutdown()
+        {
+            if (m_pkManager)
+            {
+                m_pkManager->FinalizeTarkovAPIManager();
+                m_pkManager.reset();
+            }
+            if (m_kServerThread.joinable())
+            {
+                m_pkServer->Stop();
+                m_kServerThread.join();
+            }
+        }
+
+        TarkovAPIManager* BenchFixture::GetManager()
+        {
+            std::lock_guard <std::mutex> lock(m_pkMutex);
+
+            if (!m_pkManager)
+            {
+                StartServer();
+
+                m_pkManager = std::make_unique<TarkovAPIManager>();
+                // Every run downloads, disk caches of an earlier run would hide transfer and parse cost
+                m_pkManager->SetVersionCacheTTL(std::chrono::seconds(0));
+                m_pkManager->SetDataCacheDirectory("");
+                if (!m_pkManager->InitializeTarkovAPIManager())
+                {
+                    throw std::runtime_error("API manager could not initialized");
+                }
+                // Measure client cost, not request budget
+                auto budget = RateBudget{};
+                budget.requests_per_second = 0.0;
+                m_pkManager->SetDefaultRateBudget(budget);
+
+                m_pkManager->Login_Session("bench-session", "bench-hwid");
+            }
+            return m_pkManager.get();
+        }
+
+        PayloadSource& BenchFixture::GetPayloadSource()
+        {
+            return *m_pkServer;
+        }
+
+        const MockServerConfig& BenchFixture::GetConfig() const
+        {
+            return m_kConfig;
+        }
+
+        std::string BenchFixture::GetTraderId(size_t index) const
+        {
+            return MockServer::MakeId(2, index);
+        }
+
+        std::string BenchFixture::GetTemplateId(size_t index) const
+        {
+            return MockServer::MakeId(1, index); // First few templates are real ids, generated ones start from 5
+        }
+
+        const std::string& BenchFixture::GetCompressedBody(const std::string& name)
+        {
+            std::lock_guard <std::mutex> lock(m_pkMutex);
+
+            auto it = m_pkBodies.find(name);
+            if (it != m_pkBodies.end())
+            {
+                return it->second;
+            }
+
+            auto data = json();
+            if (name == "items")
+                data = m_pkServer->BuildItems();
+            else if (name == "locale")
+                data = m_pkServer->BuildLocale();
+            else if (name == "profiles")
+                data = m_pkServer->BuildProfiles();
+            else if (name == "traders")
+                data = m_pkServer->BuildTraders();
+            else if (name == "assort")
+                data = m_pkServer->BuildTraderAssort(GetTraderId(0));
+            else if (name == "offers")
+                data = m_pkServer->BuildMarketOffers(json::object());
+            else
+                throw std::invalid_argument(name);
+
+            auto body = MockServer::Compress(PayloadSource::Envelope(std::move(data)).dump());
+            return m_pkBodies.emplace(name, std::move(body)).first->second;
+        }
+    };
+};
@@ -0,0 +1,70 @@
+#pragma once
+#include <cstdint>
+#include <string>
+#include <memory>
+#include <thread>
+#include <mutex>
+#include <map>
+
+#include "../../MockServer/src/MockServer.hpp" // winsock2 must come before any windows.h
+#include "../src/TarkovAPIManager.hpp"
+
+#include <json.hpp>
+
+namespace TarkovAPI
+{
+    namespace bench
+    {
+        // Exposes mock backend payload builders, so benchmarks decode the same bodies client receives from the mock server
+        class PayloadSource : public MockServer
+        {
+        public:
+            using MockServer::MockServer;
+
+            using MockServer::Envelope;
+            using MockServer::BuildProfiles;
+            using MockServer::BuildItems;
+            using MockServer::BuildLocale;
+            using MockServer::BuildTraders;
+            using MockServer::BuildTraderAssort;
+            using MockServer::BuildMarketOffers;
+        };
+
+        // Shared state for all benchmarks: in-process mock backend and an initialized API manager pointed at it
+        class BenchFixture
+        {
+        public:
+            static BenchFixture& Instance();
+
+            BenchFixture(const BenchFixture&) = delete;
+            BenchFixture& operator=(const BenchFixture&) = delete;
+
+            void Shutdown();
+
+            TarkovAPIManager* GetManager();
+            PayloadSource& GetPayloadSource();
+            const MockServerConfig& GetConfig() const;
+
+            std::string GetTraderId(size_t index) const;
+            std::string GetTemplateId(size_t index) const;
+
+            // Complete zlib compressed {err, errmsg, data} body, as it comes from wire
+            const std::string& GetCompressedBody(const std::string& name);
+
+        protected:
+            BenchFixture();
+            ~BenchFixture();
+
+            void StartServer();
+
+        private:
+            MockServerConfig m_kConfig;
+            std::unique_ptr <PayloadSource> m_pkServer;
+            std::thread m_kServerThread;
+            std::unique_ptr <TarkovAPIManager> m_pkManager;
+
+            std::mutex m_pkMutex;
+            std::map <std::string, std::string> m_pkBodies;
+        };
+    };
+};
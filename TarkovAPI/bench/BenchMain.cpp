@@ -0,0 +1,145 @@
+#include "Benchmark.hpp"
+#include "BenchFixture.hpp"
+
+#include <cstdlib>
+#include <cstring>
+#include <new>
+#include <iostream>
+
+#include <fmt/format.h>
+
+namespace TarkovAPI
+{
+    namespace bench
+    {
+        std::atomic <uint64_t> g_nAllocCount{ 0 };
+        std::atomic <uint64_t> g_nAllocBytes{ 0 };
+    };
+};
+
+// Counting allocator, every C++ allocation in the process goes through here
+static void* CountedAlloc(size_t size)
+{
+    TarkovAPI::bench::g_nAllocCount.fetch_add(1, std::memory_order_relaxed);
+    TarkovAPI::bench::g_nAllocBytes.fetch_add(size, std::memory_order_relaxed);
+
+    return std::malloc(size ? size : 1);
+}
+
+void* operator new(size_t size)
+{
+    if (auto ptr = CountedAlloc(size))
+    {
+        return ptr;
+    }
+    throw std::bad_alloc();
+}
+void* operator new[](size_t size)
+{
+    return operator new(size);
+}
+void* operator new(size_t size, const std::nothrow_t&) noexcept
+{
+    return CountedAlloc(size);
+}
+void* operator new[](size_t size, const std::nothrow_t&) noexcept
+{
+    return CountedAlloc(size);
+}
+void operator delete(void* ptr) noexcept
+{
+    std::free(ptr);
+}
+void operator delete[](void* ptr) noexcept
+{
+    std::free(ptr);
+}
+void operator delete(void* ptr, size_t) noexcept
+{
+    std::free(ptr);
+}
+void operator delete[](void* ptr, size_t) noexcept
+{
+    std::free(ptr);
+}
+
+using namespace TarkovAPI::bench;
+
+static void PrintUsage(const char* name)
+{
+    std::cout
+        << "Usage: " << name << " [options]\n"
+        << "  --filter <text>     Run benchmarks which name contains text\n"
+        << "  --min-time <ms>     Minimum measured time per benchmark (default 500)\n"
+        << "  --list              List benchmarks" << std::endl;
+}
+
+int main(int argc, char* argv[])
+{
+    auto filter = std::string();
+    auto min_time = std::chrono::milliseconds(500);
+
+    for (auto i = 1; i < argc; ++i)
+    {
+        if (!std::strcmp(argv[i], "--filter") && i + 1 < argc)
+        {
+            filter = argv[++i];
+        }
+        else if (!std::strcmp(argv[i], "--min-time") && i + 1 < argc)
+        {
+            min_time = std::chrono::milliseconds(std::strtoull(argv[++i], nullptr, 10));
+        }
+        else if (!std::strcmp(argv[i], "--list"))
+        {
+            for (const auto& registration : GetRegistry())
+            {
+                std::cout << registration.name << std::endl;
+            }
+            return EXIT_SUCCESS;
+        }
+        else
+        {
+            PrintUsage(argv[0]);
+            return EXIT_FAILURE;
+        }
+    }
+
+    auto results = std::vector <BenchmarkResult>();
+    for (const auto& registration : GetRegistry())
+    {
+        if (!filter.empty() && registration.name.find(filter) == std::string::npos)
+        {
+            continue;
+        }
+
+        auto bench = Benchmark(registration.name, min_time);
+        try
+        {
+            registration.func(bench);
+        }
+        catch (const TarkovAPIException& ex)
+        {
+            std::cout << "Benchmark '" << registration.name << "' failed: " << ex.details() << std::endl;
+            continue;
+        }
+        catch (const std::exception& ex)
+        {
+            std::cout << "Benchmark '" << registration.name << "' failed: " << ex.what() << std::endl;
+            continue;
+        }
+
+        results.insert(results.end(), bench.GetResults().begin(), bench.GetResults().end());
+    }
+
+    BenchFixture::Instance().Shutdown();
+
+    std::cout << fmt::format("\n{:<56} {:>12} {:>16} {:>16} {:>12}\n", "Benchmark", "Iterations", "ns/op", "bytes/op", "allocs/op");
+    std::cout << std::string(116, '-') << '\n';
+    for (const auto& result : results)
+    {
+        std::cout << fmt::format("{:<56} {:>12} {:>16.1f} {:>16.1f} {:>12.1f}\n", result.name, result.iterations, result.ns_per_op, result.bytes_per_op, result.allocs_per_op);
+    }
+    std::cout << std::flush;
+
+    return EXIT_SUCCESS;
+}
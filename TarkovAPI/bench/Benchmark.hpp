@@ -0,0 +1,124 @@
+#pragma once
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <algorithm>
+
+namespace TarkovAPI
+{
+    namespace bench
+    {
+        // Updated by global operator new replacement in BenchMain.cpp
+        extern std::atomic <uint64_t> g_nAllocCount;
+        extern std::atomic <uint64_t> g_nAllocBytes;
+
+        struct BenchmarkResult
+        {
+            std::string name;
+            uint64_t iterations;
+            double ns_per_op;
+            double bytes_per_op;
+            double allocs_per_op;
+        };
+
+        // Keeps result of benchmarked expression alive, so optimizer can't drop the work
+        template <typename T>
+        inline void DoNotOptimize(const T& value)
+        {
+            static volatile const void* sink;
+            sink = &value;
+        }
+
+        class Benchmark
+        {
+        public:
+            Benchmark(const std::string& name, std::chrono::milliseconds min_time) :
+                m_stName(name), m_kMinTime(min_time)
+            {
+            }
+
+            // Runs `fn` until min time is reached, setup outside of `fn` is not measured
+            template <typename F>
+            void Run(F&& fn)
+            {
+                fn(); // warm up caches and lazy initializations
+
+                uint64_t iterations = 1;
+                while (true)
+                {
+                    auto allocs_before = g_nAllocCount.load(std::memory_order_relaxed);
+                    auto bytes_before = g_nAllocBytes.load(std::memory_order_relaxed);
+                    auto begin = std::chrono::steady_clock::now();
+
+                    for (uint64_t i = 0; i < iterations; ++i)
+                    {
+                        fn();
+                    }
+
+                    auto elapsed = std::chrono::steady_clock::now() - begin;
+                    if (elapsed >= m_kMinTime || iterations >= (1ull << 30))
+                    {
+                        auto ops = static_cast<double>(iterations);
+                        m_vResults.emplace_back(BenchmarkResult{
+                            m_stName,
+                            iterations,
+                            std::chrono::duration<double, std::nano>(elapsed).count() / ops,
+                            static_cast<double>(g_nAllocBytes.load(std::memory_order_relaxed) - bytes_before) / ops,
+                            static_cast<double>(g_nAllocCount.load(std::memory_order_relaxed) - allocs_before) / ops
+                        });
+                        return;
+                    }
+
+                    // Aim slightly above min time with next round
+                    auto elapsed_ns = std::max<int64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count(), 1);
+                    auto target = static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(m_kMinTime).count()) * 1.2;
+                    iterations = std::max<uint64_t>(iterations * 2, static_cast<uint64_t>(static_cast<double>(iterations) * target / static_cast<double>(elapsed_ns)));
+                }
+            }
+
+            const std::vector <BenchmarkResult>& GetResults() const
+            {
+                return m_vResults;
+            }
+
+        private:
+            std::string m_stName;
+            std::chrono::milliseconds m_kMinTime;
+            std::vector <BenchmarkResult> m_vResults;
+        };
+
+        using BenchmarkFunc = std::function<void(Benchmark&)>;
+
+        struct BenchmarkRegistration
+        {
+            std::string name;
+            BenchmarkFunc func;
+        };
+
+        inline std::vector <BenchmarkRegistration>& GetRegistry()
+        {
+            static std::vector <BenchmarkRegistration> registry;
+            return registry;
+        }
+
+        struct BenchmarkRegistrar
+        {
+            BenchmarkRegistrar(const std::string& name, BenchmarkFunc func)
+            {
+                GetRegistry().emplace_back(BenchmarkRegistration{ name, std::move(func) });
+            }
+        };
+    };
+};
+
+#define TARKOV_BENCH_CONCAT_IMPL(a, b) a##b
+#define TARKOV_BENCH_CONCAT(a, b) TARKOV_BENCH_CONCAT_IMPL(a, b)
+
+// Defines and registers benchmark body, body receives `bench` and calls bench.Run(...) after its setup
+#define TARKOV_BENCHMARK(name) \
+    static void TARKOV_BENCH_CONCAT(TarkovBenchmark_, __LINE__)(TarkovAPI::bench::Benchmark& bench); \
+    static TarkovAPI::bench::BenchmarkRegistrar TARKOV_BENCH_CONCAT(TarkovBenchmarkRegistrar_, __LINE__)(name, &TARKOV_BENCH_CONCAT(TarkovBenchmark_, __LINE__)); \
+    static void TARKOV_BENCH_CONCAT(TarkovBenchmark_, __LINE__)(TarkovAPI::bench::Benchmark& bench)
@@ -0,0 +1,77 @@
+#include "Benchmark.hpp"
+#include "BenchFixture.hpp"
+#include "../src/Inventory.hpp"
+#include "../src/Inflater.hpp"
+#include "../src/Constants.hpp"
+
+#include <json.hpp>
+
+using namespace TarkovAPI;
+using namespace TarkovAPI::bench;
+using json = nlohmann::json;
+
+namespace
+{
+    json GetProfileInventory()
+    {
+        const auto& body = BenchFixture::Instance().GetCompressedBody("profiles");
+        auto profiles = parse_response(json::parse(InflateBuffer(body.data(), body.size()))).data;
+
+        for (const auto& profile : profiles)
+        {
+            if (profile["Info"]["Side"] != "Savage")
+            {
+                return profile["Inventory"];
+            }
+        }
+        return json::object();
+    }
+}
+
+TARKOV_BENCHMARK("Inventory: build from profile")
+{
+    auto profile_inventory = GetProfileInventory();
+
+    bench.Run([&]() {
+        auto inventory = Inventory(profile_inventory);
+        DoNotOptimize(inventory);
+    });
+}
+
+// Previous GetRoubleCount, a scan over Inventory.items DOM
+TARKOV_BENCHMARK("Rouble count: json scan")
+{
+    auto items = GetProfileInventory()["items"];
+
+    bench.Run([&]() {
+        uint64_t count = 0;
+        for (const auto& root : items)
+        {
+            if (root.is_object() && root.contains("_tpl") && root["_tpl"] == ROUBLE_ITEM_ID && root.contains("upd") && root["upd"].contains("StackObjectsCount"))
+            {
+                count += root["upd"]["StackObjectsCount"].get<uint64_t>();
+            }
+        }
+        DoNotOptimize(count);
+    });
+}
+
+TARKOV_BENCHMARK("Rouble count: inventory index")
+{
+    auto inventory = Inventory(GetProfileInventory());
+
+    bench.Run([&]() {
+        auto count = inventory.GetStackTotal(ROUBLE_OBJECT_ID);
+        DoNotOptimize(count);
+    });
+}
+
+TARKOV_BENCHMARK("Stash children: inventory index")
+{
+    auto inventory = Inventory(GetProfileInventory());
+
+    bench.Run([&]() {
+        auto children = inventory.GetChildren(inventory.GetStashId(), "hideout");
+        DoNotOptimize(children);
+    });
+}
@@ -0,0 +1,57 @@
+#include "Benchmark.hpp"
+#include "BenchFixture.hpp"
+
+using namespace TarkovAPI;
+using namespace TarkovAPI::bench;
+
+// Locale is fetched once and cached by manager, measured part is lookup only
+TARKOV_BENCHMARK("GetItemName: first template")
+{
+    auto& fixture = BenchFixture::Instance();
+    auto manager = fixture.GetManager();
+    manager->GetI18n("en");
+
+    auto schema_id = fixture.GetTemplateId(5);
+
+    bench.Run([&]() {
+        auto name = manager->GetItemName(schema_id);
+        DoNotOptimize(name);
+    });
+}
+
+TARKOV_BENCHMARK("GetItemName: last template")
+{
+    auto& fixture = BenchFixture::Instance();
+    auto manager = fixture.GetManager();
+    manager->GetI18n("en");
+
+    auto schema_id = fixture.GetTemplateId(fixture.GetConfig().items - 1);
+
+    bench.Run([&]() {
+        auto name = manager->GetItemName(schema_id);
+        DoNotOptimize(name);
+    });
+}
+
+TARKOV_BENCHMARK("GetTraderIdByName")
+{
+    auto manager = BenchFixture::Instance().GetManager();
+    manager->GetI18n("en");
+
+    bench.Run([&]() {
+        auto trader_id = manager->GetTraderIdByName("Jaeger");
+        DoNotOptimize(trader_id);
+    });
+}
+
+// Cached getters hand out shared snapshots, this used to be a deep copy of the whole DOM
+TARKOV_BENCHMARK("GetI18n: cached snapshot")
+{
+    auto manager = BenchFixture::Instance().GetManager();
+    manager->GetI18n("en");
+
+    bench.Run([&]() {
+        auto locale = manager->GetI18n("en");
+        DoNotOptimize(locale);
+    });
+}
@@ -0,0 +1,71 @@
+#include "Benchmark.hpp"
+#include "BenchFixture.hpp"
+
+#include <unordered_map>
+
+#include "../src/ObjectId.hpp"
+
+using namespace TarkovAPI;
+using namespace TarkovAPI::bench;
+
+TARKOV_BENCHMARK("ObjectId: parse")
+{
+    auto text = BenchFixture::Instance().GetTemplateId(5);
+
+    bench.Run([&]() {
+        ObjectId id{};
+        auto ret = ObjectId::TryParse(text, id);
+        DoNotOptimize(ret);
+        DoNotOptimize(id);
+    });
+}
+
+TARKOV_BENCHMARK("ObjectId: format")
+{
+    auto id = ObjectId(BenchFixture::Instance().GetTemplateId(5));
+
+    char text[ObjectId::HEX_LENGTH];
+    bench.Run([&]() {
+        id.Format(text);
+        DoNotOptimize(text);
+    });
+}
+
+// Same table of every template, keyed by text and by binary id
+TARKOV_BENCHMARK("Template lookup: std::string key")
+{
+    auto& fixture = BenchFixture::Instance();
+
+    auto keys = std::vector <std::string>();
+    auto table = std::unordered_map <std::string, size_t>();
+    for (size_t i = 0; i < fixture.GetConfig().items; ++i)
+    {
+        keys.emplace_back(fixture.GetTemplateId(i));
+        table.emplace(keys.back(), i);
+    }
+
+    size_t next = 0;
+    bench.Run([&]() {
+        auto it = table.find(keys[next++ % keys.size()]);
+        DoNotOptimize(it->second);
+    });
+}
+
+TARKOV_BENCHMARK("Template lookup: ObjectId key")
+{
+    auto& fixture = BenchFixture::Instance();
+
+    auto keys = std::vector <ObjectId>();
+    auto table = std::unordered_map <ObjectId, size_t>();
+    for (size_t i = 0; i < fixture.GetConfig().items; ++i)
+    {
+        keys.emplace_back(fixture.GetTemplateId(i));
+        table.emplace(keys.back(), i);
+    }
+
+    size_t next = 0;
+    bench.Run([&]() {
+        auto it = table.find(keys[next++ % keys.size()]);
+        DoNotOptimize(it->second);
+    });
+}
@@ -0,0 +1,71 @@
+#include "Benchmark.hpp"
+#include "BenchFixture.hpp"
+#include "../src/Inflater.hpp"
+#include "../src/Constants.hpp"
+
+#include <json.hpp>
+
+using namespace TarkovAPI;
+using namespace TarkovAPI::bench;
+using json = nlohmann::json;
+
+// Same steps as Post_Json without transport: inflate, json::parse, parse_response
+static void RunDecodePipeline(Benchmark& bench, const std::string& payload)
+{
+    const auto& body = BenchFixture::Instance().GetCompressedBody(payload);
+
+    bench.Run([&body]() {
+        auto decompressed = InflateBuffer(body.data(), body.size());
+        auto deserialized = json::parse(decompressed);
+        auto res = parse_response(deserialized);
+        DoNotOptimize(res);
+    });
+}
+
+TARKOV_BENCHMARK("Pipeline decode: items")
+{
+    RunDecodePipeline(bench, "items");
+}
+
+TARKOV_BENCHMARK("Pipeline decode: locale")
+{
+    RunDecodePipeline(bench, "locale");
+}
+
+TARKOV_BENCHMARK("Pipeline decode: trader assort")
+{
+    RunDecodePipeline(bench, "assort");
+}
+
+TARKOV_BENCHMARK("Pipeline decode: profiles")
+{
+    RunDecodePipeline(bench, "profiles");
+}
+
+TARKOV_BENCHMARK("Pipeline decode: ragfair offers")
+{
+    RunDecodePipeline(bench, "offers");
+}
+
+// Whole Post_Json round trip against in-process mock backend on loopback
+TARKOV_BENCHMARK("Post_Json loopback: items")
+{
+    auto manager = BenchFixture::Instance().GetManager();
+    auto url = fmt::format("{}/client/items", PROD_ENDPOINT);
+
+    bench.Run([manager, &url]() {
+        auto res = manager->Post_Json(url);
+        DoNotOptimize(res);
+    });
+}
+
+TARKOV_BENCHMARK("Post_Json loopback: profiles")
+{
+    auto manager = BenchFixture::Instance().GetManager();
+    auto url = fmt::format("{}/client/game/profile/list", PROD_ENDPOINT);
+
+    bench.Run([manager, &url]() {
+        auto res = manager->Post_Json(url);
+        DoNotOptimize(res);
+    });
+}
@@ -0,0 +1,74 @@
+#include "Benchmark.hpp"
+#include "../src/Constants.hpp"
+
+#include <json.hpp>
+
+using namespace TarkovAPI;
+using namespace TarkovAPI::bench;
+
+// Request bodies are measured up to the string Post_Json sends
+TARKOV_BENCHMARK("serialize_market_finder")
+{
+    auto filter = quicktype::MarketFilterBody{}.set_handbook_id("5b5f78b786f77447ed5636af").set_limit(100);
+
+    bench.Run([&filter]() {
+        auto body = serialize_market_finder(filter).dump();
+        DoNotOptimize(body);
+    });
+}
+
+TARKOV_BENCHMARK("serialize_trade_item_request")
+{
+    auto barter_items = std::vector <quicktype::TraderBarterItem>{
+        quicktype::TraderBarterItem{ ObjectId("5e3a5a2c86f774130c6e2cd9"), 120000 },
+        quicktype::TraderBarterItem{ ObjectId("5e3a5a2c86f774130c6e2cda"), 30000 }
+    };
+    auto request = quicktype::TradeItemBody{
+        { quicktype::TradeItemDatum{ "TradingConfirm", "buy_from_trader", "54cb50c76803fa8b248b4571", "5e3a5a2c86f774130c6e2cdb", 1, 0, barter_items } },
+        2
+    };
+
+    bench.Run([&request]() {
+        auto body = serialize_trade_item_request(request).dump();
+        DoNotOptimize(body);
+    });
+}
+
+TARKOV_BENCHMARK("serialize_item_move_request")
+{
+    auto request = quicktype::ItemMoveBody{
+        { quicktype::ItemMoveDatum{ "Move", "5e3a5a2c86f774130c6e2cd9", quicktype::ItemMoveTo{ "5e3a5a2c86f774130c6e2cda", "hideout", { 3, 7, 0 } } } },
+        2
+    };
+
+    bench.Run([&request]() {
+        auto body = serialize_item_move_request(request).dump();
+        DoNotOptimize(body);
+    });
+}
+
+TARKOV_BENCHMARK("serialize_item_merge_request")
+{
+    auto request = quicktype::ItemStackBody{
+        { quicktype::ItemStackDatum{ "Merge", "5e3a5a2c86f774130c6e2cd9", "5e3a5a2c86f774130c6e2cda" } },
+        2
+    };
+
+    bench.Run([&request]() {
+        auto body = serialize_item_merge_request(request).dump();
+        DoNotOptimize(body);
+    });
+}
+
+TARKOV_BENCHMARK("serialize_market_buy_request")
+{
+    auto request = quicktype::MarketBuyReqBody{
+        { quicktype::BuyDatumContext{ "RagFairBuyOffer", { quicktype::BuyOfferContext{ "5e3a5a2c86f774130c6e2cd9", 1, { quicktype::TraderBarterItem{ ObjectId("5e3a5a2c86f774130c6e2cda"), 25000 } } } } } },
+        2
+    };
+
+    bench.Run([&request]() {
+        auto body = serialize_market_buy_request(request).dump();
+        DoNotOptimize(body);
+    });
+}
@@ -0,0 +1,146 @@
+#include "Benchmark.hpp"
+#include "BenchFixture.hpp"
+#include "../src/StashHelper.hpp"
+#include "../src/DefragPlanner.hpp"
+#include "../src/Inflater.hpp"
+#include "../src/Constants.hpp"
+
+#include <iostream>
+#include <streambuf>
+
+#include <json.hpp>
+
+using namespace TarkovAPI;
+using namespace TarkovAPI::bench;
+using json = nlohmann::json;
+
+namespace
+{
+    struct StashPlacement
+    {
+        int32_t pos;
+        int32_t width;
+        int32_t height;
+    };
+
+    class NullStreamBuf : public std::streambuf
+    {
+    protected:
+        int_type overflow(int_type ch) override
+        {
+            return traits_type::not_eof(ch);
+        }
+        std::streamsize xsputn(const char*, std::streamsize count) override
+        {
+            return count;
+        }
+    };
+
+    // Placements of main stash items in mock profile, in the same 1-based position format FindBlankStashPos uses
+    std::vector <StashPlacement> GetProfilePlacements(int32_t stash_width)
+    {
+        auto& fixture = BenchFixture::Instance();
+
+        const auto& profiles_body = fixture.GetCompressedBody("profiles");
+        const auto& items_body = fixture.GetCompressedBody("items");
+
+        auto profiles = parse_response(json::parse(InflateBuffer(profiles_body.data(), profiles_body.size()))).data;
+        auto items = parse_response(json::parse(InflateBuffer(items_body.data(), items_body.size()))).data;
+
+        auto placements = std::vector <StashPlacement>();
+        for (const auto& profile : profiles)
+        {
+            if (profile["Info"]["Side"] == "Savage")
+            {
+                continue;
+            }
+
+            auto stash_id = profile["Inventory"]["stash"];
+            for (const auto& item : profile["Inventory"]["items"])
+            {
+                if (!item.contains("parentId") || item["parentId"] != stash_id || !item.contains("location"))
+                {
+                    continue;
+                }
+
+                const auto& props = items[item["_tpl"].get<std::string>()]["_props"];
+                auto x = item["location"]["x"].get<int32_t>() + 1;
+                auto y = item["location"]["y"].get<int32_t>() + 1;
+
+                placements.emplace_back(StashPlacement{ (y * stash_width + x) - stash_width, props["Width"].get<int32_t>(), props["Height"].get<int32_t>() });
+            }
+        }
+        return placements;
+    }
+}
+
+TARKOV_BENCHMARK("StashHelper::Put: profile stash")
+{
+    auto placements = GetProfilePlacements(10);
+
+    bench.Run([&placements]() {
+        auto stash_helper = StashHelper{ 10, 28 };
+        for (const auto& placement : placements)
+        {
+            stash_helper.Put(placement.pos, placement.width, placement.height);
+        }
+        DoNotOptimize(stash_helper);
+    });
+}
+
+TARKOV_BENCHMARK("StashHelper::FindBlank: profile stash, rotated")
+{
+    auto stash_helper = StashHelper{ 10, 28 };
+    for (const auto& placement : GetProfilePlacements(10))
+    {
+        stash_helper.Put(placement.pos, placement.width, placement.height);
+    }
+
+    // Sizes of common items, cycled so the search can't be hoisted out of the loop
+    const std::pair <int32_t, int32_t> sizes[] = { { 1, 1 }, { 2, 1 }, { 2, 2 }, { 1, 3 }, { 3, 2 }, { 5, 2 } };
+    size_t next = 0;
+    volatile int32_t found = 0; // plain scalar result is dropped otherwise, DoNotOptimize only keeps its address
+
+    bench.Run([&]() {
+        const auto& size = sizes[next++ % std::size(sizes)];
+        auto rotated = false;
+        found = stash_helper.FindBlank(size.first, size.second, rotated);
+    });
+}
+
+TARKOV_BENCHMARK("StashHelper::Dump: 10x28")
+{
+    auto stash_helper = StashHelper{ 10, 28 };
+    for (const auto& placement : GetProfilePlacements(10))
+    {
+        stash_helper.Put(placement.pos, placement.width, placement.height);
+    }
+
+    // Formatting is measured, console output is not
+    auto null_buf = NullStreamBuf();
+    auto old_buf = std::cout.rdbuf(&null_buf);
+
+    bench.Run([&stash_helper]() {
+        stash_helper.Dump();
+    });
+
+    std::cout.rdbuf(old_buf);
+}
+
+TARKOV_BENCHMARK("DefragPlanner::Plan: profile stash, 5x5")
+{
+    auto planner = DefragPlanner{ 10, 28 };
+    auto id = 0u;
+    for (const auto& placement : GetProfilePlacements(10))
+    {
+        auto location = ItemLocation{ (placement.pos - 1) % 10, (placement.pos - 1) / 10, false, true };
+        planner.AddItem(ObjectId(fmt::format("{:024x}", ++id)), location, placement.width, placement.height);
+    }
+
+    volatile size_t moves = 0;
+
+    bench.Run([&]() {
+        auto plan = DefragPlan();
+        moves = planner.Plan(5, 5, DEFRAG_MAX_MOVES, plan) ? plan.moves.size() : SIZE_MAX;
+    });
+}
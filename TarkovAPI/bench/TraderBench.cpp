@@ -0,0 +1,65 @@
+#include "Benchmark.hpp"
+#include "BenchFixture.hpp"
+#include "../src/Inflater.hpp"
+#include "../src/Constants.hpp"
+
+#include <string>
+#include <vector>
+#include <utility>
+
+#include <json.hpp>
+
+using namespace TarkovAPI;
+using namespace TarkovAPI::bench;
+using json = nlohmann::json;
+
+TARKOV_BENCHMARK("GetTraderItems assembly")
+{
+    auto& fixture = BenchFixture::Instance();
+    auto manager = fixture.GetManager();
+
+    const auto& body = fixture.GetCompressedBody("assort");
+    auto items = parse_response(json::parse(InflateBuffer(body.data(), body.size()))).data;
+    auto prices = json::object();
+    auto trader_id = fixture.GetTraderId(0);
+
+    bench.Run([&]() {
+        auto result = manager->AssembleTraderItems(trader_id, items, prices);
+        DoNotOptimize(result);
+    });
+}
+
+TARKOV_BENCHMARK("GetTraderItems assembly: every trader")
+{
+    auto& fixture = BenchFixture::Instance();
+    auto manager = fixture.GetManager();
+    auto& source = fixture.GetPayloadSource();
+
+    // One op assembles assort of one trader, so allocs/op reads as allocations per trader
+    auto assorts = std::vector <std::pair <std::string, json>>();
+    for (const auto& trader : source.BuildTraders())
+    {
+        auto trader_id = trader["_id"].get<std::string>();
+        assorts.emplace_back(trader_id, source.BuildTraderAssort(trader_id));
+    }
+    const auto prices = json::object();
+    size_t next = 0;
+
+    bench.Run([&]() {
+        const auto& assort = assorts[next++ % assorts.size()];
+        auto result = manager->AssembleTraderItems(assort.first, assort.second, prices);
+        DoNotOptimize(result);
+    });
+}
+
+TARKOV_BENCHMARK("GetTraderItems loopback")
+{
+    auto& fixture = BenchFixture::Instance();
+    auto manager = fixture.GetManager();
+    auto trader_id = fixture.GetTraderId(0);
+
+    bench.Run([&]() {
+        auto result = manager->GetTraderItems(trader_id);
+        DoNotOptimize(result);
+    });
+}
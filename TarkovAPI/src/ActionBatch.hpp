@@ -0,0 +1,187 @@
+#pragma once
+#include "Constants.hpp"
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <algorithm>
+
+#include <json.hpp>
+
+namespace TarkovAPI
+{
+    // Result of single action in a flushed batch, index matches the order actions were added
+    struct ActionResult
+    {
+        size_t index;
+        std::string action;
+        std::string trader_id; // set for TradingConfirm
+        bool succeeded;
+        int64_t err;
+        std::string errmsg;
+    };
+
+    struct ActionBatchResult
+    {
+        nlohmann::json items; // Combined inventory changes of all actions
+        std::vector <ActionResult> results;
+
+        bool AllSucceeded() const
+        {
+            return std::all_of(results.begin(), results.end(), [](const ActionResult& x) { return x.succeeded; });
+        }
+    };
+
+    // Collects heterogeneous `items/moving` actions so they can be sent with a single request
+    class ActionBatch
+    {
+    public:
+        ActionBatch() = default;
+        ~ActionBatch() = default;
+
+        ActionBatch& Move(const std::string& item_id, const quicktype::ItemMoveTo& destination)
+        {
+            return Add(quicktype::ItemMoveDatum{ "Move", item_id, destination });
+        }
+
+        ActionBatch& MoveMailReward(const std::string& from_item_id, const std::string& to_item_id, const std::string& previous_owner_id, const quicktype::MailRewardToLocation& to_stash_location)
+        {
+            return Add(
+                quicktype::MailRewardDatum
+                {
+                    "Move",
+                    from_item_id,
+                    quicktype::MailRewardTo{ to_item_id, "hideout", to_stash_location },
+                    quicktype::MailFromOwner{ previous_owner_id, "Mail" }
+                }
+            );
+        }
+
+        ActionBatch& Merge(const std::string& from_item_id, const std::string& to_item_id)
+        {
+            return Add(quicktype::ItemStackDatum{ "Merge", from_item_id, to_item_id });
+        }
+
+        ActionBatch& Transfer(const std::string& from_item_id, const std::string& to_item_id, int64_t count)
+        {
+            return Add(quicktype::ItemTransferDatum{ "Transfer", from_item_id, to_item_id, count });
+        }
+
+        ActionBatch& TradingBuy(const std::string& trader_id, const std::string& item_id, int64_t quantity, const std::vector <quicktype::TraderBarterItem>& barter_items)
+        {
+            return Add(quicktype::TradeItemDatum{ "TradingConfirm", "buy_from_trader", trader_id, item_id, quantity, 0, barter_items });
+        }
+
+        ActionBatch& TradingSell(const std::string& trader_id, const std::string& item_id, int64_t quantity)
+        {
+            return Add(
+                quicktype::SellDatumContext
+                {
+                    "TradingConfirm",
+                    "sell_to_trader",
+                    trader_id,
+                    std::vector <quicktype::SellItemContext>{ quicktype::SellItemContext{ item_id, quantity, "0" } }
+                }
+            );
+        }
+
+        ActionBatch& RagFairBuyOffer(const std::string& offer_id, int64_t quantity, const std::vector <quicktype::TraderBarterItem>& barter_items)
+        {
+            return Add(
+                quicktype::BuyDatumContext
+                {
+                    "RagFairBuyOffer",
+                    std::vector <quicktype::BuyOfferContext>{ quicktype::BuyOfferContext{ offer_id, quantity, barter_items } }
+                }
+            );
+        }
+
+        ActionBatch& RagFairAddOffer(const std::vector <std::string>& items, const quicktype::OfferRequirementContext& requirement, bool sell_all = false)
+        {
+            return Add(
+                quicktype::OfferDatumContext
+                {
+                    "RagFairAddOffer",
+                    sell_all,
+                    items,
+                    std::vector <quicktype::OfferRequirementsContext>{ quicktype::OfferRequirementsContext{ requirement._tpl, requirement.price, 0, 0, false } },
+                    2
+                }
+            );
+        }
+
+        size_t Size() const
+        {
+            return m_vActions.size();
+        }
+        bool Empty() const
+        {
+            return m_vActions.empty();
+        }
+        void Clear()
+        {
+            m_vActions.clear();
+        }
+
+        nlohmann::json Serialize(int64_t tm = 2) const
+        {
+            auto j = nlohmann::json::object();
+            j["data"] = m_vActions;
+            j["tm"] = tm;
+            return j;
+        }
+
+        // Maps combined `items/moving` response data back to added actions
+        ActionBatchResult MapResults(const nlohmann::json& data) const
+        {
+            auto out = ActionBatchResult{};
+            out.results.reserve(m_vActions.size());
+
+            for (size_t i = 0; i < m_vActions.size(); ++i)
+            {
+                const auto& action = m_vActions[i];
+                auto trader_id = action.contains("tid") ? action["tid"].get<std::string>() : "";
+                out.results.emplace_back(ActionResult{ i, action["Action"].get<std::string>(), trader_id, true, ErrorCodes::OK, "" });
+            }
+
+            if (data.is_object() && data.contains("badRequest") && data["badRequest"].is_array())
+            {
+                for (const auto& bad_request : data["badRequest"])
+                {
+                    if (!bad_request.is_object() || !bad_request.contains("index"))
+                    {
+                        continue;
+                    }
+
+                    auto index = bad_request["index"].get<size_t>();
+                    if (index >= out.results.size())
+                    {
+                        continue;
+                    }
+
+                    auto& result = out.results[index];
+                    result.succeeded = false;
+                    result.err = (bad_request.contains("err") && bad_request["err"].is_number_integer()) ? bad_request["err"].get<int64_t>() : static_cast<int64_t>(ErrorCodes::BackendError);
+                    result.errmsg = (bad_request.contains("errmsg") && bad_request["errmsg"].is_string()) ? bad_request["errmsg"].get<std::string>() : "";
+                }
+            }
+
+            if (data.is_object() && data.contains("items"))
+            {
+                out.items = data["items"];
+            }
+            return out;
+        }
+
+    protected:
+        template <typename T>
+        ActionBatch& Add(const T& datum)
+        {
+            m_vActions.emplace_back(datum);
+            return *this;
+        }
+
+    private:
+        std::vector <nlohmann::json> m_vActions;
+    };
+};
@@ -0,0 +1,401 @@
+#include "AsyncHttpClient.hpp"
+#include "HttpClient.hpp"
+#include "Inflater.hpp"
+#include "Constants.hpp"
+#include "Exception.hpp"
+#include "Trace.hpp"
+#include <cassert>
+
+namespace TarkovAPI
+{
+    struct AsyncHttpClient::Request
+    {
+        std::string url;
+        std::string body;
+        curl_slist* headers{ nullptr };
+        CURL* handle{ nullptr };
+
+        ZlibInflater inflater;
+        std::string decompressed;
+        std::exception_ptr write_error;
+        long status_code{ 0 };
+
+        std::shared_ptr <TrafficCapture> capture;
+        std::shared_ptr <TrafficReplay> replay;
+        cpr::Header header_map; // capture only
+        std::string captured; // whole compressed body, capture only
+
+        TransferMetrics transfer;
+        std::chrono::steady_clock::time_point attached;
+        uint64_t trace_begin_us{ 0 };
+        bool traced{ false };
+
+        Callback callback;
+
+        ~Request()
+        {
+            if (headers)
+            {
+                curl_slist_free_all(headers);
+                headers = nullptr;
+            }
+        }
+    };
+
+
+    AsyncHttpClient::AsyncHttpClient()
+    {
+        m_pkMulti = curl_multi_init();
+        if (!m_pkMulti)
+        {
+            throw TarkovAPIException(Error::CprSessionFailed);
+        }
+        curl_multi_setopt(m_pkMulti, CURLMOPT_PIPELINING, static_cast<long>(CURLPIPE_MULTIPLEX));
+
+        m_bRunning = true;
+        m_kLoopThread = std::thread(&AsyncHttpClient::Run, this);
+    }
+    AsyncHttpClient::~AsyncHttpClient()
+    {
+        m_bRunning = false;
+        curl_multi_wakeup(m_pkMulti);
+
+        if (m_kLoopThread.joinable())
+        {
+            m_kLoopThread.join();
+        }
+
+        AbortRequests();
+
+        for (auto handle : m_vIdleHandles)
+        {
+            curl_easy_cleanup(handle);
+        }
+        m_vIdleHandles.clear();
+
+        curl_multi_cleanup(m_pkMulti);
+        m_pkMulti = nullptr;
+    }
+
+    size_t AsyncHttpClient::OnWriteCallback(char* ptr, size_t size, size_t nmemb, void* userdata)
+    {
+        auto request = reinterpret_cast<Request*>(userdata);
+
+        request->transfer.compressed_bytes += size * nmemb;
+        if (request->capture)
+        {
+            request->captured.append(ptr, size * nmemb);
+        }
+
+        auto status_code = 0L;
+        curl_easy_getinfo(request->handle, CURLINFO_RESPONSE_CODE, &status_code);
+        if (status_code != 200) // Error body is not compressed, status will be reported on completion
+        {
+            return size * nmemb;
+        }
+
+        try
+        {
+            ScopedTimer timer(request->transfer.inflate_us);
+            request->inflater.Feed(ptr, size * nmemb, [request](const char* chunk, size_t chunk_size) {
+                request->decompressed.append(chunk, chunk_size);
+            });
+        }
+        catch (...)
+        {
+            request->write_error = std::current_exception();
+            return 0; // Aborts transfer with CURLE_WRITE_ERROR
+        }
+        return size * nmemb;
+    }
+
+    void AsyncHttpClient::PostJson(const std::string& url, const std::string& body, const cpr::Header& headers, Callback callback)
+    {
+        assert(callback && "Null callback");
+
+        auto request = std::make_unique<Request>();
+        request->url = url;
+        request->body = body;
+        request->headers = HttpClient::BuildHeaderList(headers);
+        request->callback = std::move(callback);
+
+        if (TraceCollector::IsEnabled())
+        {
+            request->trace_begin_us = TraceCollector::Now();
+            request->traced = true;
+        }
+
+        m_nPending++;
+        {
+            std::lock_guard <std::mutex> lock(m_pkMutex);
+
+            request->capture = m_pkCapture;
+            request->replay = m_pkReplay;
+            if (request->capture && !request->replay)
+            {
+                request->header_map = headers;
+            }
+            m_vQueued.emplace_back(std::move(request));
+        }
+
+        curl_multi_wakeup(m_pkMulti);
+    }
+
+    void AsyncHttpClient::SetCapture(std::shared_ptr <TrafficCapture> capture)
+    {
+        std::lock_guard <std::mutex> lock(m_pkMutex);
+        m_pkCapture = std::move(capture);
+    }
+
+    void AsyncHttpClient::SetReplay(std::shared_ptr <TrafficReplay> replay)
+    {
+        std::lock_guard <std::mutex> lock(m_pkMutex);
+        m_pkReplay = std::move(replay);
+    }
+
+    size_t AsyncHttpClient::GetPendingCount() const
+    {
+        return m_nPending;
+    }
+
+    void AsyncHttpClient::Run()
+    {
+        while (m_bRunning)
+        {
+            AttachQueuedRequests();
+
+            auto running = 0;
+            auto mc = curl_multi_perform(m_pkMulti, &running);
+            if (CURLM_OK != mc)
+            {
+                break;
+            }
+
+            CollectCompletedRequests();
+
+            curl_multi_poll(m_pkMulti, nullptr, 0, 1000, nullptr);
+        }
+    }
+
+    void AsyncHttpClient::AttachQueuedRequests()
+    {
+        auto queued = std::vector <std::unique_ptr <Request>>();
+        {
+            std::lock_guard <std::mutex> lock(m_pkMutex);
+            queued.swap(m_vQueued);
+        }
+
+        for (auto& request : queued)
+        {
+            if (request->replay)
+            {
+                ReplayRequest(std::move(request));
+                continue;
+            }
+
+            auto handle = static_cast<CURL*>(nullptr);
+            if (!m_vIdleHandles.empty())
+            {
+                handle = m_vIdleHandles.back();
+                m_vIdleHandles.pop_back();
+            }
+            else
+            {
+                handle = curl_easy_init();
+            }
+
+            if (!handle)
+            {
+                CompleteRequest(std::move(request), CURLE_FAILED_INIT);
+                continue;
+            }
+
+            request->handle = handle;
+            request->attached = std::chrono::steady_clock::now();
+
+            HttpClient::ApplyConnectionOptions(handle);
+            curl_easy_setopt(handle, CURLOPT_URL, request->url.c_str());
+            curl_easy_setopt(handle, CURLOPT_POST, 1L);
+            curl_easy_setopt(handle, CURLOPT_POSTFIELDS, request->body.data());
+            curl_easy_setopt(handle, CURLOPT_POSTFIELDSIZE_LARGE, static_cast<curl_off_t>(request->body.size()));
+            curl_easy_setopt(handle, CURLOPT_HTTPHEADER, request->headers);
+            curl_easy_setopt(handle, CURLOPT_WRITEFUNCTION, &AsyncHttpClient::OnWriteCallback);
+            curl_easy_setopt(handle, CURLOPT_WRITEDATA, request.get());
+
+            if (CURLM_OK != curl_multi_add_handle(m_pkMulti, handle))
+            {
+                CompleteRequest(std::move(request), CURLE_FAILED_INIT);
+                continue;
+            }
+            m_pkActive.emplace(handle, std::move(request));
+        }
+    }
+
+    void AsyncHttpClient::CollectCompletedRequests()
+    {
+        auto msgs = 0;
+        while (auto msg = curl_multi_info_read(m_pkMulti, &msgs))
+        {
+            if (msg->msg != CURLMSG_DONE)
+            {
+                continue;
+            }
+
+            auto it = m_pkActive.find(msg->easy_handle);
+            if (it == m_pkActive.end())
+            {
+                continue;
+            }
+
+            auto request = std::move(it->second);
+            m_pkActive.erase(it);
+
+            curl_multi_remove_handle(m_pkMulti, request->handle);
+            CompleteRequest(std::move(request), msg->data.result);
+        }
+    }
+
+    // Captured body goes through the same inflate and parse as live responses
+    void AsyncHttpClient::ReplayRequest(std::unique_ptr <Request> request)
+    {
+        try
+        {
+            const auto& record = request->replay->Find(request->url, request->body);
+
+            request->status_code = record.status;
+            request->transfer.compressed_bytes = record.response.size();
+
+            if (record.status == 200)
+            {
+                ScopedTimer timer(request->transfer.inflate_us);
+                request->inflater.Feed(record.response.data(), record.response.size(), [&request](const char* chunk, size_t chunk_size) {
+                    request->decompressed.append(chunk, chunk_size);
+                });
+            }
+        }
+        catch (...)
+        {
+            request->write_error = std::current_exception();
+        }
+
+        CompleteRequest(std::move(request), CURLE_OK);
+    }
+
+    void AsyncHttpClient::CompleteRequest(std::unique_ptr <Request> request, CURLcode result)
+    {
+        json response{};
+        std::exception_ptr error{};
+
+        if (request->handle)
+        {
+            curl_easy_getinfo(request->handle, CURLINFO_RESPONSE_CODE, &request->status_code);
+
+            auto elapsed_us = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - request->attached).count());
+            request->transfer.network_us = (elapsed_us > request->transfer.inflate_us) ? elapsed_us - request->transfer.inflate_us : 0;
+        }
+
+        try
+        {
+            const auto status_code = request->status_code;
+            if (status_code && status_code != 200) // HTTP status code
+            {
+                throw TarkovAPIException(Error::CprPostFailed, static_cast<int64_t>(status_code));
+            }
+            if (request->write_error)
+            {
+                std::rethrow_exception(request->write_error);
+            }
+            if (CURLE_OK != result) // CURL error code
+            {
+                throw TarkovAPIException(Error::CprApiFailed, curl_easy_strerror(result));
+            }
+
+            {
+                ScopedTimer timer(request->transfer.inflate_us);
+                request->inflater.Finish();
+            }
+            request->transfer.decompressed_bytes = request->decompressed.size();
+
+            ScopedTimer timer(request->transfer.parse_us);
+            response = json::parse(request->decompressed);
+        }
+        catch (...)
+        {
+            error = std::current_exception();
+        }
+
+        std::string().swap(request->decompressed);
+
+        // Failures are captured too, like HttpClient does
+        if (request->capture && !request->replay)
+        {
+            try
+            {
+                request->capture->Append(request->url, request->body, request->header_map, static_cast<int32_t>(request->status_code), request->captured);
+            }
+            catch (...)
+            {
+                if (!error)
+                {
+                    error = std::current_exception();
+                }
+            }
+        }
+
+        if (request->traced)
+        {
+            auto detail = MetricsRegistry::NormalizePath(request->url);
+            TraceCollector::Instance().Record("AsyncHttpClient::PostJson", request->trace_begin_us, TraceCollector::Now() - request->trace_begin_us, detail.data(), detail.size());
+        }
+
+        if (request->handle)
+        {
+            curl_easy_reset(request->handle);
+            m_vIdleHandles.emplace_back(request->handle);
+            request->handle = nullptr;
+        }
+        m_nPending--;
+
+        try
+        {
+            request->callback(std::move(response), error, request->transfer);
+        }
+        catch (...)
+        {
+            // Callback exceptions must not stop event loop
+        }
+    }
+
+    void AsyncHttpClient::AbortRequests()
+    {
+        auto aborted = std::vector <std::unique_ptr <Request>>();
+        {
+            std::lock_guard <std::mutex> lock(m_pkMutex);
+            aborted.swap(m_vQueued);
+        }
+        for (auto& [handle, request] : m_pkActive)
+        {
+            curl_multi_remove_handle(m_pkMulti, handle);
+            aborted.emplace_back(std::move(request));
+        }
+        m_pkActive.clear();
+
+        for (auto& request : aborted)
+        {
+            if (request->handle)
+            {
+                curl_easy_cleanup(request->handle);
+                request->handle = nullptr;
+            }
+            m_nPending--;
+
+            try
+            {
+                request->callback(json{}, std::make_exception_ptr(TarkovAPIException(Error::CprApiFailed, "Async client is shutting down")), request->transfer);
+            }
+            catch (...)
+            {
+            }
+        }
+    }
+};
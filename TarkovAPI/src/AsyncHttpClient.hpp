@@ -0,0 +1,76 @@
+#pragma once
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <atomic>
+#include <functional>
+#include <exception>
+
+#include <cpr/cprtypes.h>
+#include <curl/curl.h>
+#include <json.hpp>
+
+#include "TrafficCapture.hpp"
+#include "Metrics.hpp"
+
+namespace TarkovAPI
+{
+	using json = nlohmann::json;
+
+	// Runs any number of requests on one curl multi event loop thread
+	// Callbacks are invoked from the loop thread, they should hand off heavy work instead of blocking other transfers
+	// Capture, replay and transfer metrics work like HttpClient's; network time of a transfer includes waits for other transfers of the loop
+	class AsyncHttpClient
+	{
+	public:
+		using Callback = std::function<void(json&& response, std::exception_ptr error, const TransferMetrics& transfer)>;
+
+	public:
+		AsyncHttpClient();
+		virtual ~AsyncHttpClient();
+
+		AsyncHttpClient(const AsyncHttpClient&) = delete;
+		AsyncHttpClient(AsyncHttpClient&&) noexcept = delete;
+		AsyncHttpClient& operator=(const AsyncHttpClient&) = delete;
+		AsyncHttpClient& operator=(AsyncHttpClient&&) noexcept = delete;
+
+		void PostJson(const std::string& url, const std::string& body, const cpr::Header& headers, Callback callback);
+
+		// Applied to requests posted later; both may be null
+		void SetCapture(std::shared_ptr <TrafficCapture> capture);
+		void SetReplay(std::shared_ptr <TrafficReplay> replay);
+
+		size_t GetPendingCount() const;
+
+	protected:
+		struct Request;
+
+		static size_t OnWriteCallback(char* ptr, size_t size, size_t nmemb, void* userdata);
+
+		void Run();
+		void AttachQueuedRequests();
+		void CollectCompletedRequests();
+		void ReplayRequest(std::unique_ptr <Request> request);
+		void CompleteRequest(std::unique_ptr <Request> request, CURLcode result);
+		void AbortRequests();
+
+	private:
+		CURLM* m_pkMulti;
+		std::thread m_kLoopThread;
+		std::atomic <bool> m_bRunning{ false };
+		std::atomic <size_t> m_nPending{ 0 };
+
+		mutable std::mutex m_pkMutex;
+		std::vector <std::unique_ptr <Request>> m_vQueued;
+		std::shared_ptr <TrafficCapture> m_pkCapture;
+		std::shared_ptr <TrafficReplay> m_pkReplay;
+
+		// Loop thread only
+		std::map <CURL*, std::unique_ptr <Request>> m_pkActive;
+		std::vector <CURL*> m_vIdleHandles;
+	};
+};
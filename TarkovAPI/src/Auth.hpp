@@ -4,16 +4,19 @@
 #include "Exception.hpp"
 #include "TarkovAPIManager.hpp"
 #include "Hwid.hpp"
+#include "HttpClient.hpp"
+#include "Trace.hpp"
 
 #include <stdint.h>
 #include <string>
 #include <regex>
 #include <vector>
+#include <chrono>
+#include <cstdio>
+#include <fstream>
 
 #include <fmt/format.h>
-#include <zlib.h>
 #include <cpr/cpr.h>
-#include <cpr/session.h>
 #include <json.hpp>
 
 namespace TarkovAPI
@@ -24,6 +27,8 @@ namespace TarkovAPI
 
         static void OnLauncherResponseHandle(const std::string& func, const std::string& err, const int errCode)
         {
+            ScopedHandleTimer handle_timer;
+
             switch (errCode)
             {
             case ErrorCodes::OK:
@@ -70,8 +75,10 @@ namespace TarkovAPI
             }
         }
 
-        static json LauncherPostJson(cpr::Session* client, const std::string& url, const std::string& body = "", const std::string& token = "")
+        static json LauncherPostJson(HttpClient* client, const std::string& url, const std::string& body = "", const std::string& token = "")
         {
+            TRACE_SCOPE_DETAIL("LauncherPostJson", MetricsRegistry::NormalizePath(url));
+
             gs_pAPILogInstance->Log(__FUNCTION__, LL_DEV, fmt::format("Sending request to {} ({})", url, body));
 
             auto headers = cpr::Header{
@@ -81,68 +88,46 @@ namespace TarkovAPI
             if (!token.empty())
                 headers.emplace("Authorization", token);
 
-            client->SetUrl(cpr::Url{ url });
-            client->SetBody(cpr::Body{ body });
-            client->SetHeader(headers);
-
-            auto res = client->Post();
-
-            switch (res.error.code) // CPR error code
-            {
-            case cpr::ErrorCode::OK:
-                break;
-            default:
-                throw TarkovAPIException(Error::CprApiFailed, res.error.message);
-            }
-
-            switch (res.status_code) // HTTP status code
-            {
-            case 200: // OK
-                break;
-            default:
-                throw TarkovAPIException(Error::CprPostFailed, res.status_code);
-            }
-
-            std::vector <uint8_t> decompresseddata(res.text.size() * 10);
-
-            auto decompressedsize = static_cast<uLongf>(decompresseddata.size());
-            auto ret = uncompress(
-                reinterpret_cast<Bytef*>(&decompresseddata[0]), &decompressedsize,
-                reinterpret_cast<const Bytef*>(res.text.data()), static_cast<uLong>(res.text.size())
-            );
-            if (Z_OK != ret)
-            {
-                throw TarkovAPIException(Error::ZlibDecompressFailed, ret);
-            }
-
             json deserialized{};
             try
             {
-                deserialized = json::parse(decompresseddata.data());
+                deserialized = client->PostJson(url, body, headers);
             }
             catch (const json::parse_error & ex)
             {
+                MetricsRegistry::Instance().RecordRequest(url, client->GetLastTransfer(), REQUEST_FAILED_CODE);
+
                 std::stringstream ss;
                 ss << "Message: " << ex.what() << '\n' << "exception id: " << ex.id << '\n' << "byte position of error: " << ex.byte << std::endl;
 
                 throw TarkovAPIException(Error::JsonParseFailed, ss.str());
             }
+            catch (...)
+            {
+                MetricsRegistry::Instance().RecordRequest(url, client->GetLastTransfer(), REQUEST_FAILED_CODE);
+                throw;
+            }
 
             gs_pAPILogInstance->Log(__FUNCTION__, LL_DEV, fmt::format("Response: {}", deserialized.dump()));
 
             if (!deserialized.contains("err") || !deserialized.contains("errmsg"))
             {
+                MetricsRegistry::Instance().RecordRequest(url, client->GetLastTransfer(), REQUEST_FAILED_CODE);
                 throw TarkovAPIException(Error::JsonBadFormat, "'err' or 'errmsg' key is not available");
             }
             else if (!deserialized.contains("data"))
             {
+                MetricsRegistry::Instance().RecordRequest(url, client->GetLastTransfer(), REQUEST_FAILED_CODE);
                 throw TarkovAPIException(Error::JsonBadFormat, "'data' key is not available");
             }
 
+            auto error_code = deserialized["err"].is_number() ? deserialized["err"].get<int64_t>() : REQUEST_FAILED_CODE;
+            MetricsRegistry::Instance().RecordRequest(url, client->GetLastTransfer(), error_code);
+
             return deserialized;
         }
 
-        static void CheckLauncherVersion(cpr::Session* client)
+        static void CheckLauncherVersion(HttpClient* client)
         {
             auto url = fmt::format(
                 "{}/launcher/GetLauncherDistrib",
@@ -169,7 +154,7 @@ namespace TarkovAPI
             }
         }
 
-        static void CheckGameVersion(cpr::Session* client)
+        static void CheckGameVersion(HttpClient* client)
         {
             auto url = fmt::format(
                 "{}/launcher/GetPatchList?launcherVersion={}&branch=live",
@@ -196,7 +181,67 @@ namespace TarkovAPI
             }
         }
 
-        static void ActivateHardware(cpr::Session* client, const std::string& email, const std::string& code, const std::string& hwid)
+        // Cache is bound to launcher endpoint, so an overridden endpoint never feeds live versions
+        static bool LoadVersionCache(const std::string& path, std::chrono::seconds ttl)
+        {
+            std::ifstream file(path);
+            if (!file)
+            {
+                return false;
+            }
+
+            auto cache = json::parse(file, nullptr, false);
+            if (cache.is_discarded() || !cache.is_object() ||
+                cache.value("endpoint", "") != LAUNCHER_ENDPOINT)
+            {
+                return false;
+            }
+
+            auto now = std::chrono::duration_cast<std::chrono::seconds>(std::chrono::system_clock::now().time_since_epoch()).count();
+            auto saved_at = cache.value("saved_at", int64_t(0));
+            if (now < saved_at || now - saved_at >= ttl.count())
+            {
+                return false;
+            }
+
+            auto launcher_version = cache.value("launcher", "");
+            auto game_version = cache.value("game", "");
+            if (launcher_version.empty() || game_version.empty())
+            {
+                return false;
+            }
+
+            LAUNCHER_VERSION = launcher_version;
+            GAME_VERSION = game_version;
+
+            gs_pAPILogInstance->Log(__FUNCTION__, LL_SYS, fmt::format("Cached versions used, launcher: {} game: {}", LAUNCHER_VERSION, GAME_VERSION));
+            return true;
+        }
+
+        static void SaveVersionCache(const std::string& path)
+        {
+            json cache{};
+            cache["endpoint"] = LAUNCHER_ENDPOINT;
+            cache["launcher"] = LAUNCHER_VERSION;
+            cache["game"] = GAME_VERSION;
+            cache["saved_at"] = std::chrono::duration_cast<std::chrono::seconds>(std::chrono::system_clock::now().time_since_epoch()).count();
+
+            auto temp_path = path + ".tmp";
+            {
+                std::ofstream file(temp_path, std::ios::trunc);
+                file << cache.dump();
+                if (!file)
+                {
+                    gs_pAPILogInstance->Log(__FUNCTION__, LL_ERR, fmt::format("Version cache could not written: {}", path));
+                    return;
+                }
+            }
+
+            std::remove(path.c_str());
+            std::rename(temp_path.c_str(), path.c_str());
+        }
+
+        static void ActivateHardware(HttpClient* client, const std::string& email, const std::string& code, const std::string& hwid)
         {
             auto url = fmt::format(
                 "{}/launcher/hardwareCode/activate?launcherVersion={}",
@@ -212,7 +257,7 @@ namespace TarkovAPI
             OnLauncherResponseHandle(__FUNCTION__, res["errmsg"].dump(), res["err"].get<int32_t>());
         }
 
-        static std::string ExchangeAccessToken(cpr::Session* client, const std::string& access_token, const std::string& hwid)
+        static std::string ExchangeAccessToken(HttpClient* client, const std::string& access_token, const std::string& hwid)
         {
             auto url = fmt::format(
                 "{}/launcher/game/start?launcherVersion={}&branch=live",
@@ -234,7 +279,7 @@ namespace TarkovAPI
             return res["data"].dump();
         }
 
-        static std::string LoginImpl(cpr::Session* client, const std::string& email, const std::string& password, const std::string& captcha, const std::string& hwid)
+        static std::string LoginImpl(HttpClient* client, const std::string& email, const std::string& password, const std::string& captcha, const std::string& hwid)
         {
             auto url = fmt::format(
                 "{}/launcher/login?launcherVersion={}&branch=live",
@@ -10,6 +10,8 @@
 #include <variant>
 #include <optional>
 
+#include "ObjectId.hpp"
+
 #ifndef NLOHMANN_OPT_HELPER
 #define NLOHMANN_OPT_HELPER
 namespace nlohmann {
@@ -23,6 +25,17 @@ namespace nlohmann {
             if (j.is_null()) return std::unique_ptr<T>(); else return std::unique_ptr<T>(new T(j.get<T>()));
         }
     };
+
+    template <typename T>
+    struct adl_serializer<std::optional<T>> {
+        static void to_json(json& j, const std::optional<T>& opt) {
+            if (!opt) j = nullptr; else j = *opt;
+        }
+
+        static std::optional<T> from_json(const json& j) {
+            if (j.is_null()) return std::nullopt; else return j.get<T>();
+        }
+    };
 }
 #endif
 
@@ -55,12 +68,23 @@ namespace quicktype // https://app.quicktype.io
         return get_optional<T>(j, property.data());
     }
 
+    // Same as get_optional, value is kept inline instead of on heap
+    template <typename T>
+    inline std::optional<T> get_optional_inline(const nlohmann::json& j, const char* property) {
+        auto it = j.find(property);
+        if (it != j.end() && !it->is_null()) {
+            return it->get<T>();
+        }
+        return std::nullopt;
+    }
+
     // Common decompressed API response
     struct ResponseBody
     {
         nlohmann::json data;
         int64_t err;
         std::string errmsg;
+        int64_t crc; // static data only, 0 when server sent none
     };
 
     // Profile
@@ -96,7 +120,7 @@ namespace quicktype // https://app.quicktype.io
     // Common
     struct TraderBarterItem
     {
-        std::string _tpl;
+        TarkovAPI::ObjectId _tpl;
         double count;
     };
 
@@ -255,16 +279,16 @@ namespace quicktype // https://app.quicktype.io
     struct TraderItemUpd
     {
         int64_t stack_objects_count;
-        std::shared_ptr<bool> unlimited_count;
-        std::shared_ptr<int64_t> buy_restriction_current;
-        std::shared_ptr<int64_t> buy_restriction_max;
+        std::optional<bool> unlimited_count;
+        std::optional<int64_t> buy_restriction_current;
+        std::optional<int64_t> buy_restriction_max;
     };
 
     struct TraderItem
     {
-        std::string _id;
-        std::string _tpl;
-        std::shared_ptr <TraderItemUpd> upd;
+        TarkovAPI::ObjectId _id;
+        TarkovAPI::ObjectId _tpl;
+        std::optional <TraderItemUpd> upd;
         std::vector <quicktype::TraderBarterItem> costs;
         int64_t loyalty_level;
     };
@@ -717,7 +741,7 @@ namespace nlohmann {
         }
 
         inline void from_json(const json& j, quicktype::TraderBarterItem& x) {
-            x._tpl = j.at("id").get<std::string>();
+            x._tpl = j.at("id").get<TarkovAPI::ObjectId>();
             x.count = j.at("count").get<double>();
         }
 
@@ -761,9 +785,9 @@ namespace nlohmann {
 
         inline void from_json(const json& j, quicktype::TraderItemUpd& x) {
             x.stack_objects_count = j.at("StackObjectsCount").get<int64_t>();
-            x.unlimited_count = quicktype::get_optional<bool>(j, "UnlimitedCount");
-            x.buy_restriction_current = quicktype::get_optional<int64_t>(j, "BuyRestrictionCurrent");
-            x.buy_restriction_max = quicktype::get_optional<int64_t>(j, "BuyRestrictionMax");
+            x.unlimited_count = quicktype::get_optional_inline<bool>(j, "UnlimitedCount");
+            x.buy_restriction_current = quicktype::get_optional_inline<int64_t>(j, "BuyRestrictionCurrent");
+            x.buy_restriction_max = quicktype::get_optional_inline<int64_t>(j, "BuyRestrictionMax");
         }
 
         inline void to_json(json& j, const quicktype::TraderItemUpd& x) {
@@ -847,16 +871,41 @@ namespace TarkovAPI
     static std::string LAUNCHER_VERSION = "0.9.3.1023";
     static std::string UNITY_VERSION = "2018.4.13f1";
 
-    static constexpr auto LAUNCHER_ENDPOINT = "https://launcher.escapefromtarkov.com";
-    static constexpr auto PROD_ENDPOINT = "https://prod.escapefromtarkov.com";
-    static constexpr auto TRADING_ENDPOINT = "https://trading.escapefromtarkov.com";
-    static constexpr auto RAGFAIR_ENDPOINT = "https://ragfair.escapefromtarkov.com";
+    // Endpoints can be redirected at runtime, e.g. to the local mock backend
+    inline std::string LAUNCHER_ENDPOINT = "https://launcher.escapefromtarkov.com";
+    inline std::string PROD_ENDPOINT = "https://prod.escapefromtarkov.com";
+    inline std::string TRADING_ENDPOINT = "https://trading.escapefromtarkov.com";
+    inline std::string RAGFAIR_ENDPOINT = "https://ragfair.escapefromtarkov.com";
+
+    static constexpr auto ENDPOINT_OVERRIDE_ENV = "TARKOVAPI_ENDPOINT";
+
+    // Launcher and game versions of last startup, reused while younger than TTL; written to working directory next to TarkovAPI.log
+    static constexpr auto VERSION_CACHE_FILENAME = "TarkovAPI.versions.json";
+    static constexpr auto VERSION_CACHE_TTL_SECONDS = 3600;
+
+    inline void OverrideEndpoints(const std::string& launcher, const std::string& prod, const std::string& trading, const std::string& ragfair)
+    {
+        LAUNCHER_ENDPOINT = launcher;
+        PROD_ENDPOINT = prod;
+        TRADING_ENDPOINT = trading;
+        RAGFAIR_ENDPOINT = ragfair;
+    }
+    inline void OverrideEndpoints(const std::string& base_url)
+    {
+        OverrideEndpoints(base_url, base_url, base_url, base_url);
+    }
 
     static constexpr auto ROUBLE_ITEM_ID = "5449016a4bdc2d6f028b456f";
     static constexpr auto USD_ITEM_ID = "5696686a4bdc2da3298b456a";
     static constexpr auto EURO_ITEM_ID = "569668774bdc2da2298b4568";
+    static constexpr auto ROUBLE_OBJECT_ID = ObjectId::FromLiteral("5449016a4bdc2d6f028b456f");
+    static constexpr auto USD_OBJECT_ID = ObjectId::FromLiteral("5696686a4bdc2da3298b456a");
+    static constexpr auto EURO_OBJECT_ID = ObjectId::FromLiteral("569668774bdc2da2298b4568");
     
     static constexpr auto MAXIMUM_STASH_SIZE = 10 * 66;
+    static constexpr size_t DEFRAG_MAX_MOVES = 8;
+    static constexpr size_t TRADER_SWEEP_CONCURRENCY = 4; // traders whose assort requests are in flight at once
+    static constexpr int64_t TRADER_RESUPPLY_GRACE_SECONDS = 5; // assort is stale this long after supply_next_time, server restocks a moment late
 
     enum MailTypes
     {
@@ -904,7 +953,11 @@ namespace TarkovAPI
         MarketBadRequest,
         NullDataForParse,
         TraderNotFound,
-        ItemNotFound
+        ItemNotFound,
+        CaptureFailed,
+        ReplayNotFound,
+        InvalidObjectId,
+        NoStashSpace
     };
 
     inline quicktype::ResponseBody parse_response(const nlohmann::json& j)
@@ -913,6 +966,7 @@ namespace TarkovAPI
         x.data = quicktype::get_untyped(j, "data");
         x.err = j.at("err").get<int64_t>();
         x.errmsg = j.at("errmsg").is_string() ? j.at("errmsg").get<std::string>() : "";
+        x.crc = (j.contains("crc") && j.at("crc").is_number()) ? j.at("crc").get<int64_t>() : 0;
         return x;
     }
 
@@ -999,9 +1053,9 @@ namespace TarkovAPI
     inline quicktype::TraderItem parse_trader_item(const nlohmann::json& j)
     {
         quicktype::TraderItem x{};
-        x._id = j.at("_id").get<std::string>();
-        x._tpl = j.at("_tpl").get<std::string>();
-        x.upd = quicktype::get_optional<quicktype::TraderItemUpd>(j, "upd");
+        x._id = j.at("_id").get<TarkovAPI::ObjectId>();
+        x._tpl = j.at("_tpl").get<TarkovAPI::ObjectId>();
+        x.upd = quicktype::get_optional_inline<quicktype::TraderItemUpd>(j, "upd");
         return x;
     }
 
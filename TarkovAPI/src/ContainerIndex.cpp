@@ -0,0 +1,440 @@
+#include "ContainerIndex.hpp"
+
+#include <algorithm>
+#include <tuple>
+
+namespace TarkovAPI
+{
+    // Item tree of game is a few levels deep, bound only guards against malformed _parent loops
+    static constexpr size_t MAX_TEMPLATE_DEPTH = 32;
+
+    // Contents of these are in grids and never change their size
+    static constexpr auto BACKPACK_CATEGORY_ID = ObjectId::FromLiteral("5448e53e4bdc2d60728b4567");
+    static constexpr auto SEARCHABLE_CATEGORY_ID = ObjectId::FromLiteral("566168634bdc2d144c8b456c");
+    static constexpr auto SIMPLE_CONTAINER_CATEGORY_ID = ObjectId::FromLiteral("5795f317245977243854e041");
+
+    static bool IsModSlot(std::string_view slot)
+    {
+        return slot.substr(0, 4) == "mod_";
+    }
+
+    static ObjectId GetObjectId(const json& object, const char* key)
+    {
+        auto id = ObjectId();
+        auto it = object.find(key);
+        if (it != object.end() && it->is_string())
+        {
+            ObjectId::TryParse(it->get_ref<const std::string&>(), id);
+        }
+        return id;
+    }
+
+    ContainerIndex::ContainerIndex(std::shared_ptr <const json> items, std::shared_ptr <const Inventory> inventory) :
+        m_pkItems(std::move(items)), m_pkInventory(std::move(inventory))
+    {
+    }
+
+    bool ContainerIndex::FindBlank(const ObjectId& root_id, int32_t item_width, int32_t item_height, GridPlacement& placement,
+        const ObjectId& schema_id, bool nested)
+    {
+        std::lock_guard <std::mutex> lock(m_pkMutex);
+
+        if (!m_pkItems || !m_pkInventory || item_width <= 0 || item_height <= 0)
+        {
+            return false;
+        }
+
+        auto root = m_pkInventory->Find(root_id);
+        if (root == Inventory::NPOS)
+        {
+            return false;
+        }
+
+        // Filters list templates or their categories, so item passes with any of its ancestors
+        auto lineage = std::vector <ObjectId>();
+        for (auto id = schema_id; !id.IsNull() && lineage.size() < MAX_TEMPLATE_DEPTH;)
+        {
+            lineage.emplace_back(id);
+
+            auto info = FindTemplate(id);
+            if (!info)
+            {
+                break;
+            }
+            id = info->parent_id;
+        }
+
+        return FindBlankIn(root, item_width, item_height, lineage, nested, placement);
+    }
+
+    bool ContainerIndex::PlanDefrag(const ObjectId& container_id, int32_t item_width, int32_t item_height, size_t max_moves, DefragPlan& plan)
+    {
+        std::lock_guard <std::mutex> lock(m_pkMutex);
+
+        if (!m_pkItems || !m_pkInventory)
+        {
+            return false;
+        }
+
+        auto container = m_pkInventory->Find(container_id);
+        if (container == Inventory::NPOS)
+        {
+            return false;
+        }
+
+        auto found = false;
+        for (const auto& grid : GetGrids(container))
+        {
+            auto planner = DefragPlanner{ grid.cells.GetWidth(), grid.cells.GetHeight() };
+            for (auto child : m_pkInventory->GetChildren(container_id, grid.name))
+            {
+                const auto& location = m_pkInventory->GetLocation(child);
+                auto [child_width, child_height] = GetItemSize(child);
+                if (location.in_grid && child_width > 0)
+                {
+                    planner.AddItem(m_pkInventory->GetId(child), location, child_width, child_height);
+                }
+            }
+
+            // Later grids only replace a plan with more moves
+            auto grid_plan = DefragPlan();
+            if (planner.Plan(item_width, item_height, found ? plan.moves.size() - 1 : max_moves, grid_plan) &&
+                (!found || grid_plan.moves.size() < plan.moves.size()))
+            {
+                grid_plan.grid = grid.name;
+                plan = std::move(grid_plan);
+                found = true;
+
+                if (plan.moves.empty())
+                {
+                    break;
+                }
+            }
+        }
+        return found;
+    }
+
+    bool ContainerIndex::GetItemSize(const ObjectId& item_id, int32_t& width, int32_t& height)
+    {
+        std::lock_guard <std::mutex> lock(m_pkMutex);
+
+        if (!m_pkItems || !m_pkInventory)
+        {
+            return false;
+        }
+
+        auto index = m_pkInventory->Find(item_id);
+        if (index == Inventory::NPOS)
+        {
+            return false;
+        }
+
+        std::tie(width, height) = GetItemSize(index);
+        return width > 0;
+    }
+
+    void ContainerIndex::Update(std::shared_ptr <const Inventory> inventory, const std::vector <ObjectId>& touched)
+    {
+        std::lock_guard <std::mutex> lock(m_pkMutex);
+
+        m_pkInventory = std::move(inventory);
+        for (const auto& id : touched)
+        {
+            m_pkGrids.erase(id);
+            m_pkSizes.erase(id);
+
+            // Size changes up to the item mods are attached to, grid holding that one has to be rebuilt
+            auto index = m_pkInventory->Find(id);
+            while (index != Inventory::NPOS && IsModSlot(m_pkInventory->GetSlot(index)))
+            {
+                index = m_pkInventory->Find(m_pkInventory->GetParent(index));
+                if (index != Inventory::NPOS)
+                {
+                    m_pkSizes.erase(m_pkInventory->GetId(index));
+                }
+            }
+
+            if (index != Inventory::NPOS)
+            {
+                m_pkGrids.erase(m_pkInventory->GetParent(index));
+            }
+        }
+    }
+
+    size_t ContainerIndex::GetCachedContainerCount() const
+    {
+        std::lock_guard <std::mutex> lock(m_pkMutex);
+
+        return m_pkGrids.size();
+    }
+
+    const std::shared_ptr <const json>& ContainerIndex::GetItems() const
+    {
+        return m_pkItems;
+    }
+
+    std::shared_ptr <const Inventory> ContainerIndex::GetInventory() const
+    {
+        std::lock_guard <std::mutex> lock(m_pkMutex);
+
+        return m_pkInventory;
+    }
+
+    const ContainerIndex::TemplateInfo* ContainerIndex::FindTemplate(const ObjectId& schema_id)
+    {
+        auto it = m_pkTemplates.find(schema_id);
+        if (it != m_pkTemplates.end())
+        {
+            return &it->second;
+        }
+
+        auto data = m_pkItems->find(schema_id.ToString());
+        if (data == m_pkItems->end() || !data->is_object())
+        {
+            return nullptr;
+        }
+
+        auto info = TemplateInfo();
+        info.parent_id = GetObjectId(*data, "_parent");
+
+        auto props = data->find("_props");
+        if (props != data->end() && props->is_object())
+        {
+            info.width = props->value("Width", 1);
+            info.height = props->value("Height", 1);
+
+            info.extra_left = props->value("ExtraSizeLeft", 0);
+            info.extra_right = props->value("ExtraSizeRight", 0);
+            info.extra_up = props->value("ExtraSizeUp", 0);
+            info.extra_down = props->value("ExtraSizeDown", 0);
+            info.extra_force_add = props->value("ExtraSizeForceAdd", false);
+
+            info.foldable = props->value("Foldable", false);
+            info.folded_slot = props->value("FoldedSlot", std::string());
+            info.size_reduce_right = props->value("SizeReduceRight", 0);
+
+            auto grids = props->find("Grids");
+            if (grids != props->end() && grids->is_array() && !grids->empty())
+            {
+                info.grids = &*grids;
+            }
+        }
+        return &m_pkTemplates.emplace(schema_id, info).first->second;
+    }
+
+    const std::vector <ContainerIndex::ContainerGrid>& ContainerIndex::GetGrids(uint32_t index)
+    {
+        const auto& container_id = m_pkInventory->GetId(index);
+
+        auto it = m_pkGrids.find(container_id);
+        if (it != m_pkGrids.end())
+        {
+            return it->second;
+        }
+
+        auto grids = std::vector <ContainerGrid>();
+
+        auto info = FindTemplate(m_pkInventory->GetTemplate(index));
+        if (info && info->grids)
+        {
+            for (const auto& grid : *info->grids)
+            {
+                auto props = grid.find("_props");
+                if (!grid.is_object() || props == grid.end() || !props->is_object())
+                {
+                    continue;
+                }
+
+                auto width = props->value("cellsH", 0);
+                auto height = props->value("cellsV", 0);
+                if (width <= 0 || width > StashHelper::MAX_WIDTH || height <= 0)
+                {
+                    continue;
+                }
+
+                auto filters = props->find("filters");
+                grids.emplace_back(ContainerGrid{
+                    grid.value("_name", std::string()),
+                    StashHelper{ width, height },
+                    (filters != props->end() && filters->is_array()) ? &*filters : nullptr
+                });
+
+                auto& cells = grids.back().cells;
+                for (auto child : m_pkInventory->GetChildren(container_id, grids.back().name))
+                {
+                    const auto& location = m_pkInventory->GetLocation(child);
+                    if (!location.in_grid)
+                    {
+                        continue;
+                    }
+
+                    auto [child_width, child_height] = GetItemSize(child);
+                    if (location.rotated)
+                        std::swap(child_width, child_height);
+
+                    cells.Put(cells.GetStashPos(location.x, location.y), child_width, child_height);
+                }
+            }
+        }
+
+        return m_pkGrids.emplace(container_id, std::move(grids)).first->second;
+    }
+
+    std::pair <int32_t, int32_t> ContainerIndex::GetItemSize(uint32_t index)
+    {
+        const auto& item_id = m_pkInventory->GetId(index);
+
+        auto it = m_pkSizes.find(item_id);
+        if (it != m_pkSizes.end())
+        {
+            return it->second;
+        }
+
+        auto info = FindTemplate(m_pkInventory->GetTemplate(index));
+        if (!info)
+        {
+            return std::make_pair(0, 0);
+        }
+
+        const auto folded = m_pkInventory->IsFolded(index);
+
+        auto width = info->width;
+        auto height = info->height;
+        if (info->foldable && info->folded_slot.empty() && folded)
+        {
+            width -= info->size_reduce_right;
+        }
+
+        int32_t left = 0, right = 0, up = 0, down = 0;
+        int32_t forced_left = 0, forced_right = 0, forced_up = 0, forced_down = 0;
+
+        // Only mods count, e.g. cartridges in a magazine or contents of a container don't
+        auto pending = std::vector <uint32_t>{ index };
+        const auto is_container = info->parent_id == BACKPACK_CATEGORY_ID || info->parent_id == SEARCHABLE_CATEGORY_ID || info->parent_id == SIMPLE_CONTAINER_CATEGORY_ID;
+        while (!is_container && !pending.empty())
+        {
+            auto parent = pending.back();
+            pending.pop_back();
+
+            for (auto child : m_pkInventory->GetChildren(m_pkInventory->GetId(parent)))
+            {
+                auto slot = m_pkInventory->GetSlot(child);
+                if (!IsModSlot(slot))
+                {
+                    continue;
+                }
+                pending.emplace_back(child);
+
+                auto child_info = FindTemplate(m_pkInventory->GetTemplate(child));
+                if (!child_info)
+                {
+                    continue;
+                }
+
+                // Folded stock takes no space, mods attached to it still do
+                const auto child_folded = m_pkInventory->IsFolded(child);
+                if ((info->foldable && info->folded_slot == slot && (folded || child_folded)) ||
+                    (child_info->foldable && folded && child_folded))
+                {
+                    continue;
+                }
+
+                if (child_info->extra_force_add)
+                {
+                    forced_left += child_info->extra_left;
+                    forced_right += child_info->extra_right;
+                    forced_up += child_info->extra_up;
+                    forced_down += child_info->extra_down;
+                }
+                else
+                {
+                    left = std::max(left, child_info->extra_left);
+                    right = std::max(right, child_info->extra_right);
+                    up = std::max(up, child_info->extra_up);
+                    down = std::max(down, child_info->extra_down);
+                }
+            }
+        }
+
+        auto size = std::make_pair(width + left + right + forced_left + forced_right, height + up + down + forced_up + forced_down);
+        return m_pkSizes.emplace(item_id, size).first->second;
+    }
+
+    bool ContainerIndex::IsAllowed(const ContainerGrid& grid, const std::vector <ObjectId>& lineage) const
+    {
+        if (lineage.empty() || !grid.filters || grid.filters->empty())
+        {
+            return true;
+        }
+
+        auto contains = [&lineage](const json& list) {
+            if (!list.is_array())
+            {
+                return false;
+            }
+
+            for (const auto& entry : list)
+            {
+                auto id = ObjectId();
+                if (entry.is_string() && ObjectId::TryParse(entry.get_ref<const std::string&>(), id) &&
+                    std::find(lineage.begin(), lineage.end(), id) != lineage.end())
+                {
+                    return true;
+                }
+            }
+            return false;
+        };
+
+        for (const auto& filter : *grid.filters)
+        {
+            if (!filter.is_object())
+            {
+                continue;
+            }
+
+            auto allowed = filter.find("Filter");
+            auto excluded = filter.find("ExcludedFilter");
+            if (allowed != filter.end() && contains(*allowed) && (excluded == filter.end() || !contains(*excluded)))
+            {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    bool ContainerIndex::FindBlankIn(uint32_t index, int32_t item_width, int32_t item_height, const std::vector <ObjectId>& lineage, bool nested, GridPlacement& placement)
+    {
+        const auto& container_id = m_pkInventory->GetId(index);
+
+        for (const auto& grid : GetGrids(index))
+        {
+            if (!IsAllowed(grid, lineage))
+            {
+                continue;
+            }
+
+            auto rotated = false;
+            auto pos = grid.cells.FindBlank(item_width, item_height, rotated);
+            if (pos != -1)
+            {
+                const auto width = grid.cells.GetWidth();
+                placement = GridPlacement{ container_id, grid.name, ItemLocation{ (pos - 1) % width, (pos - 1) / width, rotated, true } };
+                return true;
+            }
+        }
+
+        if (!nested)
+        {
+            return false;
+        }
+
+        for (auto child : m_pkInventory->GetChildren(container_id))
+        {
+            if (FindBlankIn(child, item_width, item_height, lineage, true, placement))
+            {
+                return true;
+            }
+        }
+        return false;
+    }
+};
@@ -0,0 +1,100 @@
+#pragma once
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+
+#include <json.hpp>
+
+#include "ObjectId.hpp"
+#include "Inventory.hpp"
+#include "StashHelper.hpp"
+#include "DefragPlanner.hpp"
+
+namespace TarkovAPI
+{
+	using json = nlohmann::json;
+
+	struct GridPlacement
+	{
+		ObjectId container_id;
+		std::string grid; // _name of grid, slotId of item put there
+		ItemLocation location;
+	};
+
+	// Occupancy of container grids (stash, backpacks, rigs, cases) of one inventory, sizes come from _props.Grids of templates
+	// Items take their assembled size, base size of template grown by attached mods and shrunk when folded
+	// Grids and sizes are built on first use and kept until a change touches them, see Update
+	// Holds items DB and inventory snapshots it was built from; calls are serialized
+	class ContainerIndex
+	{
+	public:
+		ContainerIndex(std::shared_ptr <const json> items, std::shared_ptr <const Inventory> inventory);
+		virtual ~ContainerIndex() = default;
+
+		ContainerIndex(const ContainerIndex&) = delete;
+		ContainerIndex& operator=(const ContainerIndex&) = delete;
+
+		// First free cell under root: grids of root first, then nested containers depth first in inventory order
+		// Item may be turned; grid filters are checked when schema_id is not null; false when it fits nowhere
+		bool FindBlank(const ObjectId& root_id, int32_t item_width, int32_t item_height, GridPlacement& placement,
+			const ObjectId& schema_id = ObjectId(), bool nested = true);
+
+		// Fewest moves freeing an area in one of container's grids, see DefragPlanner; false when there is none within max_moves
+		bool PlanDefrag(const ObjectId& container_id, int32_t item_width, int32_t item_height, size_t max_moves, DefragPlan& plan);
+
+		// Assembled size of an item as it is placed unrotated; false when item or its template is unknown
+		bool GetItemSize(const ObjectId& item_id, int32_t& width, int32_t& height);
+
+		// Moves to a newer state of same inventory; touched items, items they are attached to and grids holding those are rebuilt
+		void Update(std::shared_ptr <const Inventory> inventory, const std::vector <ObjectId>& touched);
+
+		size_t GetCachedContainerCount() const;
+		const std::shared_ptr <const json>& GetItems() const;
+		std::shared_ptr <const Inventory> GetInventory() const;
+
+	protected:
+		struct TemplateInfo
+		{
+			ObjectId parent_id;
+			int32_t width{ 1 };
+			int32_t height{ 1 };
+			const json* grids{ nullptr }; // _props.Grids, null when template is no container
+
+			// Cells a mod adds around the item it is attached to, largest per side wins unless forced ones add up
+			int32_t extra_left{ 0 };
+			int32_t extra_right{ 0 };
+			int32_t extra_up{ 0 };
+			int32_t extra_down{ 0 };
+			bool extra_force_add{ false };
+
+			bool foldable{ false };
+			std::string folded_slot; // mod slot which folds, empty when item folds itself
+			int32_t size_reduce_right{ 0 };
+		};
+
+		struct ContainerGrid
+		{
+			std::string name;
+			StashHelper cells;
+			const json* filters; // _props.filters of grid
+		};
+
+		const TemplateInfo* FindTemplate(const ObjectId& schema_id); // nullptr when unknown
+		const std::vector <ContainerGrid>& GetGrids(uint32_t index);
+		std::pair <int32_t, int32_t> GetItemSize(uint32_t index); // 0x0 when template is unknown
+		bool IsAllowed(const ContainerGrid& grid, const std::vector <ObjectId>& lineage) const;
+		bool FindBlankIn(uint32_t index, int32_t item_width, int32_t item_height, const std::vector <ObjectId>& lineage, bool nested, GridPlacement& placement);
+
+	private:
+		mutable std::mutex m_pkMutex;
+		std::shared_ptr <const json> m_pkItems;
+		std::shared_ptr <const Inventory> m_pkInventory;
+
+		std::unordered_map <ObjectId /* _tpl */, TemplateInfo> m_pkTemplates;
+		std::unordered_map <ObjectId /* container_id */, std::vector <ContainerGrid>> m_pkGrids;
+		std::unordered_map <ObjectId /* item_id */, std::pair <int32_t, int32_t> /* width, height */> m_pkSizes;
+	};
+};
@@ -0,0 +1,158 @@
+#include "DefragPlanner.hpp"
+
+#include <algorithm>
+#include <tuple>
+
+namespace TarkovAPI
+{
+    DefragPlanner::DefragPlanner(int32_t width, int32_t height) :
+        m_nWidth(width), m_nHeight(height)
+    {
+        if (width <= 0 || width > StashHelper::MAX_WIDTH || height <= 0)
+        {
+            throw TarkovAPIException(Error::InvalidParameter, fmt::format("Grid size: {}x{}", width, height));
+        }
+    }
+
+    bool DefragPlanner::AddItem(const ObjectId& item_id, const ItemLocation& location, int32_t width, int32_t height)
+    {
+        if (location.rotated)
+            std::swap(width, height);
+
+        if (width <= 0 || height <= 0 || location.x < 0 || location.y < 0 ||
+            location.x + width > m_nWidth || location.y + height > m_nHeight)
+        {
+            return false;
+        }
+
+        m_vItems.emplace_back(GridItem{ item_id, location.x, location.y, width, height, location.rotated });
+        return true;
+    }
+
+    bool DefragPlanner::Plan(int32_t item_width, int32_t item_height, size_t max_moves, DefragPlan& plan, size_t search_nodes) const
+    {
+        if (item_width <= 0 || item_height <= 0)
+        {
+            return false;
+        }
+
+        auto candidates = std::vector <Candidate>();
+        FindCandidates(item_width, item_height, false, max_moves, candidates);
+        if (item_width != item_height)
+        {
+            FindCandidates(item_height, item_width, true, max_moves, candidates);
+        }
+
+        // Fewest moves first, then least to move, then earliest position like StashHelper::FindBlank
+        std::sort(candidates.begin(), candidates.end(), [](const Candidate& lhs, const Candidate& rhs) {
+            return std::make_tuple(lhs.blockers.size(), lhs.blocked_area, lhs.y, lhs.x, lhs.rotated) <
+                std::make_tuple(rhs.blockers.size(), rhs.blocked_area, rhs.y, rhs.x, rhs.rotated);
+        });
+
+        auto cells = StashHelper{ m_nWidth, m_nHeight };
+        for (const auto& item : m_vItems)
+        {
+            cells.Put(cells.GetStashPos(item.x, item.y), item.width, item.height);
+        }
+
+        auto moves = std::vector <DefragMove>();
+        for (auto& candidate : candidates)
+        {
+            const auto width = candidate.rotated ? item_height : item_width;
+            const auto height = candidate.rotated ? item_width : item_height;
+            const auto target_pos = cells.GetStashPos(candidate.x, candidate.y);
+
+            // Largest blockers have fewest places to go, they are placed first
+            std::stable_sort(candidate.blockers.begin(), candidate.blockers.end(), [this](uint32_t lhs, uint32_t rhs) {
+                return m_vItems[lhs].width * m_vItems[lhs].height > m_vItems[rhs].width * m_vItems[rhs].height;
+            });
+
+            // Current cells of blockers stay taken as well, nothing has to move before another item can
+            auto search = cells;
+            search.Put(target_pos, width, height);
+
+            auto budget = search_nodes;
+            moves.clear();
+            if (Relocate(search, candidate.blockers, 0, moves, budget))
+            {
+                plan.target = ItemLocation{ candidate.x, candidate.y, candidate.rotated, true };
+                plan.moves = std::move(moves);
+                return true;
+            }
+        }
+        return false;
+    }
+
+    void DefragPlanner::FindCandidates(int32_t item_width, int32_t item_height, bool rotated, size_t max_moves, std::vector <Candidate>& candidates) const
+    {
+        for (auto y = 0; y + item_height <= m_nHeight; ++y)
+        {
+            for (auto x = 0; x + item_width <= m_nWidth; ++x)
+            {
+                auto candidate = Candidate{ x, y, rotated, 0, {} };
+                for (uint32_t i = 0; i < m_vItems.size() && candidate.blockers.size() <= max_moves; ++i)
+                {
+                    const auto& item = m_vItems[i];
+                    if (item.x < x + item_width && x < item.x + item.width && item.y < y + item_height && y < item.y + item.height)
+                    {
+                        candidate.blockers.emplace_back(i);
+                        candidate.blocked_area += item.width * item.height;
+                    }
+                }
+
+                if (candidate.blockers.size() <= max_moves)
+                {
+                    candidates.emplace_back(std::move(candidate));
+                }
+            }
+        }
+    }
+
+    bool DefragPlanner::Relocate(StashHelper& cells, const std::vector <uint32_t>& blockers, size_t next, std::vector <DefragMove>& moves, size_t& budget) const
+    {
+        if (next == blockers.size())
+        {
+            return true;
+        }
+
+        const auto& item = m_vItems[blockers[next]];
+        for (auto turned : { false, true })
+        {
+            if (turned && item.width == item.height)
+            {
+                continue;
+            }
+
+            const auto width = turned ? item.height : item.width;
+            const auto height = turned ? item.width : item.height;
+
+            for (auto row = 0; row + height <= m_nHeight; ++row)
+            {
+                for (auto fits = cells.FindBlankInRow(row, width, height); fits; fits &= fits - 1)
+                {
+                    if (budget == 0)
+                    {
+                        return false;
+                    }
+                    --budget;
+
+                    auto x = StashHelper::CountTrailingZeros(fits);
+                    auto pos = cells.GetStashPos(x, row);
+
+                    // Orientation is absolute, turning a rotated item back makes it unrotated
+                    cells.Put(pos, width, height);
+                    moves.emplace_back(DefragMove{ item.id, ItemLocation{ x, row, item.rotated != turned, true } });
+
+                    if (Relocate(cells, blockers, next + 1, moves, budget))
+                    {
+                        return true;
+                    }
+
+                    moves.pop_back();
+                    cells.Clear(pos, width, height);
+                }
+            }
+        }
+        return false;
+    }
+};
@@ -0,0 +1,69 @@
+#pragma once
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "ObjectId.hpp"
+#include "Inventory.hpp"
+#include "StashHelper.hpp"
+
+namespace TarkovAPI
+{
+	struct DefragMove
+	{
+		ObjectId item_id;
+		ItemLocation location; // rotated is orientation after move
+	};
+
+	struct DefragPlan
+	{
+		std::string grid; // set by ContainerIndex::PlanDefrag
+		ItemLocation target; // free area for item, rotated when it has to be turned
+		std::vector <DefragMove> moves;
+	};
+
+	// Fewest moves which free an area for an item in a fragmented grid
+	// Candidate areas are tried with fewest blocking items first, blockers are relocated by a depth first search over bitboards
+	// Blockers only go to cells which were free before and stay free, so moves don't depend on each other's order
+	class DefragPlanner
+	{
+	public:
+		static constexpr size_t DEFAULT_SEARCH_NODES = 4096; // placements tried per candidate area
+
+	public:
+		DefragPlanner(int32_t width, int32_t height);
+
+		// Size of template, location.rotated turns it; false when item is not inside the grid
+		bool AddItem(const ObjectId& item_id, const ItemLocation& location, int32_t width, int32_t height);
+
+		// False when no area can be freed with up to max_moves moves within search bound
+		bool Plan(int32_t item_width, int32_t item_height, size_t max_moves, DefragPlan& plan, size_t search_nodes = DEFAULT_SEARCH_NODES) const;
+
+	protected:
+		struct GridItem
+		{
+			ObjectId id;
+			int32_t x;
+			int32_t y;
+			int32_t width; // as placed
+			int32_t height;
+			bool rotated;
+		};
+
+		struct Candidate
+		{
+			int32_t x;
+			int32_t y;
+			bool rotated;
+			int32_t blocked_area;
+			std::vector <uint32_t> blockers;
+		};
+
+		void FindCandidates(int32_t item_width, int32_t item_height, bool rotated, size_t max_moves, std::vector <Candidate>& candidates) const;
+		bool Relocate(StashHelper& cells, const std::vector <uint32_t>& blockers, size_t next, std::vector <DefragMove>& moves, size_t& budget) const;
+
+	private:
+		int32_t m_nWidth, m_nHeight;
+		std::vector <GridItem> m_vItems;
+	};
+};
@@ -91,6 +91,26 @@ public:
 			return fmt::format("Item: '{}' data is not found on database!", error_desc);
 		} break;
 
+		case TarkovAPI::Error::CaptureFailed:
+		{
+			return fmt::format("Traffic capture could not processed: {}", error_desc);
+		} break;
+
+		case TarkovAPI::Error::ReplayNotFound:
+		{
+			return fmt::format("Request: '{}' is not found on replay capture!", error_desc);
+		} break;
+
+		case TarkovAPI::Error::InvalidObjectId:
+		{
+			return fmt::format("Object id: '{}' is not 24 hex characters!", error_desc);
+		} break;
+
+		case TarkovAPI::Error::NoStashSpace:
+		{
+			return fmt::format("No free space in stash for an item of size: {}", error_desc);
+		} break;
+
 		default:
 			return fmt::format("Unknown error ID: {}", error_id);
 		}
@@ -0,0 +1,200 @@
+#include "GameDataCache.hpp"
+#include <cstdio>
+#include <cctype>
+#include <cstdlib>
+#include <fstream>
+#include <filesystem>
+#include <system_error>
+
+namespace TarkovAPI
+{
+    namespace fs = std::filesystem;
+
+    // Write aside and rename, a crash never leaves a half written file behind
+    static bool WriteFileAtomic(const std::string& path, const std::string& content)
+    {
+        auto temp_path = path + ".tmp";
+        {
+            std::ofstream file(temp_path, std::ios::binary | std::ios::trunc);
+            file.write(content.data(), static_cast<std::streamsize>(content.size()));
+            if (!file)
+            {
+                return false;
+            }
+        }
+
+        std::remove(path.c_str());
+        return std::rename(temp_path.c_str(), path.c_str()) == 0;
+    }
+
+    // Directory holds an index.json and nothing but files this class writes; anything else is left alone
+    static bool IsCacheDirectory(const fs::path& path)
+    {
+        std::error_code ec;
+        if (!fs::is_regular_file(path / "index.json", ec))
+        {
+            return false;
+        }
+
+        for (const auto& entry : fs::directory_iterator(path, ec))
+        {
+            auto name = entry.path().filename().string();
+            if (!entry.is_regular_file(ec) ||
+                (name != "index.json" && entry.path().extension() != ".data" && entry.path().extension() != ".tmp"))
+            {
+                return false;
+            }
+        }
+        return !ec;
+    }
+
+    GameDataCache::GameDataCache(const std::string& directory, const std::string& game_version) :
+        m_stDirectory((fs::path(directory) / SanitizeKey(game_version)).string())
+    {
+        std::error_code ec;
+
+        for (const auto& entry : fs::directory_iterator(directory, ec))
+        {
+            if (entry.is_directory(ec) && entry.path() != fs::path(m_stDirectory) && IsCacheDirectory(entry.path()))
+            {
+                fs::remove_all(entry.path(), ec);
+            }
+        }
+        fs::create_directories(m_stDirectory, ec);
+
+        std::ifstream file(fs::path(m_stDirectory) / "index.json");
+        if (!file)
+        {
+            WriteIndex(); // marks directory as ours even while it's empty
+            return;
+        }
+
+        auto index = json::parse(file, nullptr, false);
+        if (index.is_discarded() || !index.is_object())
+        {
+            return;
+        }
+
+        for (const auto& [key, crc] : index.items())
+        {
+            if (crc.is_number_integer() && crc.get<int64_t>())
+            {
+                m_pkIndex.emplace(key, crc.get<int64_t>());
+            }
+        }
+    }
+
+    int64_t GameDataCache::GetCrc(const std::string& key) const
+    {
+        std::lock_guard <std::mutex> lock(m_pkMutex);
+
+        auto it = m_pkIndex.find(SanitizeKey(key));
+        return (it != m_pkIndex.end()) ? it->second : 0;
+    }
+
+    bool GameDataCache::Load(const std::string& key, json& data)
+    {
+        std::ifstream file(GetDataPath(key), std::ios::binary);
+        if (file)
+        {
+            data = json::parse(file, nullptr, false);
+            if (!data.is_discarded())
+            {
+                return true;
+            }
+        }
+
+        // Data file is gone or damaged, its crc must not be sent again
+        Remove(key);
+        return false;
+    }
+
+    bool GameDataCache::Store(const std::string& key, const json& data, int64_t crc)
+    {
+        if (!crc)
+        {
+            return false;
+        }
+
+        std::lock_guard <std::mutex> lock(m_pkMutex);
+
+        auto sanitized = SanitizeKey(key);
+        if (!WriteFileAtomic(GetDataPath(sanitized), data.dump()))
+        {
+            return false;
+        }
+
+        m_pkIndex[sanitized] = crc;
+        return WriteIndex();
+    }
+
+    void GameDataCache::Remove(const std::string& key)
+    {
+        std::lock_guard <std::mutex> lock(m_pkMutex);
+
+        auto sanitized = SanitizeKey(key);
+        if (m_pkIndex.erase(sanitized))
+        {
+            WriteIndex();
+        }
+        std::remove(GetDataPath(sanitized).c_str());
+    }
+
+    size_t GameDataCache::GetEntryCount() const
+    {
+        std::lock_guard <std::mutex> lock(m_pkMutex);
+        return m_pkIndex.size();
+    }
+
+    const std::string& GameDataCache::GetDirectory() const
+    {
+        return m_stDirectory;
+    }
+
+    std::string GameDataCache::SanitizeKey(const std::string& key)
+    {
+        auto sanitized = key;
+        for (auto& c : sanitized)
+        {
+            if (!isalnum(static_cast<unsigned char>(c)) && c != '-' && c != '.')
+            {
+                c = '_';
+            }
+        }
+        return sanitized;
+    }
+
+    std::string GameDataCache::GetDefaultDirectory()
+    {
+        for (auto env : { "LOCALAPPDATA", "XDG_CACHE_HOME" })
+        {
+            auto base = std::getenv(env);
+            if (base && *base)
+            {
+                return (fs::path(base) / DATA_CACHE_DIRECTORY).string();
+            }
+        }
+
+        auto home = std::getenv("HOME");
+        if (home && *home)
+        {
+            return (fs::path(home) / ".cache" / DATA_CACHE_DIRECTORY).string();
+        }
+        return DATA_CACHE_DIRECTORY;
+    }
+
+    std::string GameDataCache::GetDataPath(const std::string& key) const
+    {
+        return (fs::path(m_stDirectory) / (SanitizeKey(key) + ".data")).string();
+    }
+
+    bool GameDataCache::WriteIndex() const
+    {
+        auto index = json::object();
+        for (const auto& [key, crc] : m_pkIndex)
+        {
+            index[key] = crc;
+        }
+        return WriteFileAtomic((fs::path(m_stDirectory) / "index.json").string(), index.dump());
+    }
+};
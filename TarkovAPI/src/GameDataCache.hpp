@@ -0,0 +1,51 @@
+#pragma once
+#include <cstdint>
+#include <string>
+#include <map>
+#include <mutex>
+
+#include <json.hpp>
+
+namespace TarkovAPI
+{
+	using json = nlohmann::json;
+
+	static constexpr auto DATA_CACHE_ENV = "TARKOVAPI_DATA_CACHE";
+	static constexpr auto DATA_CACHE_DIRECTORY = "TarkovAPI.cache"; // under per-user cache location, see GetDefaultDirectory
+
+	// Items, prices, locations and locales as last served by the backend, together with their server crc
+	// Layout
+	//  <directory>/<game version>/<key>.data : json data of a payload
+	//  <directory>/<game version>/index.json : key -> crc, an entry is only written after its data file
+	// Directories of other game versions are removed on construction, only ones holding an index.json and cache files
+	class GameDataCache
+	{
+	public:
+		GameDataCache(const std::string& directory, const std::string& game_version);
+		virtual ~GameDataCache() = default;
+
+		GameDataCache(const GameDataCache&) = delete;
+		GameDataCache& operator=(const GameDataCache&) = delete;
+
+		int64_t GetCrc(const std::string& key) const; // 0 when key is not cached
+		bool Load(const std::string& key, json& data);
+		bool Store(const std::string& key, const json& data, int64_t crc);
+		void Remove(const std::string& key);
+
+		size_t GetEntryCount() const;
+		const std::string& GetDirectory() const;
+
+		static std::string SanitizeKey(const std::string& key);
+		// %LOCALAPPDATA%/TarkovAPI.cache, $XDG_CACHE_HOME or $HOME/.cache elsewhere; relative to working directory when none is set
+		static std::string GetDefaultDirectory();
+
+	protected:
+		std::string GetDataPath(const std::string& key) const;
+		bool WriteIndex() const; // m_pkMutex must be held
+
+	private:
+		mutable std::mutex m_pkMutex;
+		std::string m_stDirectory;
+		std::map <std::string /* key */, int64_t /* crc */> m_pkIndex;
+	};
+};
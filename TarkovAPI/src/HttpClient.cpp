@@ -0,0 +1,532 @@
+#include "HttpClient.hpp"
+#include "Inflater.hpp"
+#include "Constants.hpp"
+#include "Exception.hpp"
+#include "Trace.hpp"
+#include <cassert>
+#include <istream>
+#include <streambuf>
+
+namespace TarkovAPI
+{
+    // Pulls compressed data from running transfer on demand and exposes inflated bytes to JSON parser
+    class InflateStreamBuf : public std::streambuf
+    {
+    public:
+        explicit InflateStreamBuf(HttpClient* client) :
+            m_pkClient(client)
+        {
+        }
+
+    protected:
+        int_type underflow() override
+        {
+            if (gptr() < egptr())
+            {
+                return traits_type::to_int_type(*gptr());
+            }
+
+            while (!m_kInflater.IsFinished())
+            {
+                if (m_kInflater.NeedsInput())
+                {
+                    auto& pending = m_pkClient->m_stPending;
+                    if (m_bInputFed)
+                    {
+                        pending.clear();
+                        m_bInputFed = false;
+                    }
+
+                    while (pending.empty() && m_pkClient->PumpTransfer())
+                        ;
+
+                    if (pending.empty())
+                    {
+                        m_pkClient->CheckTransferResult();
+                        m_kInflater.Finish(); // throws, body is truncated
+                    }
+
+                    m_kInflater.SetInput(pending.data(), pending.size());
+                    m_bInputFed = true;
+                }
+
+                auto written = size_t(0);
+                {
+                    ScopedTimer timer(m_pkClient->m_kTransfer.inflate_us);
+                    TRACE_SCOPE("Inflate");
+                    written = m_kInflater.Read(m_szBuffer, sizeof(m_szBuffer));
+                }
+                if (written)
+                {
+                    setg(m_szBuffer, m_szBuffer, m_szBuffer + written);
+                    return traits_type::to_int_type(*gptr());
+                }
+            }
+            return traits_type::eof();
+        }
+
+    public:
+        uint64_t GetTotalOut() const
+        {
+            return m_kInflater.GetTotalOut();
+        }
+
+    private:
+        HttpClient* m_pkClient;
+        ZlibInflater m_kInflater;
+        bool m_bInputFed{ false };
+        char m_szBuffer[INFLATE_CHUNK_SIZE];
+    };
+
+
+    HttpClient::HttpClient()
+    {
+        m_pkHandle = curl_easy_init();
+        m_pkMulti = curl_multi_init();
+
+        if (!m_pkHandle || !m_pkMulti)
+        {
+            throw TarkovAPIException(Error::CprSessionFailed);
+        }
+
+        ApplyConnectionOptions(m_pkHandle);
+
+        curl_multi_setopt(m_pkMulti, CURLMOPT_PIPELINING, static_cast<long>(CURLPIPE_MULTIPLEX));
+    }
+    HttpClient::~HttpClient()
+    {
+        if (m_pkMulti)
+        {
+            curl_multi_cleanup(m_pkMulti);
+            m_pkMulti = nullptr;
+        }
+        if (m_pkHandle)
+        {
+            curl_easy_cleanup(m_pkHandle);
+            m_pkHandle = nullptr;
+        }
+    }
+
+    void HttpClient::ApplyConnectionOptions(CURL* handle)
+    {
+        // Prefer HTTP/2 over TLS and multiplex on one connection when server supports it, otherwise keep HTTP/1.1 connection alive
+        curl_easy_setopt(handle, CURLOPT_HTTP_VERSION, static_cast<long>(CURL_HTTP_VERSION_2TLS));
+        curl_easy_setopt(handle, CURLOPT_PIPEWAIT, 1L);
+        curl_easy_setopt(handle, CURLOPT_TCP_KEEPALIVE, 1L);
+        curl_easy_setopt(handle, CURLOPT_TCP_KEEPIDLE, 60L);
+        curl_easy_setopt(handle, CURLOPT_TCP_KEEPINTVL, 30L);
+        curl_easy_setopt(handle, CURLOPT_FOLLOWLOCATION, 1L);
+        curl_easy_setopt(handle, CURLOPT_NOSIGNAL, 1L);
+    }
+
+    curl_slist* HttpClient::BuildHeaderList(const cpr::Header& headers)
+    {
+        curl_slist* header_list = nullptr;
+        for (const auto& [key, value] : headers)
+        {
+            header_list = curl_slist_append(header_list, fmt::format("{}: {}", key, value).c_str());
+        }
+        return header_list;
+    }
+
+    size_t HttpClient::OnWriteCallback(char* ptr, size_t size, size_t nmemb, void* userdata)
+    {
+        auto client = reinterpret_cast<HttpClient*>(userdata);
+        client->m_stPending.append(ptr, size * nmemb);
+        client->m_kTransfer.compressed_bytes += size * nmemb;
+        if (client->m_pkCapture)
+        {
+            client->m_stCaptured.append(ptr, size * nmemb);
+        }
+        return size * nmemb;
+    }
+
+    void HttpClient::BeginTransfer(const std::string& url, const std::string& body, curl_slist* headers)
+    {
+        m_stPending.clear();
+        m_stCaptured.clear();
+        m_kTransfer = TransferMetrics{};
+        m_bTransferDone = false;
+        m_nTransferResult = CURLE_OK;
+
+        curl_easy_setopt(m_pkHandle, CURLOPT_URL, url.c_str());
+        curl_easy_setopt(m_pkHandle, CURLOPT_POST, 1L);
+        curl_easy_setopt(m_pkHandle, CURLOPT_POSTFIELDS, body.data());
+        curl_easy_setopt(m_pkHandle, CURLOPT_POSTFIELDSIZE_LARGE, static_cast<curl_off_t>(body.size()));
+        curl_easy_setopt(m_pkHandle, CURLOPT_HTTPHEADER, headers);
+        curl_easy_setopt(m_pkHandle, CURLOPT_WRITEFUNCTION, &HttpClient::OnWriteCallback);
+        curl_easy_setopt(m_pkHandle, CURLOPT_WRITEDATA, this);
+
+        auto mc = curl_multi_add_handle(m_pkMulti, m_pkHandle);
+        if (CURLM_OK != mc)
+        {
+            throw TarkovAPIException(Error::CprApiFailed, curl_multi_strerror(mc));
+        }
+    }
+
+    bool HttpClient::PumpTransfer()
+    {
+        if (m_bTransferDone)
+        {
+            return false;
+        }
+
+        ScopedTimer timer(m_kTransfer.network_us);
+
+        auto running = 0;
+        auto mc = curl_multi_perform(m_pkMulti, &running);
+        if (CURLM_OK != mc)
+        {
+            throw TarkovAPIException(Error::CprApiFailed, curl_multi_strerror(mc));
+        }
+
+        if (!running)
+        {
+            auto msgs = 0;
+            while (auto msg = curl_multi_info_read(m_pkMulti, &msgs))
+            {
+                if (msg->msg == CURLMSG_DONE && msg->easy_handle == m_pkHandle)
+                {
+                    m_nTransferResult = msg->data.result;
+                }
+            }
+            m_bTransferDone = true;
+            return false;
+        }
+
+        if (m_stPending.empty())
+        {
+            curl_multi_wait(m_pkMulti, nullptr, 0, 1000, nullptr);
+        }
+        return true;
+    }
+
+    void HttpClient::CheckTransferResult()
+    {
+        if (m_bTransferDone && CURLE_OK != m_nTransferResult) // CURL error code
+        {
+            throw TarkovAPIException(Error::CprApiFailed, curl_easy_strerror(m_nTransferResult));
+        }
+
+        auto status_code = GetStatusCode();
+
+        switch (status_code) // HTTP status code
+        {
+        case 200: // OK
+            break;
+        default:
+            throw TarkovAPIException(Error::CprPostFailed, static_cast<int64_t>(status_code));
+        }
+    }
+
+    json HttpClient::PostJson(const std::string& url, const std::string& body, const cpr::Header& headers)
+    {
+        assert(m_pkHandle && m_pkMulti && "Null curl handle");
+
+        TRACE_SCOPE_DETAIL("HttpClient::PostJson", MetricsRegistry::NormalizePath(url));
+
+        if (m_pkReplay)
+        {
+            return ReplayJson(url, body);
+        }
+
+        auto header_list = BuildHeaderList(headers);
+
+        struct TransferGuard
+        {
+            CURLM* multi;
+            CURL* handle;
+            curl_slist* headers;
+
+            ~TransferGuard()
+            {
+                curl_multi_remove_handle(multi, handle);
+                curl_slist_free_all(headers);
+            }
+        } guard{ m_pkMulti, m_pkHandle, header_list };
+
+        BeginTransfer(url, body, header_list);
+
+        json deserialized{};
+        try
+        {
+            // Wait for first body bytes, status line must be validated before feeding parser
+            {
+                TRACE_SCOPE("Await response");
+                while (m_stPending.empty() && PumpTransfer())
+                    ;
+            }
+            CheckTransferResult();
+
+            deserialized = ParseBody();
+
+            while (PumpTransfer())
+                ;
+            CheckTransferResult();
+        }
+        catch (...)
+        {
+            CaptureTransfer(url, body, headers); // failures are replayed too
+            throw;
+        }
+
+        CaptureTransfer(url, body, headers);
+        UpdateConnectionStats();
+
+        return deserialized;
+    }
+
+    bool HttpClient::Prewarm(const std::string& url)
+    {
+        assert(m_pkHandle && m_pkMulti && "Null curl handle");
+
+        TRACE_SCOPE_DETAIL("HttpClient::Prewarm", HttpClientPool::GetHostKey(url));
+
+        if (m_pkReplay)
+        {
+            return true;
+        }
+
+        struct PrewarmGuard
+        {
+            CURLM* multi;
+            CURL* handle;
+
+            ~PrewarmGuard()
+            {
+                curl_multi_remove_handle(multi, handle);
+                curl_easy_setopt(handle, CURLOPT_NOBODY, 0L);
+            }
+        } guard{ m_pkMulti, m_pkHandle };
+
+        m_stPending.clear();
+        m_bTransferDone = false;
+        m_nTransferResult = CURLE_OK;
+
+        curl_easy_setopt(m_pkHandle, CURLOPT_URL, url.c_str());
+        curl_easy_setopt(m_pkHandle, CURLOPT_NOBODY, 1L);
+        curl_easy_setopt(m_pkHandle, CURLOPT_HTTPHEADER, nullptr);
+        curl_easy_setopt(m_pkHandle, CURLOPT_WRITEFUNCTION, &HttpClient::OnWriteCallback);
+        curl_easy_setopt(m_pkHandle, CURLOPT_WRITEDATA, this);
+
+        if (CURLM_OK != curl_multi_add_handle(m_pkMulti, m_pkHandle))
+        {
+            return false;
+        }
+
+        try
+        {
+            while (PumpTransfer())
+                ;
+        }
+        catch (const TarkovAPIException&)
+        {
+            return false;
+        }
+
+        // Any HTTP status is fine, only the connection matters
+        if (CURLE_OK != m_nTransferResult)
+        {
+            return false;
+        }
+
+        UpdateConnectionStats();
+        return true;
+    }
+
+    void HttpClient::SetCapture(TrafficCapture* capture)
+    {
+        m_pkCapture = capture;
+    }
+
+    void HttpClient::SetReplay(TrafficReplay* replay)
+    {
+        m_pkReplay = replay;
+    }
+
+    long HttpClient::GetStatusCode() const
+    {
+        if (m_pkReplay)
+        {
+            return m_nReplayStatus;
+        }
+
+        auto status_code = 0L;
+        curl_easy_getinfo(m_pkHandle, CURLINFO_RESPONSE_CODE, &status_code);
+        return status_code;
+    }
+
+    // Captured body goes through the same streaming inflate and parse as live responses
+    json HttpClient::ReplayJson(const std::string& url, const std::string& body)
+    {
+        const auto& record = m_pkReplay->Find(url, body);
+
+        m_stPending = record.response;
+        m_bTransferDone = true;
+        m_nTransferResult = CURLE_OK;
+        m_nReplayStatus = record.status;
+
+        m_kTransfer = TransferMetrics{};
+        m_kTransfer.compressed_bytes = record.response.size();
+
+        CheckTransferResult();
+
+        return ParseBody();
+    }
+
+    // Parse time excludes network waits and inflate done on behalf of the parser
+    json HttpClient::ParseBody()
+    {
+        TRACE_FUNCTION();
+
+        InflateStreamBuf stream_buf(this);
+        std::istream stream(&stream_buf);
+
+        auto nested_before = m_kTransfer.network_us + m_kTransfer.inflate_us;
+        auto elapsed_us = uint64_t(0);
+
+        json deserialized{};
+        {
+            ScopedTimer timer(elapsed_us);
+            deserialized = json::parse(stream);
+        }
+
+        auto nested_us = m_kTransfer.network_us + m_kTransfer.inflate_us - nested_before;
+        m_kTransfer.parse_us += (elapsed_us > nested_us) ? elapsed_us - nested_us : 0;
+        m_kTransfer.decompressed_bytes = stream_buf.GetTotalOut();
+
+        return deserialized;
+    }
+
+    const TransferMetrics& HttpClient::GetLastTransfer() const
+    {
+        return m_kTransfer;
+    }
+
+    void HttpClient::CaptureTransfer(const std::string& url, const std::string& body, const cpr::Header& headers)
+    {
+        if (!m_pkCapture)
+        {
+            return;
+        }
+
+        try
+        {
+            while (PumpTransfer())
+                ;
+        }
+        catch (...)
+        {
+            // Partial body is captured as it is
+        }
+
+        m_pkCapture->Append(url, body, headers, static_cast<int32_t>(GetStatusCode()), m_stCaptured);
+        m_stCaptured.clear();
+    }
+
+    void HttpClient::UpdateConnectionStats()
+    {
+        auto num_connects = 0L;
+        curl_off_t connect_time = 0, app_connect_time = 0;
+
+        curl_easy_getinfo(m_pkHandle, CURLINFO_NUM_CONNECTS, &num_connects);
+        curl_easy_getinfo(m_pkHandle, CURLINFO_CONNECT_TIME_T, &connect_time);
+        curl_easy_getinfo(m_pkHandle, CURLINFO_APPCONNECT_TIME_T, &app_connect_time);
+
+        m_kStats.requests++;
+
+        if (!num_connects)
+        {
+            m_kStats.reused++;
+            return;
+        }
+
+        m_kStats.new_connections += static_cast<uint64_t>(num_connects);
+        if (app_connect_time > 0)
+        {
+            m_kStats.handshakes++;
+            m_kStats.handshake_time_us += static_cast<uint64_t>(app_connect_time - connect_time);
+        }
+    }
+
+    ConnectionStats HttpClient::GetStats() const
+    {
+        auto stats = ConnectionStats{};
+        stats.requests = m_kStats.requests;
+        stats.reused = m_kStats.reused;
+        stats.new_connections = m_kStats.new_connections;
+        stats.handshakes = m_kStats.handshakes;
+        stats.handshake_time_us = m_kStats.handshake_time_us;
+        return stats;
+    }
+
+
+    std::string HttpClientPool::GetHostKey(const std::string& url)
+    {
+        auto scheme_end = url.find("://");
+        auto host_begin = (scheme_end == std::string::npos) ? 0 : scheme_end + 3;
+
+        auto host_end = url.find_first_of("/?#", host_begin);
+        return url.substr(0, host_end);
+    }
+
+    HttpClient* HttpClientPool::Acquire(const std::string& url)
+    {
+        std::lock_guard <std::mutex> lock(m_pkMutex);
+
+        auto& client = m_pkClients[GetHostKey(url)];
+        if (!client)
+        {
+            client = std::make_unique<HttpClient>();
+            client->SetCapture(m_pkCapture.get());
+            client->SetReplay(m_pkReplay.get());
+        }
+        return client.get();
+    }
+
+    void HttpClientPool::SetCapture(std::shared_ptr <TrafficCapture> capture)
+    {
+        std::lock_guard <std::mutex> lock(m_pkMutex);
+
+        m_pkCapture = std::move(capture);
+        for (auto& [host, client] : m_pkClients)
+        {
+            client->SetCapture(m_pkCapture.get());
+        }
+    }
+
+    void HttpClientPool::SetReplay(std::shared_ptr <TrafficReplay> replay)
+    {
+        std::lock_guard <std::mutex> lock(m_pkMutex);
+
+        m_pkReplay = std::move(replay);
+        for (auto& [host, client] : m_pkClients)
+        {
+            client->SetReplay(m_pkReplay.get());
+        }
+    }
+
+    ConnectionStats HttpClientPool::GetStats() const
+    {
+        std::lock_guard <std::mutex> lock(m_pkMutex);
+
+        auto stats = ConnectionStats{};
+        for (const auto& [host, client] : m_pkClients)
+        {
+            stats += client->GetStats();
+        }
+        return stats;
+    }
+
+    std::map <std::string, ConnectionStats> HttpClientPool::GetStatsByHost() const
+    {
+        std::lock_guard <std::mutex> lock(m_pkMutex);
+
+        auto stats = std::map <std::string, ConnectionStats>();
+        for (const auto& [host, client] : m_pkClients)
+        {
+            stats.emplace(host, client->GetStats());
+        }
+        return stats;
+    }
+};
@@ -0,0 +1,137 @@
+#pragma once
+#include <cstdint>
+#include <string>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <atomic>
+
+#include <cpr/cprtypes.h>
+#include <curl/curl.h>
+#include <json.hpp>
+
+#include "TrafficCapture.hpp"
+#include "Metrics.hpp"
+
+namespace TarkovAPI
+{
+	using json = nlohmann::json;
+
+	struct ConnectionStats
+	{
+		uint64_t requests{ 0 };
+		uint64_t reused{ 0 }; // Requests served on an already open connection
+		uint64_t new_connections{ 0 };
+		uint64_t handshakes{ 0 }; // TLS handshakes
+		uint64_t handshake_time_us{ 0 };
+
+		ConnectionStats& operator+=(const ConnectionStats& other)
+		{
+			requests += other.requests;
+			reused += other.reused;
+			new_connections += other.new_connections;
+			handshakes += other.handshakes;
+			handshake_time_us += other.handshake_time_us;
+			return *this;
+		}
+	};
+
+	// Thin libcurl wrapper, response body is decompressed and parsed while it's still downloading
+	class HttpClient
+	{
+	public:
+		HttpClient();
+		virtual ~HttpClient();
+
+		HttpClient(const HttpClient&) = delete;
+		HttpClient(HttpClient&&) noexcept = delete;
+		HttpClient& operator=(const HttpClient&) = delete;
+		HttpClient& operator=(HttpClient&&) noexcept = delete;
+
+		json PostJson(const std::string& url, const std::string& body, const cpr::Header& headers);
+
+		// Resolves and connects (TLS included) to url's host with a HEAD request, so next PostJson reuses the connection
+		bool Prewarm(const std::string& url);
+
+		// Capture records every exchange, replay serves captured responses instead of network; both may be null
+		void SetCapture(TrafficCapture* capture);
+		void SetReplay(TrafficReplay* replay);
+
+		ConnectionStats GetStats() const;
+		const TransferMetrics& GetLastTransfer() const; // phases and sizes of last PostJson, also valid after it throws
+
+		static void ApplyConnectionOptions(CURL* handle);
+		static curl_slist* BuildHeaderList(const cpr::Header& headers);
+
+	protected:
+		friend class InflateStreamBuf;
+
+		static size_t OnWriteCallback(char* ptr, size_t size, size_t nmemb, void* userdata);
+
+		void BeginTransfer(const std::string& url, const std::string& body, curl_slist* headers);
+		bool PumpTransfer(); // returns false when transfer is completed
+		void CheckTransferResult();
+		void UpdateConnectionStats();
+
+		long GetStatusCode() const;
+		json ReplayJson(const std::string& url, const std::string& body);
+		void CaptureTransfer(const std::string& url, const std::string& body, const cpr::Header& headers);
+		json ParseBody();
+
+	private:
+		CURL* m_pkHandle;
+		CURLM* m_pkMulti;
+
+		std::string m_stPending; // compressed bytes received by last write callback(s)
+		bool m_bTransferDone{ false };
+		CURLcode m_nTransferResult{ CURLE_OK };
+
+		// Written by request thread, HttpClientPool::GetStats reads them from any thread
+		struct
+		{
+			std::atomic <uint64_t> requests{ 0 };
+			std::atomic <uint64_t> reused{ 0 };
+			std::atomic <uint64_t> new_connections{ 0 };
+			std::atomic <uint64_t> handshakes{ 0 };
+			std::atomic <uint64_t> handshake_time_us{ 0 };
+		} m_kStats;
+		TransferMetrics m_kTransfer;
+
+		TrafficCapture* m_pkCapture{ nullptr };
+		TrafficReplay* m_pkReplay{ nullptr };
+		std::string m_stCaptured; // whole compressed body of current transfer, capture mode only
+		long m_nReplayStatus{ 0 };
+	};
+
+	// Keeps one warm client per endpoint host, so switching between prod/trading/ragfair/launcher hosts does not drop connections
+	// Each client is not thread safe, pooled clients must be used from one thread at a time
+	class HttpClientPool
+	{
+	public:
+		HttpClientPool() = default;
+		virtual ~HttpClientPool() = default;
+
+		HttpClientPool(const HttpClientPool&) = delete;
+		HttpClientPool& operator=(const HttpClientPool&) = delete;
+
+		static constexpr uint32_t CLIENTS_PER_HOST = 1; // see RequestScheduler, requests to a host may not run concurrently beyond this
+
+		static std::string GetHostKey(const std::string& url);
+
+		HttpClient* Acquire(const std::string& url);
+
+		// Applied to current and future clients
+		void SetCapture(std::shared_ptr <TrafficCapture> capture);
+		void SetReplay(std::shared_ptr <TrafficReplay> replay);
+
+		ConnectionStats GetStats() const;
+		std::map <std::string /* host */, ConnectionStats> GetStatsByHost() const;
+
+	private:
+		mutable std::mutex m_pkMutex;
+		std::map <std::string /* host */, std::unique_ptr <HttpClient>> m_pkClients;
+
+		std::shared_ptr <TrafficCapture> m_pkCapture;
+		std::shared_ptr <TrafficReplay> m_pkReplay;
+	};
+};
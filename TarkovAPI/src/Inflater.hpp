@@ -0,0 +1,132 @@
+#pragma once
+#include "Constants.hpp"
+#include "Exception.hpp"
+
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <functional>
+
+#include <zlib.h>
+
+namespace TarkovAPI
+{
+    static constexpr auto INFLATE_CHUNK_SIZE = 16 * 1024;
+
+    // Incremental zlib decoder, compressed input can be fed piece by piece as it arrives from network
+    class ZlibInflater
+    {
+    public:
+        ZlibInflater()
+        {
+            std::memset(&m_kStream, 0, sizeof(m_kStream));
+
+            auto ret = inflateInit(&m_kStream);
+            if (Z_OK != ret)
+            {
+                throw TarkovAPIException(Error::ZlibDecompressFailed, ret);
+            }
+        }
+        ~ZlibInflater()
+        {
+            inflateEnd(&m_kStream);
+        }
+
+        ZlibInflater(const ZlibInflater&) = delete;
+        ZlibInflater& operator=(const ZlibInflater&) = delete;
+
+        // Input buffer must stay alive until NeedsInput() returns true
+        void SetInput(const void* data, size_t size)
+        {
+            m_kStream.next_in = reinterpret_cast<Bytef*>(const_cast<void*>(data));
+            m_kStream.avail_in = static_cast<uInt>(size);
+        }
+
+        bool NeedsInput() const
+        {
+            return !m_bFinished && !m_kStream.avail_in;
+        }
+        bool IsFinished() const
+        {
+            return m_bFinished;
+        }
+        uint64_t GetTotalIn() const
+        {
+            return m_kStream.total_in;
+        }
+        uint64_t GetTotalOut() const
+        {
+            return m_kStream.total_out;
+        }
+
+        // Decompress as much as fits to out buffer, returns written byte count
+        size_t Read(char* out, size_t out_size)
+        {
+            if (m_bFinished || !m_kStream.avail_in)
+            {
+                return 0;
+            }
+
+            m_kStream.next_out = reinterpret_cast<Bytef*>(out);
+            m_kStream.avail_out = static_cast<uInt>(out_size);
+
+            auto ret = inflate(&m_kStream, Z_NO_FLUSH);
+            switch (ret)
+            {
+            case Z_OK:
+                break;
+            case Z_STREAM_END:
+                m_bFinished = true;
+                break;
+            case Z_BUF_ERROR: // No progress possible, more input is required
+                break;
+            default:
+                throw TarkovAPIException(Error::ZlibDecompressFailed, ret);
+            }
+
+            return out_size - m_kStream.avail_out;
+        }
+
+        // Push style helper, decompress whole input and forward it chunk by chunk
+        void Feed(const void* data, size_t size, const std::function<void(const char*, size_t)>& sink)
+        {
+            char chunk[INFLATE_CHUNK_SIZE];
+
+            SetInput(data, size);
+            while (!NeedsInput() && !m_bFinished)
+            {
+                auto written = Read(chunk, sizeof(chunk));
+                if (written)
+                {
+                    sink(chunk, written);
+                }
+            }
+        }
+
+        // Stream must be completed when all of compressed input is consumed
+        void Finish() const
+        {
+            if (!m_bFinished)
+            {
+                throw TarkovAPIException(Error::ZlibDecompressFailed, Z_BUF_ERROR);
+            }
+        }
+
+    private:
+        z_stream m_kStream;
+        bool m_bFinished{ false };
+    };
+
+    inline std::string InflateBuffer(const void* data, size_t size)
+    {
+        auto out = std::string();
+
+        ZlibInflater inflater;
+        inflater.Feed(data, size, [&out](const char* chunk, size_t chunk_size) {
+            out.append(chunk, chunk_size);
+        });
+        inflater.Finish();
+
+        return out;
+    }
+};
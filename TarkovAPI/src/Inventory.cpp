@@ -0,0 +1,470 @@
+#include "Inventory.hpp"
+
+#include <algorithm>
+#include <numeric>
+
+namespace TarkovAPI
+{
+    static ObjectId GetObjectId(const json& object, const char* key)
+    {
+        auto id = ObjectId();
+        auto it = object.find(key);
+        if (it != object.end() && it->is_string())
+        {
+            ObjectId::TryParse(it->get_ref<const std::string&>(), id);
+        }
+        return id;
+    }
+
+    static ItemLocation GetItemLocation(const json& item)
+    {
+        auto location = ItemLocation();
+
+        auto it = item.find("location");
+        if (it == item.end())
+        {
+            return location;
+        }
+
+        if (it->is_number_integer())
+        {
+            location.x = it->get<int32_t>();
+        }
+        else if (it->is_object() && it->contains("x") && it->contains("y"))
+        {
+            location.x = it->at("x").get<int32_t>();
+            location.y = it->at("y").get<int32_t>();
+            location.in_grid = true;
+
+            // Backend sends rotation either as 0/1 or as "Horizontal"/"Vertical"
+            auto r = it->find("r");
+            if (r != it->end())
+            {
+                location.rotated = r->is_string() ? (r->get_ref<const std::string&>() == "Vertical") : (r->is_number() && r->get<int64_t>() != 0);
+            }
+        }
+        return location;
+    }
+
+    static bool IsPlacementChange(const json& item)
+    {
+        return item.contains("_tpl") || item.contains("parentId") || item.contains("slotId") || item.contains("location");
+    }
+
+    static const json* FindFoldable(const json& item)
+    {
+        auto upd = item.find("upd");
+        if (upd == item.end() || !upd->is_object())
+        {
+            return nullptr;
+        }
+
+        auto foldable = upd->find("Foldable");
+        return (foldable != upd->end() && foldable->is_object()) ? &*foldable : nullptr;
+    }
+
+    // Walks positions sorted by key and records [begin, end) of every key
+    template <typename F>
+    static void BuildRanges(const std::vector <uint32_t>& sorted, std::unordered_map <ObjectId, std::pair <uint32_t, uint32_t>>& ranges, F&& key_of)
+    {
+        uint32_t begin = 0;
+        for (uint32_t i = 1; i <= sorted.size(); ++i)
+        {
+            if (i == sorted.size() || key_of(sorted[i]) != key_of(sorted[begin]))
+            {
+                ranges.emplace(key_of(sorted[begin]), std::make_pair(begin, i));
+                begin = i;
+            }
+        }
+    }
+
+    Inventory::Inventory(const json& inventory)
+    {
+        if (!inventory.is_object())
+        {
+            return;
+        }
+
+        m_kStashId = GetObjectId(inventory, "stash");
+        m_kEquipmentId = GetObjectId(inventory, "equipment");
+
+        auto items = inventory.find("items");
+        if (items == inventory.end() || !items->is_array())
+        {
+            return;
+        }
+
+        m_vIds.reserve(items->size());
+        m_vTemplates.reserve(items->size());
+        m_vParents.reserve(items->size());
+        m_vSlots.reserve(items->size());
+        m_vStackCounts.reserve(items->size());
+        m_vFolded.reserve(items->size());
+        m_vLocations.reserve(items->size());
+
+        for (const auto& item : *items)
+        {
+            AddItem(item);
+        }
+        BuildIndexes();
+    }
+
+    bool Inventory::ApplyChanges(const json& changes, std::vector <ObjectId>* touched)
+    {
+        if (!changes.is_object())
+        {
+            return false;
+        }
+
+        auto consistent = true;
+        auto removed = std::vector <uint32_t>();
+
+        auto for_each_change = [&changes](const char* section, auto&& fn) {
+            auto it = changes.find(section);
+            if (it != changes.end() && it->is_array())
+            {
+                for (const auto& item : *it)
+                {
+                    fn(item);
+                }
+            }
+        };
+
+        // Only placement and fold changes are reported, stack count updates leave grids as they are
+        auto touch = [this, touched](uint32_t index) {
+            if (touched)
+            {
+                touched->emplace_back(m_vIds[index]);
+                touched->emplace_back(m_vParents[index]);
+            }
+        };
+
+        // New and changed entries carrying a _tpl are complete items, others only have fields which changed
+        for_each_change("new", [&](const json& item) {
+            auto index = Find(GetObjectId(item, "_id"));
+            if (index != NPOS)
+            {
+                touch(index);
+                SetItem(index, item, true);
+                touch(index);
+            }
+            else if (AddItem(item))
+            {
+                touch(static_cast<uint32_t>(m_vIds.size() - 1));
+            }
+            else
+            {
+                consistent = false;
+            }
+        });
+        for_each_change("change", [&](const json& item) {
+            auto index = Find(GetObjectId(item, "_id"));
+            if (index != NPOS)
+            {
+                auto moved = IsPlacementChange(item) || FindFoldable(item) != nullptr;
+                if (moved)
+                {
+                    touch(index);
+                }
+                SetItem(index, item, item.contains("_tpl"));
+                if (moved)
+                {
+                    touch(index);
+                }
+            }
+            else if (item.contains("_tpl") && AddItem(item))
+            {
+                touch(static_cast<uint32_t>(m_vIds.size() - 1));
+            }
+            else
+            {
+                consistent = false;
+            }
+        });
+        for_each_change("del", [&](const json& item) {
+            auto index = Find(GetObjectId(item, "_id"));
+            if (index != NPOS)
+            {
+                removed.emplace_back(index);
+            }
+            else
+            {
+                consistent = false;
+            }
+        });
+
+        RemoveItems(removed, touched);
+        return consistent;
+    }
+
+    bool Inventory::AddItem(const json& item)
+    {
+        if (!item.is_object())
+        {
+            return false;
+        }
+
+        auto id = GetObjectId(item, "_id");
+        if (id.IsNull() || GetObjectId(item, "_tpl").IsNull())
+        {
+            return false;
+        }
+
+        auto index = static_cast<uint32_t>(m_vIds.size());
+
+        m_vIds.emplace_back(id);
+        m_vTemplates.emplace_back();
+        m_vParents.emplace_back();
+        m_vSlots.emplace_back();
+        m_vStackCounts.emplace_back(1);
+        m_vFolded.emplace_back(false);
+        m_vLocations.emplace_back();
+        m_pkById.emplace(id, index);
+
+        SetItem(index, item, true);
+        return true;
+    }
+
+    void Inventory::SetItem(uint32_t index, const json& item, bool replace)
+    {
+        if (replace || item.contains("_tpl"))
+        {
+            m_vTemplates[index] = GetObjectId(item, "_tpl");
+        }
+
+        // Moving into a slot drops grid location, so parent, slot and location change together
+        if (replace || IsPlacementChange(item))
+        {
+            auto slot = item.find("slotId");
+
+            m_vParents[index] = GetObjectId(item, "parentId");
+            m_vSlots[index] = (slot != item.end() && slot->is_string()) ? slot->get_ref<const std::string&>() : std::string();
+            m_vLocations[index] = GetItemLocation(item);
+        }
+
+        auto upd = item.find("upd");
+        if (upd != item.end() && upd->is_object() && upd->contains("StackObjectsCount"))
+        {
+            m_vStackCounts[index] = upd->at("StackObjectsCount").get<uint64_t>();
+        }
+        else if (replace)
+        {
+            m_vStackCounts[index] = 1;
+        }
+
+        auto foldable = FindFoldable(item);
+        if (foldable)
+        {
+            m_vFolded[index] = foldable->value("Folded", false);
+        }
+        else if (replace)
+        {
+            m_vFolded[index] = false;
+        }
+    }
+
+    void Inventory::RemoveItems(const std::vector <uint32_t>& roots, std::vector <ObjectId>* touched)
+    {
+        BuildIndexes();
+        if (roots.empty())
+        {
+            return;
+        }
+
+        // Contents of a removed container go with it
+        auto removed = std::vector <bool>(m_vIds.size(), false);
+        auto pending = roots;
+        while (!pending.empty())
+        {
+            auto index = pending.back();
+            pending.pop_back();
+
+            if (removed[index])
+            {
+                continue;
+            }
+            removed[index] = true;
+
+            if (touched)
+            {
+                touched->emplace_back(m_vIds[index]);
+                touched->emplace_back(m_vParents[index]);
+            }
+
+            for (auto child : GetChildren(m_vIds[index]))
+            {
+                pending.emplace_back(child);
+            }
+        }
+
+        size_t kept = 0;
+        for (size_t i = 0; i < m_vIds.size(); ++i)
+        {
+            if (removed[i])
+            {
+                continue;
+            }
+            if (kept != i)
+            {
+                m_vIds[kept] = m_vIds[i];
+                m_vTemplates[kept] = m_vTemplates[i];
+                m_vParents[kept] = m_vParents[i];
+                m_vSlots[kept] = std::move(m_vSlots[i]);
+                m_vStackCounts[kept] = m_vStackCounts[i];
+                m_vFolded[kept] = m_vFolded[i];
+                m_vLocations[kept] = m_vLocations[i];
+            }
+            ++kept;
+        }
+
+        m_vIds.resize(kept);
+        m_vTemplates.resize(kept);
+        m_vParents.resize(kept);
+        m_vSlots.resize(kept);
+        m_vStackCounts.resize(kept);
+        m_vFolded.resize(kept);
+        m_vLocations.resize(kept);
+
+        BuildIndexes();
+    }
+
+    void Inventory::BuildIndexes()
+    {
+        const auto count = static_cast<uint32_t>(m_vIds.size());
+
+        m_pkById.clear();
+        m_pkTemplateRanges.clear();
+        m_pkParentRanges.clear();
+        m_vByParent.clear();
+
+        m_pkById.reserve(count);
+        for (uint32_t i = 0; i < count; ++i)
+        {
+            m_pkById.emplace(m_vIds[i], i);
+        }
+
+        // Stable sorts keep Inventory.items order inside a key
+        m_vByTemplate.resize(count);
+        std::iota(m_vByTemplate.begin(), m_vByTemplate.end(), 0);
+        std::stable_sort(m_vByTemplate.begin(), m_vByTemplate.end(), [this](uint32_t lhs, uint32_t rhs) {
+            return m_vTemplates[lhs] < m_vTemplates[rhs];
+        });
+        BuildRanges(m_vByTemplate, m_pkTemplateRanges, [this](uint32_t i) -> const ObjectId& { return m_vTemplates[i]; });
+
+        m_vByParent.reserve(count);
+        for (uint32_t i = 0; i < count; ++i)
+        {
+            if (!m_vParents[i].IsNull())
+            {
+                m_vByParent.emplace_back(i);
+            }
+        }
+        std::stable_sort(m_vByParent.begin(), m_vByParent.end(), [this](uint32_t lhs, uint32_t rhs) {
+            if (m_vParents[lhs] != m_vParents[rhs])
+            {
+                return m_vParents[lhs] < m_vParents[rhs];
+            }
+            return m_vSlots[lhs] < m_vSlots[rhs];
+        });
+        BuildRanges(m_vByParent, m_pkParentRanges, [this](uint32_t i) -> const ObjectId& { return m_vParents[i]; });
+    }
+
+    size_t Inventory::GetCount() const
+    {
+        return m_vIds.size();
+    }
+
+    const ObjectId& Inventory::GetStashId() const
+    {
+        return m_kStashId;
+    }
+
+    const ObjectId& Inventory::GetEquipmentId() const
+    {
+        return m_kEquipmentId;
+    }
+
+    const ObjectId& Inventory::GetId(uint32_t index) const
+    {
+        return m_vIds.at(index);
+    }
+
+    const ObjectId& Inventory::GetTemplate(uint32_t index) const
+    {
+        return m_vTemplates.at(index);
+    }
+
+    const ObjectId& Inventory::GetParent(uint32_t index) const
+    {
+        return m_vParents.at(index);
+    }
+
+    std::string_view Inventory::GetSlot(uint32_t index) const
+    {
+        return m_vSlots.at(index);
+    }
+
+    uint64_t Inventory::GetStackCount(uint32_t index) const
+    {
+        return m_vStackCounts.at(index);
+    }
+
+    bool Inventory::IsFolded(uint32_t index) const
+    {
+        return m_vFolded.at(index);
+    }
+
+    const ItemLocation& Inventory::GetLocation(uint32_t index) const
+    {
+        return m_vLocations.at(index);
+    }
+
+    uint32_t Inventory::Find(const ObjectId& id) const
+    {
+        auto it = m_pkById.find(id);
+        return (it != m_pkById.end()) ? it->second : NPOS;
+    }
+
+    ItemRange Inventory::FindByTemplate(const ObjectId& schema_id) const
+    {
+        auto it = m_pkTemplateRanges.find(schema_id);
+        if (it == m_pkTemplateRanges.end())
+        {
+            return ItemRange();
+        }
+        return ItemRange(m_vByTemplate.data() + it->second.first, m_vByTemplate.data() + it->second.second);
+    }
+
+    ItemRange Inventory::GetChildren(const ObjectId& parent_id) const
+    {
+        auto it = m_pkParentRanges.find(parent_id);
+        if (it == m_pkParentRanges.end())
+        {
+            return ItemRange();
+        }
+        return ItemRange(m_vByParent.data() + it->second.first, m_vByParent.data() + it->second.second);
+    }
+
+    ItemRange Inventory::GetChildren(const ObjectId& parent_id, std::string_view slot) const
+    {
+        auto children = GetChildren(parent_id);
+
+        auto first = std::lower_bound(children.begin(), children.end(), slot, [this](uint32_t i, std::string_view value) {
+            return std::string_view(m_vSlots[i]) < value;
+        });
+        auto last = std::upper_bound(first, children.end(), slot, [this](std::string_view value, uint32_t i) {
+            return value < std::string_view(m_vSlots[i]);
+        });
+        return ItemRange(first, last);
+    }
+
+    uint64_t Inventory::GetStackTotal(const ObjectId& schema_id) const
+    {
+        uint64_t total = 0;
+        for (auto i : FindByTemplate(schema_id))
+        {
+            total += m_vStackCounts[i];
+        }
+        return total;
+    }
+};
@@ -0,0 +1,103 @@
+#pragma once
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <unordered_map>
+
+#include <json.hpp>
+
+#include "ObjectId.hpp"
+
+namespace TarkovAPI
+{
+	using json = nlohmann::json;
+
+	struct ItemLocation
+	{
+		int32_t x{ 0 }; // cartridge position when not in a grid
+		int32_t y{ 0 };
+		bool rotated{ false };
+		bool in_grid{ false };
+	};
+
+	// Positions of items in an Inventory, in order of Inventory.items
+	class ItemRange
+	{
+	public:
+		ItemRange() = default;
+		ItemRange(const uint32_t* first, const uint32_t* last) :
+			m_pkFirst(first), m_pkLast(last)
+		{ }
+
+		const uint32_t* begin() const { return m_pkFirst; }
+		const uint32_t* end() const { return m_pkLast; }
+		size_t size() const { return static_cast<size_t>(m_pkLast - m_pkFirst); }
+		bool empty() const { return m_pkFirst == m_pkLast; }
+
+	private:
+		const uint32_t* m_pkFirst{ nullptr };
+		const uint32_t* m_pkLast{ nullptr };
+	};
+
+	// Typed view of a profile's Inventory, built once per profile fetch and kept current with items/moving changes
+	// Items are stored as columns indexed by position, with lookups by id, by template and by parent container + slot
+	// Items without a valid _id or _tpl are skipped
+	class Inventory
+	{
+	public:
+		static constexpr uint32_t NPOS = UINT32_MAX;
+
+	public:
+		Inventory() = default;
+		explicit Inventory(const json& inventory); // Inventory object of a profile
+
+		size_t GetCount() const;
+		const ObjectId& GetStashId() const; // null when profile has none
+		const ObjectId& GetEquipmentId() const;
+
+		const ObjectId& GetId(uint32_t index) const;
+		const ObjectId& GetTemplate(uint32_t index) const;
+		const ObjectId& GetParent(uint32_t index) const; // null for root items
+		std::string_view GetSlot(uint32_t index) const;
+		uint64_t GetStackCount(uint32_t index) const; // 1 when upd has no StackObjectsCount
+		bool IsFolded(uint32_t index) const; // upd.Foldable.Folded, stock or weapon is folded
+		const ItemLocation& GetLocation(uint32_t index) const;
+
+		uint32_t Find(const ObjectId& id) const; // NPOS when unknown
+		ItemRange FindByTemplate(const ObjectId& schema_id) const;
+		ItemRange GetChildren(const ObjectId& parent_id) const; // grouped by slot
+		ItemRange GetChildren(const ObjectId& parent_id, std::string_view slot) const;
+		uint64_t GetStackTotal(const ObjectId& schema_id) const;
+
+		// Applies new/change/del item lists of an items/moving response, removed containers take their contents
+		// False when a change refers to an unknown item, state has diverged from server and should be reloaded
+		// touched gets items whose grid contents or size may differ: moved, folded and removed items and their old and new parents
+		bool ApplyChanges(const json& changes, std::vector <ObjectId>* touched = nullptr);
+
+	protected:
+		bool AddItem(const json& item);
+		void SetItem(uint32_t index, const json& item, bool replace);
+		void RemoveItems(const std::vector <uint32_t>& roots, std::vector <ObjectId>* touched = nullptr); // rebuilds indexes
+		void BuildIndexes();
+
+	private:
+		ObjectId m_kStashId;
+		ObjectId m_kEquipmentId;
+
+		std::vector <ObjectId> m_vIds;
+		std::vector <ObjectId> m_vTemplates;
+		std::vector <ObjectId> m_vParents;
+		std::vector <std::string> m_vSlots;
+		std::vector <uint64_t> m_vStackCounts;
+		std::vector <bool> m_vFolded;
+		std::vector <ItemLocation> m_vLocations;
+
+		// Positions sorted by key, maps point to [begin, end) of a key
+		std::vector <uint32_t> m_vByTemplate;
+		std::vector <uint32_t> m_vByParent;
+		std::unordered_map <ObjectId /* _id */, uint32_t> m_pkById;
+		std::unordered_map <ObjectId /* _tpl */, std::pair <uint32_t, uint32_t>> m_pkTemplateRanges;
+		std::unordered_map <ObjectId /* parentId */, std::pair <uint32_t, uint32_t>> m_pkParentRanges;
+	};
+};
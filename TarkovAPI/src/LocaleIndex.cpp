@@ -0,0 +1,89 @@
+#include "LocaleIndex.hpp"
+
+namespace TarkovAPI
+{
+    static std::string_view GetStringView(const json& object, const char* key)
+    {
+        auto it = object.find(key);
+        if (it == object.end() || !it->is_string())
+        {
+            return std::string_view();
+        }
+        return it->get_ref<const std::string&>();
+    }
+
+    LocaleIndex::LocaleIndex(std::shared_ptr <const json> locale) :
+        m_pkLocale(std::move(locale))
+    {
+        if (!m_pkLocale || !m_pkLocale->is_object())
+        {
+            return;
+        }
+
+        // Sections are walked in locale order and first entry wins, same results as a linear scan
+        for (const auto& section : *m_pkLocale)
+        {
+            if (!section.is_object())
+            {
+                continue;
+            }
+
+            for (auto it = section.begin(); it != section.end(); ++it)
+            {
+                const auto& entry = it.value();
+                if (!entry.is_object())
+                {
+                    continue;
+                }
+
+                const auto& id = it.key();
+
+                auto name = entry.find("Name");
+                ObjectId schema_id{};
+                if (name != entry.end() && name->is_string() && ObjectId::TryParse(id, schema_id))
+                {
+                    m_pkItems.emplace(schema_id, ItemLocale{ name->get_ref<const std::string&>(), GetStringView(entry, "ShortName"), GetStringView(entry, "Description") });
+                }
+
+                auto nickname = entry.find("Nickname");
+                if (nickname != entry.end() && nickname->is_string())
+                {
+                    m_pkTraders.emplace(nickname->get_ref<const std::string&>(), id);
+                }
+            }
+        }
+    }
+
+    const ItemLocale* LocaleIndex::FindItem(const ObjectId& schema_id) const
+    {
+        auto it = m_pkItems.find(schema_id);
+        return (it != m_pkItems.end()) ? &it->second : nullptr;
+    }
+
+    const ItemLocale* LocaleIndex::FindItem(std::string_view schema_id) const
+    {
+        ObjectId id{};
+        return ObjectId::TryParse(schema_id, id) ? FindItem(id) : nullptr;
+    }
+
+    std::string_view LocaleIndex::FindTraderId(std::string_view nickname) const
+    {
+        auto it = m_pkTraders.find(nickname);
+        return (it != m_pkTraders.end()) ? it->second : std::string_view();
+    }
+
+    size_t LocaleIndex::GetItemCount() const
+    {
+        return m_pkItems.size();
+    }
+
+    size_t LocaleIndex::GetTraderCount() const
+    {
+        return m_pkTraders.size();
+    }
+
+    const std::shared_ptr <const json>& LocaleIndex::GetLocale() const
+    {
+        return m_pkLocale;
+    }
+};
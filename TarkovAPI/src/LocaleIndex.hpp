@@ -0,0 +1,47 @@
+#pragma once
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <memory>
+#include <unordered_map>
+
+#include <json.hpp>
+
+#include "ObjectId.hpp"
+
+namespace TarkovAPI
+{
+	using json = nlohmann::json;
+
+	struct ItemLocale
+	{
+		std::string_view name;
+		std::string_view short_name; // empty when locale has none
+		std::string_view description;
+	};
+
+	// Lookup tables over one loaded locale
+	// Item keys are binary ids, other keys and values are views into locale DOM; index holds the locale so views stay valid as long as index is alive
+	class LocaleIndex
+	{
+	public:
+		explicit LocaleIndex(std::shared_ptr <const json> locale);
+		virtual ~LocaleIndex() = default;
+
+		LocaleIndex(const LocaleIndex&) = delete;
+		LocaleIndex& operator=(const LocaleIndex&) = delete;
+
+		const ItemLocale* FindItem(const ObjectId& schema_id) const; // nullptr when unknown
+		const ItemLocale* FindItem(std::string_view schema_id) const; // nullptr when unknown or not an object id
+		std::string_view FindTraderId(std::string_view nickname) const; // empty when unknown
+
+		size_t GetItemCount() const;
+		size_t GetTraderCount() const;
+		const std::shared_ptr <const json>& GetLocale() const;
+
+	private:
+		std::shared_ptr <const json> m_pkLocale;
+		std::unordered_map <ObjectId /* schema_id */, ItemLocale> m_pkItems;
+		std::unordered_map <std::string_view /* nickname */, std::string_view /* trader_id */> m_pkTraders;
+	};
+};
@@ -0,0 +1,421 @@
+#include "Metrics.hpp"
+#include "TrafficCapture.hpp"
+#include <algorithm>
+#include <cctype>
+#include <cstdio>
+#include <fstream>
+
+#include <fmt/format.h>
+
+namespace TarkovAPI
+{
+    namespace
+    {
+        // Last endpoint recorded on this thread, response handlers run right after the request they handle
+        thread_local std::string tls_stLastEndpoint;
+
+        bool IsObjectId(const std::string& segment)
+        {
+            return segment.size() == 24 && std::all_of(segment.begin(), segment.end(), [](char c) {
+                return std::isxdigit(static_cast<unsigned char>(c));
+            });
+        }
+
+        std::string FormatSeconds(uint64_t value_us)
+        {
+            return fmt::format("{:g}", static_cast<double>(value_us) / 1000000.0);
+        }
+
+        std::string FormatCode(int64_t code)
+        {
+            return (code == REQUEST_FAILED_CODE) ? std::string("failed") : std::to_string(code);
+        }
+    }
+
+    double HistogramSnapshot::Mean() const
+    {
+        return count ? static_cast<double>(sum_us) / static_cast<double>(count) : 0.0;
+    }
+
+    double HistogramSnapshot::Quantile(double q) const
+    {
+        if (!count)
+        {
+            return 0.0;
+        }
+
+        auto rank = static_cast<uint64_t>(std::max(1.0, q * static_cast<double>(count) + 0.5));
+        auto seen = uint64_t(0);
+        for (size_t i = 0; i < HISTOGRAM_BOUNDS_US.size(); ++i)
+        {
+            seen += buckets[i];
+            if (seen >= rank)
+            {
+                return static_cast<double>(HISTOGRAM_BOUNDS_US[i]);
+            }
+        }
+        return static_cast<double>(HISTOGRAM_BOUNDS_US.back()); // +Inf bucket, report largest finite bound
+    }
+
+    void Histogram::Observe(uint64_t value_us)
+    {
+        auto it = std::lower_bound(HISTOGRAM_BOUNDS_US.begin(), HISTOGRAM_BOUNDS_US.end(), value_us);
+        m_nBuckets[static_cast<size_t>(it - HISTOGRAM_BOUNDS_US.begin())].fetch_add(1, std::memory_order_relaxed);
+        m_nSum.fetch_add(value_us, std::memory_order_relaxed);
+        m_nCount.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    HistogramSnapshot Histogram::Snapshot() const
+    {
+        HistogramSnapshot out{};
+        for (size_t i = 0; i < m_nBuckets.size(); ++i)
+        {
+            out.buckets[i] = m_nBuckets[i].load(std::memory_order_relaxed);
+            out.count += out.buckets[i];
+        }
+        out.sum_us = m_nSum.load(std::memory_order_relaxed);
+        return out;
+    }
+
+    struct MetricsRegistry::EndpointMetrics
+    {
+        std::atomic <uint64_t> requests{ 0 };
+        std::atomic <uint64_t> compressed_bytes{ 0 };
+        std::atomic <uint64_t> decompressed_bytes{ 0 };
+
+        Histogram network;
+        Histogram inflate;
+        Histogram parse;
+        Histogram handle;
+
+        std::mutex responses_mutex;
+        std::map <int64_t, uint64_t> responses;
+    };
+
+    struct MetricsRegistry::JobMetrics
+    {
+        std::atomic <uint64_t> runs{ 0 };
+        std::atomic <uint64_t> failures{ 0 };
+        Histogram duration;
+    };
+
+    MetricsRegistry& MetricsRegistry::Instance()
+    {
+        static MetricsRegistry instance;
+        return instance;
+    }
+
+    MetricsRegistry::~MetricsRegistry()
+    {
+        StopDump();
+    }
+
+    std::string MetricsRegistry::NormalizePath(const std::string& url)
+    {
+        auto key = TrafficCapture::GetRequestKey(url);
+
+        auto query = key.find('?');
+        if (query != std::string::npos)
+        {
+            key.resize(query);
+        }
+
+        // "/client/trading/api/getTrader/<id>" -> "/client/trading/api/getTrader/:id"
+        auto out = std::string();
+        out.reserve(key.size());
+
+        size_t begin = 0;
+        while (begin < key.size())
+        {
+            auto end = key.find('/', begin + 1);
+            if (end == std::string::npos)
+            {
+                end = key.size();
+            }
+
+            auto segment = key.substr(begin + 1, end - begin - 1);
+            out += '/';
+            out += IsObjectId(segment) ? ":id" : segment;
+            begin = end;
+        }
+        return out.empty() ? "/" : out;
+    }
+
+    MetricsRegistry::EndpointMetrics& MetricsRegistry::GetEndpoint(const std::string& path)
+    {
+        std::lock_guard <std::mutex> lock(m_pkMutex);
+
+        auto& endpoint = m_pkEndpoints[path];
+        if (!endpoint)
+        {
+            endpoint = std::make_unique<EndpointMetrics>();
+        }
+        return *endpoint;
+    }
+
+    void MetricsRegistry::RecordRequest(const std::string& url, const TransferMetrics& transfer, int64_t error_code)
+    {
+        auto path = NormalizePath(url);
+        auto& endpoint = GetEndpoint(path);
+
+        endpoint.requests.fetch_add(1, std::memory_order_relaxed);
+        endpoint.compressed_bytes.fetch_add(transfer.compressed_bytes, std::memory_order_relaxed);
+        endpoint.decompressed_bytes.fetch_add(transfer.decompressed_bytes, std::memory_order_relaxed);
+
+        endpoint.network.Observe(transfer.network_us);
+        endpoint.inflate.Observe(transfer.inflate_us);
+        endpoint.parse.Observe(transfer.parse_us);
+
+        {
+            std::lock_guard <std::mutex> lock(endpoint.responses_mutex);
+            endpoint.responses[error_code]++;
+        }
+
+        tls_stLastEndpoint = std::move(path);
+    }
+
+    void MetricsRegistry::RecordHandle(uint64_t elapsed_us)
+    {
+        if (tls_stLastEndpoint.empty())
+        {
+            return;
+        }
+        GetEndpoint(tls_stLastEndpoint).handle.Observe(elapsed_us);
+    }
+
+    void MetricsRegistry::RecordJob(const std::string& name, uint64_t elapsed_us, bool succeeded)
+    {
+        JobMetrics* job = nullptr;
+        {
+            std::lock_guard <std::mutex> lock(m_pkMutex);
+
+            auto& entry = m_pkJobs[name];
+            if (!entry)
+            {
+                entry = std::make_unique<JobMetrics>();
+            }
+            job = entry.get();
+        }
+
+        job->runs.fetch_add(1, std::memory_order_relaxed);
+        if (!succeeded)
+        {
+            job->failures.fetch_add(1, std::memory_order_relaxed);
+        }
+        job->duration.Observe(elapsed_us);
+    }
+
+    std::vector <JobMetricsSnapshot> MetricsRegistry::GetJobSnapshot() const
+    {
+        std::lock_guard <std::mutex> lock(m_pkMutex);
+
+        auto out = std::vector <JobMetricsSnapshot>();
+        out.reserve(m_pkJobs.size());
+
+        for (const auto& [name, job] : m_pkJobs)
+        {
+            auto snapshot = JobMetricsSnapshot{};
+            snapshot.name = name;
+            snapshot.runs = job->runs.load(std::memory_order_relaxed);
+            snapshot.failures = job->failures.load(std::memory_order_relaxed);
+            snapshot.duration = job->duration.Snapshot();
+            out.emplace_back(std::move(snapshot));
+        }
+        return out;
+    }
+
+    std::vector <EndpointMetricsSnapshot> MetricsRegistry::GetSnapshot() const
+    {
+        std::lock_guard <std::mutex> lock(m_pkMutex);
+
+        auto out = std::vector <EndpointMetricsSnapshot>();
+        out.reserve(m_pkEndpoints.size());
+
+        for (const auto& [path, endpoint] : m_pkEndpoints)
+        {
+            auto snapshot = EndpointMetricsSnapshot{};
+            snapshot.path = path;
+            snapshot.requests = endpoint->requests.load(std::memory_order_relaxed);
+            snapshot.compressed_bytes = endpoint->compressed_bytes.load(std::memory_order_relaxed);
+            snapshot.decompressed_bytes = endpoint->decompressed_bytes.load(std::memory_order_relaxed);
+            snapshot.network = endpoint->network.Snapshot();
+            snapshot.inflate = endpoint->inflate.Snapshot();
+            snapshot.parse = endpoint->parse.Snapshot();
+            snapshot.handle = endpoint->handle.Snapshot();
+            {
+                std::lock_guard <std::mutex> responses_lock(endpoint->responses_mutex);
+                snapshot.responses = endpoint->responses;
+            }
+            out.emplace_back(std::move(snapshot));
+        }
+        return out;
+    }
+
+    bool MetricsRegistry::GetEndpointSnapshot(const std::string& path, EndpointMetricsSnapshot& out) const
+    {
+        auto normalized = NormalizePath(path);
+        for (auto& it : GetSnapshot())
+        {
+            if (it.path == normalized)
+            {
+                out = std::move(it);
+                return true;
+            }
+        }
+        return false;
+    }
+
+    void MetricsRegistry::Reset()
+    {
+        std::lock_guard <std::mutex> lock(m_pkMutex);
+        m_pkEndpoints.clear();
+        m_pkJobs.clear();
+    }
+
+    std::string MetricsRegistry::ToPrometheus() const
+    {
+        auto endpoints = GetSnapshot();
+        auto out = std::string();
+
+        out += "# HELP tarkovapi_requests_total Requests sent per endpoint.\n";
+        out += "# TYPE tarkovapi_requests_total counter\n";
+        for (const auto& it : endpoints)
+        {
+            out += fmt::format("tarkovapi_requests_total{{path=\"{}\"}} {}\n", it.path, it.requests);
+        }
+
+        out += "# HELP tarkovapi_responses_total Responses per endpoint and backend error code.\n";
+        out += "# TYPE tarkovapi_responses_total counter\n";
+        for (const auto& it : endpoints)
+        {
+            for (const auto& [code, count] : it.responses)
+            {
+                out += fmt::format("tarkovapi_responses_total{{path=\"{}\",code=\"{}\"}} {}\n", it.path, FormatCode(code), count);
+            }
+        }
+
+        out += "# HELP tarkovapi_compressed_bytes_total Response bytes received on wire.\n";
+        out += "# TYPE tarkovapi_compressed_bytes_total counter\n";
+        for (const auto& it : endpoints)
+        {
+            out += fmt::format("tarkovapi_compressed_bytes_total{{path=\"{}\"}} {}\n", it.path, it.compressed_bytes);
+        }
+
+        out += "# HELP tarkovapi_decompressed_bytes_total Response bytes after inflate.\n";
+        out += "# TYPE tarkovapi_decompressed_bytes_total counter\n";
+        for (const auto& it : endpoints)
+        {
+            out += fmt::format("tarkovapi_decompressed_bytes_total{{path=\"{}\"}} {}\n", it.path, it.decompressed_bytes);
+        }
+
+        out += "# HELP tarkovapi_phase_seconds Time spent per request phase.\n";
+        out += "# TYPE tarkovapi_phase_seconds histogram\n";
+        for (const auto& it : endpoints)
+        {
+            const std::pair <const char*, const HistogramSnapshot*> phases[] = {
+                { "network", &it.network }, { "inflate", &it.inflate }, { "parse", &it.parse }, { "handle", &it.handle }
+            };
+            for (const auto& [phase, histogram] : phases)
+            {
+                auto cumulative = uint64_t(0);
+                for (size_t i = 0; i < HISTOGRAM_BOUNDS_US.size(); ++i)
+                {
+                    cumulative += histogram->buckets[i];
+                    out += fmt::format("tarkovapi_phase_seconds_bucket{{path=\"{}\",phase=\"{}\",le=\"{}\"}} {}\n", it.path, phase, FormatSeconds(HISTOGRAM_BOUNDS_US[i]), cumulative);
+                }
+                out += fmt::format("tarkovapi_phase_seconds_bucket{{path=\"{}\",phase=\"{}\",le=\"+Inf\"}} {}\n", it.path, phase, histogram->count);
+                out += fmt::format("tarkovapi_phase_seconds_sum{{path=\"{}\",phase=\"{}\"}} {}\n", it.path, phase, FormatSeconds(histogram->sum_us));
+                out += fmt::format("tarkovapi_phase_seconds_count{{path=\"{}\",phase=\"{}\"}} {}\n", it.path, phase, histogram->count);
+            }
+        }
+
+        auto jobs = GetJobSnapshot();
+
+        out += "# HELP tarkovapi_job_runs_total Background job runs.\n";
+        out += "# TYPE tarkovapi_job_runs_total counter\n";
+        for (const auto& it : jobs)
+        {
+            out += fmt::format("tarkovapi_job_runs_total{{job=\"{}\"}} {}\n", it.name, it.runs);
+        }
+
+        out += "# HELP tarkovapi_job_failures_total Background job runs which threw.\n";
+        out += "# TYPE tarkovapi_job_failures_total counter\n";
+        for (const auto& it : jobs)
+        {
+            out += fmt::format("tarkovapi_job_failures_total{{job=\"{}\"}} {}\n", it.name, it.failures);
+        }
+
+        out += "# HELP tarkovapi_job_seconds Background job duration.\n";
+        out += "# TYPE tarkovapi_job_seconds histogram\n";
+        for (const auto& it : jobs)
+        {
+            auto cumulative = uint64_t(0);
+            for (size_t i = 0; i < HISTOGRAM_BOUNDS_US.size(); ++i)
+            {
+                cumulative += it.duration.buckets[i];
+                out += fmt::format("tarkovapi_job_seconds_bucket{{job=\"{}\",le=\"{}\"}} {}\n", it.name, FormatSeconds(HISTOGRAM_BOUNDS_US[i]), cumulative);
+            }
+            out += fmt::format("tarkovapi_job_seconds_bucket{{job=\"{}\",le=\"+Inf\"}} {}\n", it.name, it.duration.count);
+            out += fmt::format("tarkovapi_job_seconds_sum{{job=\"{}\"}} {}\n", it.name, FormatSeconds(it.duration.sum_us));
+            out += fmt::format("tarkovapi_job_seconds_count{{job=\"{}\"}} {}\n", it.name, it.duration.count);
+        }
+        return out;
+    }
+
+    bool MetricsRegistry::WriteDump(const std::string& path) const
+    {
+        // Write aside and rename, scrapers never see a half written file
+        auto temp_path = path + ".tmp";
+        {
+            std::ofstream file(temp_path, std::ios::binary | std::ios::trunc);
+            if (!file)
+            {
+                return false;
+            }
+            file << ToPrometheus();
+            if (!file)
+            {
+                return false;
+            }
+        }
+
+        std::remove(path.c_str());
+        return std::rename(temp_path.c_str(), path.c_str()) == 0;
+    }
+
+    void MetricsRegistry::StartDump(const std::string& path, std::chrono::seconds interval)
+    {
+        StopDump();
+
+        std::lock_guard <std::mutex> lock(m_pkDumpMutex);
+        m_bDumpRunning = true;
+        m_kDumpThread = std::thread(&MetricsRegistry::DumpLoop, this, path, interval);
+    }
+
+    void MetricsRegistry::StopDump()
+    {
+        {
+            std::lock_guard <std::mutex> lock(m_pkDumpMutex);
+            m_bDumpRunning = false;
+        }
+        m_kDumpCondition.notify_all();
+
+        if (m_kDumpThread.joinable())
+        {
+            m_kDumpThread.join();
+        }
+    }
+
+    void MetricsRegistry::DumpLoop(std::string path, std::chrono::seconds interval)
+    {
+        std::unique_lock <std::mutex> lock(m_pkDumpMutex);
+        while (m_bDumpRunning)
+        {
+            m_kDumpCondition.wait_for(lock, interval, [this] { return !m_bDumpRunning; });
+
+            lock.unlock();
+            WriteDump(path); // final dump on stop, so short runs leave a file too
+            lock.lock();
+        }
+    }
+};
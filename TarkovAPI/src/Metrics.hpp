@@ -0,0 +1,166 @@
+#pragma once
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <array>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <condition_variable>
+
+namespace TarkovAPI
+{
+	static constexpr auto METRICS_ENV = "TARKOVAPI_METRICS";
+	static constexpr int64_t REQUEST_FAILED_CODE = -1; // Transport, decompress or JSON failure, no backend error code
+
+	// Adds elapsed microseconds to target when it goes out of scope
+	class ScopedTimer
+	{
+	public:
+		explicit ScopedTimer(uint64_t& target_us) :
+			m_nTarget(target_us), m_kBegin(std::chrono::steady_clock::now())
+		{
+		}
+		~ScopedTimer()
+		{
+			m_nTarget += static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - m_kBegin).count());
+		}
+
+		ScopedTimer(const ScopedTimer&) = delete;
+		ScopedTimer& operator=(const ScopedTimer&) = delete;
+
+	private:
+		uint64_t& m_nTarget;
+		std::chrono::steady_clock::time_point m_kBegin;
+	};
+
+	// Phase breakdown of one HTTP exchange, filled by HttpClient
+	struct TransferMetrics
+	{
+		uint64_t network_us{ 0 }; // waiting on socket, includes TLS and server time
+		uint64_t inflate_us{ 0 };
+		uint64_t parse_us{ 0 }; // json::parse without time spent in network and inflate
+		uint64_t compressed_bytes{ 0 };
+		uint64_t decompressed_bytes{ 0 };
+	};
+
+	// Bucket upper bounds in microseconds, last bucket is +Inf
+	static constexpr std::array <uint64_t, 16> HISTOGRAM_BOUNDS_US = {
+		50, 100, 250, 500, 1000, 2500, 5000, 10000, 25000, 50000, 100000, 250000, 500000, 1000000, 2500000, 10000000
+	};
+
+	struct HistogramSnapshot
+	{
+		uint64_t count{ 0 };
+		uint64_t sum_us{ 0 };
+		std::array <uint64_t, HISTOGRAM_BOUNDS_US.size() + 1> buckets{}; // non cumulative
+
+		double Mean() const;
+		double Quantile(double q) const; // upper bound of bucket which contains q
+	};
+
+	class Histogram
+	{
+	public:
+		void Observe(uint64_t value_us);
+		HistogramSnapshot Snapshot() const;
+
+	private:
+		std::atomic <uint64_t> m_nCount{ 0 };
+		std::atomic <uint64_t> m_nSum{ 0 };
+		std::array <std::atomic <uint64_t>, HISTOGRAM_BOUNDS_US.size() + 1> m_nBuckets{};
+	};
+
+	struct EndpointMetricsSnapshot
+	{
+		std::string path;
+		uint64_t requests{ 0 };
+		std::map <int64_t /* ErrorCodes or REQUEST_FAILED_CODE */, uint64_t> responses;
+		uint64_t compressed_bytes{ 0 };
+		uint64_t decompressed_bytes{ 0 };
+
+		HistogramSnapshot network;
+		HistogramSnapshot inflate;
+		HistogramSnapshot parse;
+		HistogramSnapshot handle;
+	};
+
+	struct JobMetricsSnapshot
+	{
+		std::string name;
+		uint64_t runs{ 0 };
+		uint64_t failures{ 0 };
+		HistogramSnapshot duration;
+	};
+
+	// Process wide per endpoint path metrics, ids in paths are folded so cardinality stays bounded
+	class MetricsRegistry
+	{
+	public:
+		static MetricsRegistry& Instance();
+
+		MetricsRegistry(const MetricsRegistry&) = delete;
+		MetricsRegistry& operator=(const MetricsRegistry&) = delete;
+
+		static std::string NormalizePath(const std::string& url);
+
+		void RecordRequest(const std::string& url, const TransferMetrics& transfer, int64_t error_code);
+		void RecordHandle(uint64_t elapsed_us); // accounted to last request recorded on calling thread
+		void RecordJob(const std::string& name, uint64_t elapsed_us, bool succeeded); // background maintenance jobs
+
+		std::vector <EndpointMetricsSnapshot> GetSnapshot() const;
+		bool GetEndpointSnapshot(const std::string& path, EndpointMetricsSnapshot& out) const;
+		std::vector <JobMetricsSnapshot> GetJobSnapshot() const;
+		void Reset(); // only while no request or job is being recorded
+
+		std::string ToPrometheus() const;
+
+		// Rewrites file with Prometheus text every interval from a background thread
+		void StartDump(const std::string& path, std::chrono::seconds interval);
+		void StopDump();
+		bool WriteDump(const std::string& path) const;
+
+	protected:
+		MetricsRegistry() = default;
+		~MetricsRegistry();
+
+		struct EndpointMetrics;
+		struct JobMetrics;
+		EndpointMetrics& GetEndpoint(const std::string& path);
+
+		void DumpLoop(std::string path, std::chrono::seconds interval);
+
+	private:
+		mutable std::mutex m_pkMutex;
+		std::map <std::string /* path */, std::unique_ptr <EndpointMetrics>> m_pkEndpoints;
+		std::map <std::string /* job */, std::unique_ptr <JobMetrics>> m_pkJobs;
+
+		std::mutex m_pkDumpMutex;
+		std::condition_variable m_kDumpCondition;
+		std::thread m_kDumpThread;
+		bool m_bDumpRunning{ false };
+	};
+
+	// Times a response handler and accounts it to calling thread's last request
+	class ScopedHandleTimer
+	{
+	public:
+		ScopedHandleTimer() :
+			m_kBegin(std::chrono::steady_clock::now())
+		{
+		}
+		~ScopedHandleTimer()
+		{
+			MetricsRegistry::Instance().RecordHandle(static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - m_kBegin).count()));
+		}
+
+		ScopedHandleTimer(const ScopedHandleTimer&) = delete;
+		ScopedHandleTimer& operator=(const ScopedHandleTimer&) = delete;
+
+	private:
+		std::chrono::steady_clock::time_point m_kBegin;
+	};
+};
@@ -0,0 +1,118 @@
+#include "ObjectId.hpp"
+#include "Exception.hpp"
+
+#ifdef TARKOVAPI_OBJECTID_SSE2
+#include <emmintrin.h>
+#endif
+
+namespace TarkovAPI
+{
+#ifdef TARKOVAPI_OBJECTID_SSE2
+    // Nibble values of 16 hex characters, invalid lanes are reported in mask bits
+    static inline __m128i DecodeHex16(__m128i chars, int32_t& valid_mask)
+    {
+        const auto lower = _mm_or_si128(chars, _mm_set1_epi8(0x20));
+
+        // Signed compares, bytes >= 0x80 are negative and fall out of both ranges
+        const auto is_digit = _mm_and_si128(_mm_cmpgt_epi8(chars, _mm_set1_epi8('0' - 1)), _mm_cmplt_epi8(chars, _mm_set1_epi8('9' + 1)));
+        const auto is_alpha = _mm_and_si128(_mm_cmpgt_epi8(lower, _mm_set1_epi8('a' - 1)), _mm_cmplt_epi8(lower, _mm_set1_epi8('f' + 1)));
+
+        const auto digit = _mm_and_si128(is_digit, _mm_sub_epi8(chars, _mm_set1_epi8('0')));
+        const auto alpha = _mm_and_si128(is_alpha, _mm_sub_epi8(lower, _mm_set1_epi8('a' - 10)));
+
+        valid_mask = _mm_movemask_epi8(_mm_or_si128(is_digit, is_alpha));
+        return _mm_or_si128(digit, alpha);
+    }
+
+    // 16 bit lanes of (low nibble << 8 | high nibble) into one byte value per lane
+    static inline __m128i PackNibbles(__m128i nibbles)
+    {
+        const auto high = _mm_and_si128(_mm_slli_epi16(nibbles, 4), _mm_set1_epi16(0x00F0));
+        const auto low = _mm_srli_epi16(nibbles, 8);
+        return _mm_or_si128(high, low);
+    }
+
+    // Hex characters of nibble values 0..15
+    static inline __m128i EncodeHex16(__m128i nibbles)
+    {
+        const auto is_alpha = _mm_cmpgt_epi8(nibbles, _mm_set1_epi8(9));
+        const auto offset = _mm_add_epi8(_mm_set1_epi8('0'), _mm_and_si128(is_alpha, _mm_set1_epi8('a' - '0' - 10)));
+        return _mm_add_epi8(nibbles, offset);
+    }
+#endif
+
+    ObjectId::ObjectId(std::string_view hex)
+    {
+        if (!TryParse(hex, *this))
+        {
+            throw TarkovAPIException(Error::InvalidObjectId, std::string(hex));
+        }
+    }
+
+    bool ObjectId::TryParse(std::string_view hex, ObjectId& out)
+    {
+        if (hex.size() != HEX_LENGTH)
+        {
+            return false;
+        }
+
+#ifdef TARKOVAPI_OBJECTID_SSE2
+        int32_t head_mask = 0;
+        int32_t tail_mask = 0;
+        const auto head = DecodeHex16(_mm_loadu_si128(reinterpret_cast<const __m128i*>(hex.data())), head_mask);
+        const auto tail = DecodeHex16(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(hex.data() + 16)), tail_mask);
+
+        if (head_mask != 0xFFFF || (tail_mask & 0xFF) != 0xFF)
+        {
+            return false;
+        }
+
+        alignas(16) uint8_t bytes[16];
+        _mm_store_si128(reinterpret_cast<__m128i*>(bytes), _mm_packus_epi16(PackNibbles(head), PackNibbles(tail)));
+        std::memcpy(out.m_kBytes.data(), bytes, SIZE);
+#else
+        std::array <uint8_t, SIZE> bytes{};
+        for (size_t i = 0; i < SIZE; ++i)
+        {
+            auto high = DecodeNibble(hex[i * 2]);
+            auto low = DecodeNibble(hex[i * 2 + 1]);
+            if (high < 0 || low < 0)
+            {
+                return false;
+            }
+            bytes[i] = static_cast<uint8_t>((high << 4) | low);
+        }
+        out.m_kBytes = bytes;
+#endif
+        return true;
+    }
+
+    void ObjectId::Format(char* out) const
+    {
+#ifdef TARKOVAPI_OBJECTID_SSE2
+        alignas(16) uint8_t bytes[16]{};
+        std::memcpy(bytes, m_kBytes.data(), SIZE);
+
+        const auto value = _mm_load_si128(reinterpret_cast<const __m128i*>(bytes));
+        const auto high = _mm_and_si128(_mm_srli_epi16(value, 4), _mm_set1_epi8(0x0F));
+        const auto low = _mm_and_si128(value, _mm_set1_epi8(0x0F));
+
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out), EncodeHex16(_mm_unpacklo_epi8(high, low)));
+        _mm_storel_epi64(reinterpret_cast<__m128i*>(out + 16), EncodeHex16(_mm_unpackhi_epi8(high, low)));
+#else
+        static constexpr char digits[] = "0123456789abcdef";
+        for (size_t i = 0; i < SIZE; ++i)
+        {
+            out[i * 2] = digits[m_kBytes[i] >> 4];
+            out[i * 2 + 1] = digits[m_kBytes[i] & 0x0F];
+        }
+#endif
+    }
+
+    std::string ObjectId::ToString() const
+    {
+        std::string out(HEX_LENGTH, '\0');
+        Format(out.data());
+        return out;
+    }
+};
@@ -0,0 +1,131 @@
+#pragma once
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <string_view>
+#include <array>
+#include <stdexcept>
+#include <functional>
+
+#include <json.hpp>
+
+// Hex codec works on 16 characters per step where SSE2 is available, every x64 target has it
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define TARKOVAPI_OBJECTID_SSE2
+#endif
+
+namespace TarkovAPI
+{
+	using json = nlohmann::json;
+
+	// Backend object id (item _id/_tpl, parentId, trader, offer and assort ids) in its 12 byte binary form
+	// Text form is 24 hex characters, parsed case insensitive and formatted in lower case as the backend does
+	class ObjectId
+	{
+	public:
+		static constexpr size_t SIZE = 12;
+		static constexpr size_t HEX_LENGTH = SIZE * 2;
+
+	public:
+		constexpr ObjectId() = default;
+		explicit ObjectId(std::string_view hex); // throws Error::InvalidObjectId
+
+		static bool TryParse(std::string_view hex, ObjectId& out); // out is untouched on failure
+		static constexpr ObjectId FromLiteral(const char (&hex)[HEX_LENGTH + 1]); // compile time, for constants
+
+		std::string ToString() const;
+		void Format(char* out) const; // writes HEX_LENGTH characters, no terminator
+
+		constexpr bool IsNull() const
+		{
+			for (auto byte : m_kBytes)
+			{
+				if (byte)
+				{
+					return false;
+				}
+			}
+			return true;
+		}
+
+		const uint8_t* GetBytes() const
+		{
+			return m_kBytes.data();
+		}
+
+		size_t GetHash() const
+		{
+			// Leading 4 bytes are a timestamp shared by ids of one batch, trailing 8 bytes are random and counter
+			uint64_t low = 0;
+			uint32_t high = 0;
+			std::memcpy(&low, m_kBytes.data() + 4, sizeof(low));
+			std::memcpy(&high, m_kBytes.data(), sizeof(high));
+
+			auto hash = (low ^ (static_cast<uint64_t>(high) * 0x9E3779B97F4A7C15ull)) * 0xFF51AFD7ED558CCDull;
+			return static_cast<size_t>(hash ^ (hash >> 32));
+		}
+
+		bool operator==(const ObjectId& other) const
+		{
+			return std::memcmp(m_kBytes.data(), other.m_kBytes.data(), SIZE) == 0;
+		}
+		bool operator!=(const ObjectId& other) const
+		{
+			return !(*this == other);
+		}
+		// Same order as the hex strings
+		bool operator<(const ObjectId& other) const
+		{
+			return std::memcmp(m_kBytes.data(), other.m_kBytes.data(), SIZE) < 0;
+		}
+
+	private:
+		static constexpr int32_t DecodeNibble(char c)
+		{
+			return (c >= '0' && c <= '9') ? (c - '0') :
+				(c >= 'a' && c <= 'f') ? (c - 'a' + 10) :
+				(c >= 'A' && c <= 'F') ? (c - 'A' + 10) : -1;
+		}
+
+	private:
+		std::array <uint8_t, SIZE> m_kBytes{};
+	};
+
+	constexpr ObjectId ObjectId::FromLiteral(const char (&hex)[HEX_LENGTH + 1])
+	{
+		ObjectId id{};
+		for (size_t i = 0; i < SIZE; ++i)
+		{
+			auto high = DecodeNibble(hex[i * 2]);
+			auto low = DecodeNibble(hex[i * 2 + 1]);
+			if (high < 0 || low < 0)
+			{
+				throw std::invalid_argument("ObjectId literal is not hex"); // not a constant expression, fails the build
+			}
+			id.m_kBytes[i] = static_cast<uint8_t>((high << 4) | low);
+		}
+		return id;
+	}
+
+	inline void to_json(json& j, const ObjectId& x)
+	{
+		j = x.ToString();
+	}
+
+	inline void from_json(const json& j, ObjectId& x)
+	{
+		x = ObjectId(j.get_ref<const std::string&>());
+	}
+};
+
+namespace std
+{
+	template <>
+	struct hash <TarkovAPI::ObjectId>
+	{
+		size_t operator()(const TarkovAPI::ObjectId& id) const noexcept
+		{
+			return id.GetHash();
+		}
+	};
+};
@@ -0,0 +1,393 @@
+#include "RequestScheduler.hpp"
+#include "HttpClient.hpp"
+#include <algorithm>
+#include <set>
+
+namespace TarkovAPI
+{
+    struct RequestScheduler::HostState
+    {
+        RateBudget budget;
+        uint64_t budget_version{ UINT64_MAX };
+        double tokens{ 0.0 };
+        std::chrono::steady_clock::time_point last_refill;
+        std::chrono::steady_clock::time_point cooldown_until;
+        std::atomic <uint32_t> in_flight{ 0 };
+    };
+
+    void MpscQueue::Push(MpscNode* node)
+    {
+        node->next.store(nullptr, std::memory_order_relaxed);
+        auto prev = m_pkHead.exchange(node, std::memory_order_acq_rel);
+        prev->next.store(node, std::memory_order_release);
+    }
+
+    MpscNode* MpscQueue::Pop()
+    {
+        auto tail = m_pkTail;
+        auto next = tail->next.load(std::memory_order_acquire);
+
+        if (tail == &m_kStub)
+        {
+            if (!next)
+            {
+                return nullptr;
+            }
+            m_pkTail = next;
+            tail = next;
+            next = next->next.load(std::memory_order_acquire);
+        }
+
+        if (next)
+        {
+            m_pkTail = next;
+            return tail;
+        }
+
+        if (tail != m_pkHead.load(std::memory_order_acquire))
+        {
+            return nullptr;
+        }
+
+        // Last node can only be handed out once stub is queued behind it
+        Push(&m_kStub);
+
+        next = tail->next.load(std::memory_order_acquire);
+        if (next)
+        {
+            m_pkTail = next;
+            return tail;
+        }
+        return nullptr;
+    }
+
+
+    RequestScheduler::Ticket::Ticket(RequestScheduler* scheduler, RequestPriority priority, const std::string& url, bool pooled) :
+        m_pkScheduler(scheduler)
+    {
+        m_kWaiter.host = HttpClientPool::GetHostKey(url);
+        m_kWaiter.priority = priority;
+        m_kWaiter.pooled = pooled;
+
+        if (m_pkScheduler->Enqueue(&m_kWaiter))
+        {
+            m_bScheduled = true;
+
+            std::unique_lock <std::mutex> lock(m_pkScheduler->m_pkAdmitMutex);
+            m_pkScheduler->m_kAdmitCondition.wait(lock, [this] { return m_kWaiter.admitted; });
+        }
+    }
+
+    RequestScheduler::Ticket::~Ticket()
+    {
+        if (m_bScheduled)
+        {
+            m_pkScheduler->Release(&m_kWaiter);
+        }
+    }
+
+
+    RequestScheduler::RequestScheduler(uint32_t max_in_flight) :
+        m_nMaxInFlight(std::max(1u, max_in_flight))
+    {
+        m_kDispatcher = std::thread(&RequestScheduler::DispatchLoop, this);
+    }
+
+    RequestScheduler::~RequestScheduler()
+    {
+        Stop();
+    }
+
+    void RequestScheduler::SetDefaultBudget(const RateBudget& budget)
+    {
+        {
+            std::lock_guard <std::mutex> lock(m_pkBudgetMutex);
+            m_kDefaultBudget = budget;
+            m_nBudgetVersion++;
+        }
+        Wake();
+    }
+
+    void RequestScheduler::SetHostBudget(const std::string& url, const RateBudget& budget)
+    {
+        {
+            std::lock_guard <std::mutex> lock(m_pkBudgetMutex);
+            m_pkHostBudgets[HttpClientPool::GetHostKey(url)] = budget;
+            m_nBudgetVersion++;
+        }
+        Wake();
+    }
+
+    void RequestScheduler::OnRateLimited(const std::string& url)
+    {
+        std::lock_guard <std::mutex> lock(m_pkBudgetMutex);
+
+        auto host = HttpClientPool::GetHostKey(url);
+        auto budget_it = m_pkHostBudgets.find(host);
+        auto cooldown = (budget_it != m_pkHostBudgets.end()) ? budget_it->second.rate_limited_cooldown : m_kDefaultBudget.rate_limited_cooldown;
+
+        m_pkCooldowns[host] = std::chrono::steady_clock::now() + cooldown;
+        m_nBudgetVersion++;
+    }
+
+    void RequestScheduler::AcquireAsync(RequestPriority priority, const std::string& url, std::function<void()> on_admitted)
+    {
+        auto waiter = std::make_unique<Waiter>();
+        waiter->host = HttpClientPool::GetHostKey(url);
+        waiter->priority = priority;
+        waiter->pooled = false;
+        waiter->on_admitted = std::move(on_admitted);
+
+        if (Enqueue(waiter.get()))
+        {
+            waiter.release(); // deleted by Admit
+            return;
+        }
+        waiter->on_admitted();
+    }
+
+    void RequestScheduler::Stop()
+    {
+        m_bRunning = false;
+        Wake();
+
+        if (m_kDispatcher.joinable())
+        {
+            m_kDispatcher.join();
+        }
+    }
+
+    uint64_t RequestScheduler::GetQueuedCount() const
+    {
+        return m_nQueued.load(std::memory_order_relaxed);
+    }
+
+    uint64_t RequestScheduler::GetAdmittedCount(RequestPriority priority) const
+    {
+        return m_nAdmitted[static_cast<size_t>(priority)].load(std::memory_order_relaxed);
+    }
+
+    bool RequestScheduler::Enqueue(Waiter* waiter)
+    {
+        // Dispatcher does its final drain only after every in progress Enqueue is done
+        m_nSubmitting++;
+        if (!m_bRunning)
+        {
+            m_nSubmitting--;
+            return false;
+        }
+
+        m_nQueued++;
+        m_kQueues[static_cast<size_t>(waiter->priority)].Push(waiter);
+        m_nSubmitting--;
+
+        Wake();
+        return true;
+    }
+
+    void RequestScheduler::Release(Waiter* waiter)
+    {
+        if (waiter->state)
+        {
+            waiter->state->in_flight--;
+            Wake();
+        }
+    }
+
+    void RequestScheduler::Admit(Waiter* waiter)
+    {
+        if (waiter->on_admitted)
+        {
+            auto on_admitted = std::move(waiter->on_admitted);
+            delete waiter;
+
+            try
+            {
+                on_admitted();
+            }
+            catch (...)
+            {
+                // Exceptions must not stop dispatcher
+            }
+            return;
+        }
+
+        // Waiter lives on caller's stack, it must not be touched once admitted is visible
+        {
+            std::lock_guard <std::mutex> lock(m_pkAdmitMutex);
+            waiter->admitted = true;
+        }
+        m_kAdmitCondition.notify_all();
+    }
+
+    void RequestScheduler::Wake()
+    {
+        {
+            std::lock_guard <std::mutex> lock(m_pkWakeMutex);
+            m_bWake = true;
+        }
+        m_kWakeCondition.notify_one();
+    }
+
+    void RequestScheduler::DrainQueues()
+    {
+        for (size_t i = 0; i < static_cast<size_t>(RequestPriority::Count); ++i)
+        {
+            while (auto node = m_kQueues[i].Pop())
+            {
+                m_vPending[i].emplace_back(static_cast<Waiter*>(node));
+            }
+        }
+    }
+
+    RequestScheduler::HostState& RequestScheduler::GetHostState(const std::string& host)
+    {
+        auto& state = m_pkHosts[host];
+        if (!state)
+        {
+            state = std::make_unique<HostState>();
+            state->last_refill = std::chrono::steady_clock::now();
+        }
+        return *state;
+    }
+
+    bool RequestScheduler::TryAdmit(Waiter* waiter, std::chrono::steady_clock::time_point now, std::chrono::steady_clock::time_point& next_refill)
+    {
+        auto& state = GetHostState(waiter->host);
+
+        auto budget_version = m_nBudgetVersion.load();
+        if (state.budget_version != budget_version)
+        {
+            std::lock_guard <std::mutex> lock(m_pkBudgetMutex);
+
+            auto budget_it = m_pkHostBudgets.find(waiter->host);
+            auto first_seen = (state.budget_version == UINT64_MAX);
+            state.budget = (budget_it != m_pkHostBudgets.end()) ? budget_it->second : m_kDefaultBudget;
+            state.budget_version = budget_version;
+            if (first_seen)
+            {
+                state.tokens = state.budget.burst;
+            }
+
+            auto cooldown_it = m_pkCooldowns.find(waiter->host);
+            if (cooldown_it != m_pkCooldowns.end() && cooldown_it->second != state.cooldown_until)
+            {
+                state.cooldown_until = cooldown_it->second;
+                state.tokens = std::min(state.tokens, 0.0);
+            }
+        }
+
+        if (waiter->pooled && state.in_flight >= m_nMaxInFlight)
+        {
+            return false; // Release wakes dispatcher
+        }
+
+        if (now < state.cooldown_until)
+        {
+            state.last_refill = now;
+        }
+        else if (state.budget.requests_per_second > 0.0)
+        {
+            auto elapsed = std::chrono::duration<double>(now - state.last_refill).count();
+            state.tokens = std::min(state.budget.burst, state.tokens + elapsed * state.budget.requests_per_second);
+            state.last_refill = now;
+        }
+        else
+        {
+            state.tokens = std::max(state.tokens, 1.0); // unlimited
+        }
+
+        if (waiter->priority != RequestPriority::Session)
+        {
+            if (now < state.cooldown_until)
+            {
+                next_refill = std::min(next_refill, state.cooldown_until);
+                return false;
+            }
+            if (state.tokens < 1.0)
+            {
+                auto wait = std::chrono::duration<double>((1.0 - state.tokens) / state.budget.requests_per_second);
+                next_refill = std::min(next_refill, now + std::chrono::duration_cast<std::chrono::steady_clock::duration>(wait));
+                return false;
+            }
+        }
+
+        state.tokens -= 1.0; // session requests may overdraw
+        if (waiter->pooled)
+        {
+            state.in_flight++;
+            waiter->state = &state;
+        }
+
+        m_nQueued--;
+        m_nAdmitted[static_cast<size_t>(waiter->priority)]++;
+
+        Admit(waiter);
+        return true;
+    }
+
+    void RequestScheduler::DispatchLoop()
+    {
+        auto deadline = std::chrono::steady_clock::now();
+
+        while (true)
+        {
+            {
+                std::unique_lock <std::mutex> lock(m_pkWakeMutex);
+                m_kWakeCondition.wait_until(lock, deadline, [this] { return m_bWake; });
+                m_bWake = false;
+            }
+
+            if (!m_bRunning)
+            {
+                break;
+            }
+
+            DrainQueues();
+
+            auto now = std::chrono::steady_clock::now();
+            auto next_refill = now + std::chrono::seconds(1);
+
+            // A host held back for a higher class keeps its tokens for that class
+            auto blocked_hosts = std::set <std::string>();
+            for (auto& pending : m_vPending)
+            {
+                for (auto it = pending.begin(); it != pending.end();)
+                {
+                    if (blocked_hosts.count((*it)->host))
+                    {
+                        ++it;
+                    }
+                    else if (TryAdmit(*it, now, next_refill))
+                    {
+                        it = pending.erase(it);
+                    }
+                    else
+                    {
+                        blocked_hosts.emplace((*it)->host);
+                        ++it;
+                    }
+                }
+            }
+
+            deadline = next_refill;
+        }
+
+        // Nobody may be left waiting, everything queued runs unscheduled
+        while (m_nSubmitting)
+        {
+            std::this_thread::yield();
+        }
+        DrainQueues();
+
+        for (auto& pending : m_vPending)
+        {
+            for (auto waiter : pending)
+            {
+                m_nQueued--;
+                Admit(waiter);
+            }
+            pending.clear();
+        }
+    }
+};
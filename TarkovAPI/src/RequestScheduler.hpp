@@ -0,0 +1,160 @@
+#pragma once
+#include <cstdint>
+#include <string>
+#include <map>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <atomic>
+#include <thread>
+#include <functional>
+#include <chrono>
+#include <condition_variable>
+
+namespace TarkovAPI
+{
+	enum class RequestPriority : uint8_t
+	{
+		Session,		// KeepAlive, profile select; always admitted first, may overdraw budget
+		Interactive,	// Trading, moving, market actions
+		Bulk,			// Price sweeps, item/locale/location dumps
+		Count
+	};
+
+	// Token bucket per endpoint host
+	struct RateBudget
+	{
+		double requests_per_second{ 5.0 };
+		double burst{ 10.0 };
+		std::chrono::milliseconds rate_limited_cooldown{ 5000 }; // no tokens are refilled after server answered RateLimited
+	};
+
+	struct MpscNode
+	{
+		std::atomic <MpscNode*> next{ nullptr };
+	};
+
+	// Intrusive multi producer, single consumer queue (D. Vyukov); Push is wait-free, Pop is for consumer thread only
+	class MpscQueue
+	{
+	public:
+		MpscQueue() :
+			m_pkHead(&m_kStub), m_pkTail(&m_kStub)
+		{
+		}
+
+		MpscQueue(const MpscQueue&) = delete;
+		MpscQueue& operator=(const MpscQueue&) = delete;
+
+		void Push(MpscNode* node);
+		MpscNode* Pop(); // nullptr when empty or a producer is between its two Push steps
+
+	private:
+		std::atomic <MpscNode*> m_pkHead;
+		MpscNode* m_pkTail;
+		MpscNode m_kStub;
+	};
+
+	// Admission control in front of blocking requests
+	// Callers are queued per priority class; dispatcher thread admits them in priority order while their host has budget,
+	// request itself still runs on calling thread
+	class RequestScheduler
+	{
+	public:
+		// max_in_flight is how many pooled requests of a host may run at once, one per client the pool keeps for a host
+		explicit RequestScheduler(uint32_t max_in_flight = 1);
+		virtual ~RequestScheduler();
+
+		RequestScheduler(const RequestScheduler&) = delete;
+		RequestScheduler& operator=(const RequestScheduler&) = delete;
+
+		// Budget changes apply to hosts seen later and to already known hosts
+		void SetDefaultBudget(const RateBudget& budget);
+		void SetHostBudget(const std::string& url, const RateBudget& budget);
+
+		// Starts cooldown of url's host, call when server answered RateLimited
+		void OnRateLimited(const std::string& url);
+
+		template <typename F>
+		auto Run(RequestPriority priority, const std::string& url, F&& request) -> decltype(request())
+		{
+			Ticket ticket(this, priority, url);
+			return request();
+		}
+
+		// Calls on_admitted once a token of url's host is available, without taking an in flight slot; for requests not sent on pooled HttpClient (AsyncHttpClient)
+		// Caller doesn't wait, on_admitted runs on dispatcher thread and should only hand request off; it runs on calling thread when scheduler is stopped
+		void AcquireAsync(RequestPriority priority, const std::string& url, std::function<void()> on_admitted);
+
+		void Stop(); // admits everything queued, later requests run unscheduled
+
+		uint64_t GetQueuedCount() const;
+		uint64_t GetAdmittedCount(RequestPriority priority) const;
+
+	protected:
+		struct HostState;
+
+		struct Waiter : MpscNode
+		{
+			std::string host;
+			RequestPriority priority;
+			bool pooled{ true }; // holds an in flight slot until released
+			HostState* state{ nullptr }; // set by dispatcher before admission of pooled waiters
+			std::function<void()> on_admitted; // async waiters are owned by scheduler and deleted on admission
+			bool admitted{ false }; // guarded by m_pkAdmitMutex
+		};
+
+		// Waits for admission on construction, gives in flight slot back on destruction
+		class Ticket
+		{
+		public:
+			Ticket(RequestScheduler* scheduler, RequestPriority priority, const std::string& url, bool pooled = true);
+			~Ticket();
+
+			Ticket(const Ticket&) = delete;
+			Ticket& operator=(const Ticket&) = delete;
+
+		private:
+			RequestScheduler* m_pkScheduler;
+			Waiter m_kWaiter;
+			bool m_bScheduled{ false };
+		};
+
+		bool Enqueue(Waiter* waiter); // false when scheduler is stopped
+		void Release(Waiter* waiter);
+		void Admit(Waiter* waiter);
+		void Wake();
+
+		void DispatchLoop();
+		void DrainQueues();
+		bool TryAdmit(Waiter* waiter, std::chrono::steady_clock::time_point now, std::chrono::steady_clock::time_point& next_refill);
+		HostState& GetHostState(const std::string& host);
+
+	private:
+		const uint32_t m_nMaxInFlight;
+
+		MpscQueue m_kQueues[static_cast<size_t>(RequestPriority::Count)];
+		std::deque <Waiter*> m_vPending[static_cast<size_t>(RequestPriority::Count)]; // dispatcher thread only
+		std::map <std::string /* host */, std::unique_ptr <HostState>> m_pkHosts; // dispatcher thread only
+
+		mutable std::mutex m_pkBudgetMutex;
+		RateBudget m_kDefaultBudget;
+		std::map <std::string /* host */, RateBudget> m_pkHostBudgets;
+		std::map <std::string /* host */, std::chrono::steady_clock::time_point> m_pkCooldowns;
+		std::atomic <uint64_t> m_nBudgetVersion{ 0 };
+
+		std::mutex m_pkAdmitMutex;
+		std::condition_variable m_kAdmitCondition;
+
+		std::mutex m_pkWakeMutex;
+		std::condition_variable m_kWakeCondition;
+		bool m_bWake{ false };
+
+		std::atomic <bool> m_bRunning{ true };
+		std::atomic <uint32_t> m_nSubmitting{ 0 };
+		std::atomic <uint64_t> m_nQueued{ 0 };
+		std::atomic <uint64_t> m_nAdmitted[static_cast<size_t>(RequestPriority::Count)]{};
+
+		std::thread m_kDispatcher;
+	};
+};
@@ -4,15 +4,30 @@
 #include <iostream>
 #include <algorithm>
 
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+#include "Exception.hpp"
+
 namespace TarkovAPI
 {
+	// Occupancy of a container grid, one 64 bit mask per row where bit x is column x
+	// Positions are 1-based row major cells: stash_pos = y * width + x + 1
 	class StashHelper
 	{
+	public:
+		static constexpr int32_t MAX_WIDTH = 64;
+
 	public:
 		StashHelper(int32_t width, int32_t height) :
-      		m_nWidth(width), m_nHeight(height)
+			m_nWidth(width), m_nHeight(height)
 		{
-			m_pkVecGrids.resize((width * height) + 1);
+			if (width <= 0 || width > MAX_WIDTH || height <= 0)
+			{
+				throw TarkovAPIException(Error::InvalidParameter, fmt::format("Grid size: {}x{}", width, height));
+			}
+			m_vRows.resize(height);
 		}
 		~StashHelper()
 		{
@@ -21,22 +36,27 @@ namespace TarkovAPI
 
 		void Reset()
 		{
-			std::fill(m_pkVecGrids.begin(), m_pkVecGrids.end(), false);
+			std::fill(m_vRows.begin(), m_vRows.end(), 0);
 		}
 
-		int32_t GetWidth()
+		int32_t GetWidth() const
 		{
 			return m_nWidth;
 		}
-		int32_t GetHeight()
+		int32_t GetHeight() const
 		{
 			return m_nHeight;
 		}
-		int32_t GetSize()
+		int32_t GetSize() const
 		{
 			return m_nWidth * m_nHeight;
 		}
 
+		int32_t GetStashPos(int32_t x, int32_t y) const
+		{
+			return y * m_nWidth + x + 1;
+		}
+
 		void Dump()
 		{
 			std::cout << "Grid " << m_nWidth << "x" << m_nHeight << " Information" << std::endl;
@@ -44,8 +64,8 @@ namespace TarkovAPI
 			for (auto row = 0; row < m_nHeight; ++row)
 			{
 				for (auto col = 0; col < m_nWidth; ++col)
-				{       
-					if (m_pkVecGrids[row * m_nWidth + col])
+				{
+					if (m_vRows[row] & (1ull << col))
 						std::cout << "\tX";
 					else
 						std::cout << "\tO";
@@ -54,39 +74,157 @@ namespace TarkovAPI
 			}
 		}
 
-		bool IsEmpty(int32_t stash_pos, int32_t item_width, int32_t item_height)
+		// False when area is occupied or out of grid
+		bool IsEmpty(int32_t stash_pos, int32_t item_width, int32_t item_height) const
 		{
-			return false;        
+			int32_t x = 0, y = 0;
+			if (!GetArea(stash_pos, item_width, item_height, x, y))
+			{
+				return false;
+			}
+
+			const auto mask = GetRowMask(item_width) << x;
+			for (auto row = y; row < y + item_height; ++row)
+			{
+				if (m_vRows[row] & mask)
+				{
+					return false;
+				}
+			}
+			return true;
 		}
 
-		int32_t FindBlank(int32_t item_width, int32_t item_height)
+		// First fit in row major order, -1 when item does not fit anywhere
+		int32_t FindBlank(int32_t item_width, int32_t item_height) const
 		{
+			if (item_width <= 0 || item_width > m_nWidth || item_height <= 0 || item_height > m_nHeight)
+			{
+				return -1;
+			}
+
+			for (auto row = 0; row + item_height <= m_nHeight; ++row)
+			{
+				auto fits = FindBlankInRow(row, item_width, item_height);
+				if (fits)
+				{
+					return GetStashPos(CountTrailingZeros(fits), row);
+				}
+			}
 			return -1;
 		}
 
-		bool Put(int32_t stash_pos, int32_t item_width, int32_t item_height)
+		// Bit x is set when item fits with its top-left cell at (x, row)
+		uint64_t FindBlankInRow(int32_t row, int32_t item_width, int32_t item_height) const
 		{
-			stash_pos--;
+			if (row < 0 || item_width <= 0 || item_width > m_nWidth || item_height <= 0 || row + item_height > m_nHeight)
+			{
+				return 0;
+			}
+
+			// Bit x of a row start mask is set when item_width cells from x on are free, item fits where item_height rows agree
+			auto fits = GetRowMask(m_nWidth);
+			for (auto i = 0; fits && i < item_height; ++i)
+			{
+				fits &= GetRunStarts(~m_vRows[row + i] & GetRowMask(m_nWidth), item_width);
+			}
+			return fits;
+		}
 
-			auto xs = stash_pos % m_nWidth;
-			auto ys = stash_pos / m_nWidth;
+		// Also tries item turned by 90 degrees, earliest position wins and unrotated one on a tie
+		int32_t FindBlank(int32_t item_width, int32_t item_height, bool& rotated) const
+		{
+			auto pos = FindBlank(item_width, item_height);
+			rotated = false;
 
-			for(auto x = xs; x < xs + item_width;x++)
+			if (item_width != item_height)
 			{
-				for(auto y = ys; y < ys + item_height;y++)
+				auto rotated_pos = FindBlank(item_height, item_width);
+				if (rotated_pos != -1 && (pos == -1 || rotated_pos < pos))
 				{
-					m_pkVecGrids[y * m_nWidth + x] = true;
+					pos = rotated_pos;
+					rotated = true;
 				}
 			}
+			return pos;
+		}
+
+		// Overlapping items are allowed, grid mirrors what server reports; false when area is out of grid
+		bool Put(int32_t stash_pos, int32_t item_width, int32_t item_height)
+		{
+			int32_t x = 0, y = 0;
+			if (!GetArea(stash_pos, item_width, item_height, x, y))
+			{
+				return false;
+			}
+
+			const auto mask = GetRowMask(item_width) << x;
+			for (auto row = y; row < y + item_height; ++row)
+			{
+				m_vRows[row] |= mask;
+			}
 			return true;
 		}
 
 		void Clear(int32_t stash_pos, int32_t item_width, int32_t item_height)
 		{
+			int32_t x = 0, y = 0;
+			if (!GetArea(stash_pos, item_width, item_height, x, y))
+			{
+				return;
+			}
+
+			const auto mask = GetRowMask(item_width) << x;
+			for (auto row = y; row < y + item_height; ++row)
+			{
+				m_vRows[row] &= ~mask;
+			}
+		}
+
+		// Index of lowest set bit, value must not be 0
+		static int32_t CountTrailingZeros(uint64_t value)
+		{
+#ifdef _MSC_VER
+			unsigned long index = 0;
+			_BitScanForward64(&index, value);
+			return static_cast<int32_t>(index);
+#else
+			return __builtin_ctzll(value);
+#endif
+		}
+
+	protected:
+		bool GetArea(int32_t stash_pos, int32_t item_width, int32_t item_height, int32_t& x, int32_t& y) const
+		{
+			if (stash_pos <= 0 || item_width <= 0 || item_height <= 0)
+			{
+				return false;
+			}
+
+			x = (stash_pos - 1) % m_nWidth;
+			y = (stash_pos - 1) / m_nWidth;
+			return x + item_width <= m_nWidth && y + item_height <= m_nHeight;
+		}
+
+		static uint64_t GetRowMask(int32_t width)
+		{
+			return (width >= MAX_WIDTH) ? ~0ull : ((1ull << width) - 1);
+		}
+
+		// Doubling shifts, log2(run) steps instead of one per cell
+		static uint64_t GetRunStarts(uint64_t free, int32_t run)
+		{
+			auto covered = 1;
+			while (covered < run)
+			{
+				auto step = std::min(covered, run - covered);
+				free &= free >> step;
+				covered += step;
+			}
+			return free;
 		}
 
 	private:
-		std::vector <bool> m_pkVecGrids;
-    	int32_t m_nWidth, m_nHeight;
+		std::vector <uint64_t> m_vRows;
+		int32_t m_nWidth, m_nHeight;
 	};
-}
\ No newline at end of file
+}
@@ -4,7 +4,13 @@
 #include "LogHelper.hpp"
 #include "Constants.hpp"
 #include "Exception.hpp"
+#include "Trace.hpp"
 #include <cassert>
+#include <algorithm>
+#include <deque>
+#include <thread>
+#include <condition_variable>
+#include <cstdlib>
 #include <json.hpp>
 
 namespace TarkovAPI
@@ -27,7 +33,11 @@ namespace TarkovAPI
         assert(!gs_pAPIInstance);
 
         gs_pAPIInstance = this;
-        m_pkClient = nullptr;
+        m_pkClientPool = nullptr;
+        m_pkAsyncClient = nullptr;
+        m_pkScheduler = nullptr;
+        m_pkTimerService = nullptr;
+        m_pkDataCache = nullptr;
     }
     TarkovAPIManager::~TarkovAPIManager()
     {
@@ -50,25 +60,179 @@ namespace TarkovAPI
             return false;
         }
 
-        m_pkClient = new cpr::Session();
-        if (!m_pkClient)
+        auto endpoint_override = std::getenv(ENDPOINT_OVERRIDE_ENV);
+        if (endpoint_override && *endpoint_override)
         {
-            gs_pAPILogInstance->Log(__FUNCTION__, LL_ERR, "CURL Session could not created!");
+            OverrideEndpoints(endpoint_override);
+            gs_pAPILogInstance->Log(__FUNCTION__, LL_SYS, fmt::format("Endpoints redirected to: {}", endpoint_override));
+        }
+
+        m_pkClientPool = new HttpClientPool();
+        if (!m_pkClientPool)
+        {
+            gs_pAPILogInstance->Log(__FUNCTION__, LL_ERR, "CURL Session pool could not created!");
+            return false;
+        }
+
+        m_pkAsyncClient = new AsyncHttpClient();
+        if (!m_pkAsyncClient)
+        {
+            gs_pAPILogInstance->Log(__FUNCTION__, LL_ERR, "Async CURL client could not created!");
+            return false;
+        }
+
+        auto capture_path = std::getenv(CAPTURE_ENV);
+        if (capture_path && *capture_path)
+        {
+            EnableCapture(capture_path);
+        }
+        auto replay_path = std::getenv(REPLAY_ENV);
+        if (replay_path && *replay_path)
+        {
+            EnableReplay(replay_path);
+        }
+        auto metrics_path = std::getenv(METRICS_ENV);
+        if (metrics_path && *metrics_path)
+        {
+            EnableMetricsDump(metrics_path);
+        }
+        auto trace_path = std::getenv(TRACE_ENV);
+        if (trace_path && *trace_path)
+        {
+            EnableTrace(trace_path);
+        }
+        auto data_cache_directory = std::getenv(DATA_CACHE_ENV);
+        if (data_cache_directory && *data_cache_directory)
+        {
+            SetDataCacheDirectory(data_cache_directory);
+        }
+
+        m_pkScheduler = new RequestScheduler(HttpClientPool::CLIENTS_PER_HOST);
+        if (!m_pkScheduler)
+        {
+            gs_pAPILogInstance->Log(__FUNCTION__, LL_ERR, "Request scheduler could not created!");
+            return false;
+        }
+
+        m_pkTimerService = new TimerService();
+        if (!m_pkTimerService)
+        {
+            gs_pAPILogInstance->Log(__FUNCTION__, LL_ERR, "Timer service could not created!");
             return false;
         }
 
-        auth::CheckLauncherVersion(m_pkClient);
-        auth::CheckGameVersion(m_pkClient);
+        auto startup_begin = std::chrono::steady_clock::now();
+
+        // Game hosts are warmed up while launcher host checks versions, a pooled client is used by one thread only
+        auto launcher_host = HttpClientPool::GetHostKey(LAUNCHER_ENDPOINT);
+        auto prewarm_hosts = std::vector <std::string>();
+        for (const auto& endpoint : { PROD_ENDPOINT, TRADING_ENDPOINT, RAGFAIR_ENDPOINT })
+        {
+            auto host = HttpClientPool::GetHostKey(endpoint);
+            if (host != launcher_host && std::find(prewarm_hosts.begin(), prewarm_hosts.end(), host) == prewarm_hosts.end())
+            {
+                prewarm_hosts.emplace_back(host);
+            }
+        }
+
+        auto prewarms = std::vector <std::future <bool>>();
+        for (const auto& host : prewarm_hosts)
+        {
+            auto client = m_pkClientPool->Acquire(host);
+            prewarms.emplace_back(std::async(std::launch::async, [client, host] { return client->Prewarm(host); }));
+        }
+
+        auto versions_cached = m_nVersionCacheTTL.count() > 0 && auth::LoadVersionCache(VERSION_CACHE_FILENAME, m_nVersionCacheTTL);
+        if (!versions_cached)
+        {
+            // Game version query needs the launcher version
+            auth::CheckLauncherVersion(m_pkClientPool->Acquire(LAUNCHER_ENDPOINT));
+            auth::CheckGameVersion(m_pkClientPool->Acquire(LAUNCHER_ENDPOINT));
+
+            if (m_nVersionCacheTTL.count() > 0)
+            {
+                auth::SaveVersionCache(VERSION_CACHE_FILENAME);
+            }
+        }
+
+        // Static data of other game versions is dropped, so cache is opened after version checks
+        if (!m_stDataCacheDirectory.empty())
+        {
+            m_pkDataCache = new GameDataCache(m_stDataCacheDirectory, GAME_VERSION);
+            if (!m_pkDataCache)
+            {
+                gs_pAPILogInstance->Log(__FUNCTION__, LL_ERR, "Game data cache could not created!");
+                return false;
+            }
+            gs_pAPILogInstance->Log(__FUNCTION__, LL_SYS, fmt::format("Game data cache: {} ({} entries)", m_pkDataCache->GetDirectory(), m_pkDataCache->GetEntryCount()));
+        }
+
+        auto warmed = size_t(0);
+        for (size_t i = 0; i < prewarms.size(); ++i)
+        {
+            if (prewarms[i].get())
+            {
+                warmed++;
+                continue;
+            }
+            gs_pAPILogInstance->Log(__FUNCTION__, LL_ERR, fmt::format("Connection to {} could not warmed up", prewarm_hosts[i]));
+        }
 
+        auto startup_ms = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - startup_begin).count();
+        gs_pAPILogInstance->Log(__FUNCTION__, LL_SYS, fmt::format("Startup took {} ms, versions {}, {} hosts warmed up", startup_ms, versions_cached ? "cached" : "checked", warmed));
         gs_pAPILogInstance->Log(__FUNCTION__, LL_SYS, fmt::format("API Manager Initialized! Build: {}", __TIMESTAMP__));
         return true;
     }
     bool TarkovAPIManager::FinalizeTarkovAPIManager()
     {
-        if (m_pkClient)
+        // Jobs use every other service, they go first
+        if (m_pkTimerService)
+        {
+            m_vMaintenanceJobs.clear();
+
+            delete m_pkTimerService;
+            m_pkTimerService = nullptr;
+        }
+
+        MetricsRegistry::Instance().StopDump();
+
+        if (!m_stTracePath.empty())
+        {
+            if (!TraceCollector::Instance().WriteJson(m_stTracePath))
+            {
+                Log(__FUNCTION__, LL_ERR, fmt::format("Trace could not written to: {}", m_stTracePath));
+            }
+            m_stTracePath.clear();
+        }
+
+        // Requests waiting for admission are handed to async client, then its loop thread is joined; completion callbacks still use scheduler
+        if (m_pkScheduler)
+        {
+            m_pkScheduler->Stop();
+        }
+        if (m_pkAsyncClient)
         {
-            delete m_pkClient;
-            m_pkClient = nullptr;
+            delete m_pkAsyncClient;
+            m_pkAsyncClient = nullptr;
+        }
+        if (m_pkScheduler)
+        {
+            delete m_pkScheduler;
+            m_pkScheduler = nullptr;
+        }
+        if (m_pkDataCache)
+        {
+            delete m_pkDataCache;
+            m_pkDataCache = nullptr;
+        }
+        if (m_pkClientPool)
+        {
+            auto stats = m_pkClientPool->GetStats();
+            Log(__FUNCTION__, LL_SYS, fmt::format("Connection stats: Requests: {} Reused: {} New connections: {} TLS handshakes: {} ({} ms)",
+                stats.requests, stats.reused, stats.new_connections, stats.handshakes, stats.handshake_time_us / 1000));
+
+            delete m_pkClientPool;
+            m_pkClientPool = nullptr;
         }
         if (gs_pAPILogInstance)
         {
@@ -97,67 +261,29 @@ namespace TarkovAPI
         return stHwid;
     }
 
-    quicktype::ResponseBody TarkovAPIManager::Post_Json(const std::string& url, const std::string& body)
+    std::string TarkovAPIManager::GetSessionID() const
     {
-        assert(m_pkClient && "Null m_pkClient");
-
-        Log(__FUNCTION__, LL_DEV, fmt::format("Request: {} To: {}", body, url));
+        std::lock_guard <std::mutex> lock(m_pkSessionMutex);
+        return m_stSessionID;
+    }
 
-        m_pkClient->SetUrl(url);
-        m_pkClient->SetBody(cpr::Body{ body });
+    cpr::Header TarkovAPIManager::BuildRequestHeaders()
+    {
+        auto session_id = GetSessionID();
 
-        auto headers = cpr::Header{
+        return cpr::Header{
             {"Content-Type", "application/json"},
             {"User-Agent", fmt::format("UnityPlayer/{} (UnityWebRequest/1.0, libcurl/7.52.0-DEV)", UNITY_VERSION)},
             {"App-Version", fmt::format("EFT Client {}", GAME_VERSION)},
             {"X-Unity-Version", UNITY_VERSION},
-            {"Cookie", fmt::format("PHPSESSID={}", m_stSessionID)},
+            {"Cookie", fmt::format("PHPSESSID={}", session_id)},
             {"GClient-RequestId", fmt::format("{}", m_nReqCounter++)}
         };
-        m_pkClient->SetHeader(headers);
-
-        auto res = m_pkClient->Post();
-
-        switch (res.error.code) // CPR error code
-        {
-        case cpr::ErrorCode::OK:
-            break;
-        default:
-            throw TarkovAPIException(Error::CprApiFailed, res.error.message);
-        }
-
-        switch (res.status_code) // HTTP status code
-        {
-        case 200: // OK
-            break;
-        default:
-            throw TarkovAPIException(Error::CprPostFailed, res.status_code);
-        }
-
-        std::vector <uint8_t> decompresseddata(res.text.size() * 100);
-
-        auto decompressedsize = static_cast<uLongf>(decompresseddata.size());
-        auto ret = uncompress(
-            reinterpret_cast<Bytef*>(&decompresseddata[0]), &decompressedsize,
-            reinterpret_cast<const Bytef*>(res.text.data()), static_cast<uLong>(res.text.size())
-        );
-        if (Z_OK != ret)
-        {
-            throw TarkovAPIException(Error::ZlibDecompressFailed, ret);
-        }
-
-        json deserialized{};
-        try
-        {
-            deserialized = json::parse(decompresseddata.data());
-        }
-        catch (const json::exception & ex)
-        {
-            std::stringstream ss;
-            ss << "Message: " << ex.what() << '\n' << "exception id: " << ex.id << std::endl;
+    }
 
-            throw TarkovAPIException(Error::JsonParseFailed, ss.str());
-        }
+    quicktype::ResponseBody TarkovAPIManager::HandleRawResponse(const json& deserialized)
+    {
+        TRACE_FUNCTION();
 
         Log(__FUNCTION__, LL_DEV, fmt::format("Response: {}", deserialized.dump()));
 
@@ -173,522 +299,1236 @@ namespace TarkovAPI
         return parse_response(deserialized);
     }
 
-
-    bool TarkovAPIManager::OnResponseHandle(const std::string& func, int64_t error_code, const std::string& data)
+    quicktype::ResponseBody TarkovAPIManager::Post_Json(const std::string& url, const std::string& body, RequestPriority priority)
     {
-        switch (error_code)
-        {
-        case ErrorCodes::OK:
-        {
-            Log(func, LL_DEV, "Request completed!");
-        } return true;
+        TRACE_SCOPE_DETAIL("Post_Json", MetricsRegistry::NormalizePath(url));
 
-        case ErrorCodes::NotAuthorized:
-        {
-            Log(func, LL_ERR, fmt::format("Func: {} - Error: {}", func, "Not authorized or game profile not selected"));
-        } break;
-        case ErrorCodes::InvalidUserID:
-        {
-            Log(func, LL_ERR, fmt::format("Func: {} - Error: {}", func, "Invalid user ID selected."));
-        } break;
-        case ErrorCodes::InvalidParameters:
-        {
-            Log(func, LL_ERR, fmt::format("Func: {} - Error: {}", func, "Invalid or missing parameters."));
-        } break;
-        case ErrorCodes::InvalidBarterItems:
-        {
-            Log(func, LL_ERR, fmt::format("Func: {} - Error: {}", func, "Provided `BarterItem` is invalid, not enough quantities available or not found."));
-        } break;
-        case ErrorCodes::Maintenance:
+        if (!m_pkScheduler)
         {
-            Log(func, LL_ERR, fmt::format("Func: {} - Error: {}", func, "EFT API is down for maintenance."));
-        } break;
-        case ErrorCodes::BackendError:
-        {
-            Log(func, LL_ERR, fmt::format("Func: {} - Error: {}", func, "Backend error. No other information is given."));
-        } break;
-        case ErrorCodes::MaxOfferCount:
-        {
-            Log(func, LL_ERR, fmt::format("Func: {} - Error: {}", func, "Maximum outstanding offer count of 3 was reached."));
-        } break;
-        case ErrorCodes::InsufficientTaxFunds:
-        {
-            Log(func, LL_ERR, fmt::format("Func: {} - Error: {}", func, "Insufficient funds to pay the flea market fee."));
-        } break;
-        case ErrorCodes::OfferNotFound:
-        {
-            Log(func, LL_ERR, fmt::format("Func: {} - Error: {}", func, "Offer not found, sold out or out of stock."));
-        } break;
-        case ErrorCodes::BadLoyaltyLevel:
-        {
-            Log(func, LL_ERR, fmt::format("Func: {} - Error: {}", func, "Loyalty level is not high enough to purchase this item."));
-        } break;
-        case ErrorCodes::OfferNotAvailableYet:
-        {
-            Log(func, LL_ERR, fmt::format("Func: {} - Error: {}", func, "Offer is not available yet."));
-        } break;
-        case ErrorCodes::TransactionError:
-        {
-            Log(func, LL_ERR, fmt::format("Func: {} - Error: {}", func, "Transaction error"));
-        } break;
+            return Post_JsonUnscheduled(url, body);
+        }
 
-        default:
-            Log(func, LL_ERR, fmt::format("Func: {} - Unknown error code: {} Data: {}", func, error_code, data));
-            break;
+        auto res = m_pkScheduler->Run(priority, url, [&] { return Post_JsonUnscheduled(url, body); });
+        if (res.err == ErrorCodes::RateLimited)
+        {
+            Log(__FUNCTION__, LL_ERR, fmt::format("Rate limited by server, backing off: {}", HttpClientPool::GetHostKey(url)));
+            m_pkScheduler->OnRateLimited(url);
         }
-        return false;
+        return res;
     }
 
-
-    void TarkovAPIManager::Login_Session(const std::string& session, const std::string& hwid)
+    quicktype::ResponseBody TarkovAPIManager::PostItemsMoving(const std::string& url, const std::string& body)
     {
-        if (session.empty() || hwid.empty())
+        auto res = quicktype::ResponseBody();
+        try
         {
-            throw TarkovAPIException(Error::InvalidParameter);
+            res = Post_Json(url, body);
         }
-
-        if (!m_pkClient)
+        catch (...)
         {
-            throw TarkovAPIException(Error::CprSessionFailed);
+            InvalidateInventory(); // actions may have been applied or not
+            throw;
         }
 
-        m_stHwid = hwid;
-        m_stSessionID = session;
-
-        Log(__FUNCTION__, LL_SYS, fmt::format("Login succesfully completed! Hardware ID: {} Session ID: {}", m_stHwid, m_stSessionID));
+        if (res.err == ErrorCodes::OK)
+        {
+            ApplyInventoryChanges(res.data);
+        }
+        return res;
     }
 
-    void TarkovAPIManager::Login_Token(const std::string& token, const std::string& hwid)
+    quicktype::ResponseBody TarkovAPIManager::Post_JsonUnscheduled(const std::string& url, const std::string& body)
     {
-        if (token.empty() || hwid.empty())
-        {
-            throw TarkovAPIException(Error::InvalidParameter);
-        }
+        assert(m_pkClientPool && "Null m_pkClientPool");
 
-        if (!m_pkClient)
-        {
-            throw TarkovAPIException(Error::CprSessionFailed);
-        }
+        Log(__FUNCTION__, LL_DEV, fmt::format("Request: {} To: {}", body, url));
 
-        auto session = auth::ExchangeAccessToken(m_pkClient, token, hwid);
-        if (session.empty())
-        {
-            throw TarkovAPIException(Error::JsonBadFormat, "Null json data(session)");
-        }
+        auto headers = BuildRequestHeaders();
 
-        json session_ctx{};
+        auto client = m_pkClientPool->Acquire(url);
+
+        quicktype::ResponseBody res{};
         try
         {
-            session_ctx = json::parse(session.data());
+            auto deserialized = client->PostJson(url, body, headers);
+
+            // Envelope validation and conversion is accounted to parse phase
+            auto transfer = client->GetLastTransfer();
+            {
+                ScopedTimer timer(transfer.parse_us);
+                res = HandleRawResponse(deserialized);
+            }
+            MetricsRegistry::Instance().RecordRequest(url, transfer, res.err);
         }
-        catch (const json::parse_error & ex)
+        catch (const json::exception & ex)
         {
+            MetricsRegistry::Instance().RecordRequest(url, client->GetLastTransfer(), REQUEST_FAILED_CODE);
+
             std::stringstream ss;
-            ss << "JSON data(session) could not parsed: Error:" << "Message: " << ex.what() << '\n' << "exception id: " << ex.id << '\n' << "byte position of error: " << ex.byte << std::endl;
+            ss << "Message: " << ex.what() << '\n' << "exception id: " << ex.id << std::endl;
 
             throw TarkovAPIException(Error::JsonParseFailed, ss.str());
         }
-        if (!session_ctx.contains("session"))
+        catch (...)
         {
-            throw TarkovAPIException(Error::JsonParseFailed, "'session' key is not available");
+            MetricsRegistry::Instance().RecordRequest(url, client->GetLastTransfer(), REQUEST_FAILED_CODE);
+            throw;
         }
 
-        Login_Session(session_ctx["session"].get<std::string>(), hwid);
+        return res;
     }
 
-    void TarkovAPIManager::Login(const std::string& email, const std::string& password, const std::string& hwid, const std::string& captcha)
+    void TarkovAPIManager::Post_JsonAsync(const std::string& url, const std::string& body, ResponseCallback callback, RequestPriority priority)
     {
-        if (email.empty() || password.empty() || hwid.empty())
-        {
-            throw TarkovAPIException(Error::InvalidParameter);
-        }
+        assert(m_pkAsyncClient && "Null m_pkAsyncClient");
 
-        if (!m_pkClient)
-        {
-            throw TarkovAPIException(Error::CprSessionFailed);
-        }
+        Log(__FUNCTION__, LL_DEV, fmt::format("Async request: {} To: {}", body, url));
 
-        auto user = auth::LoginImpl(m_pkClient, email, password, captcha, hwid);
-        if (user.empty())
-        {
-            throw TarkovAPIException(Error::JsonBadFormat, "Null json data(user)");
-        }
+        auto on_response = [this, url, callback](json&& deserialized, std::exception_ptr error, const TransferMetrics& transfer)
+            {
+                quicktype::ResponseBody res{};
+                auto handled = transfer;
+                auto error_code = REQUEST_FAILED_CODE;
+                try
+                {
+                    if (error)
+                    {
+                        std::rethrow_exception(error);
+                    }
 
-        json user_ctx{};
-        try
-        {
-            user_ctx = json::parse(user.data());
-        }
-        catch (const json::parse_error & ex)
-        {
-            std::stringstream ss;
-            ss << "JSON data(user) could not parsed: Error:" << "Message: " << ex.what() << '\n' << "exception id: " << ex.id << '\n' << "byte position of error: " << ex.byte << std::endl;
+                    // Envelope validation and conversion is accounted to parse phase
+                    {
+                        ScopedTimer timer(handled.parse_us);
+                        res = HandleRawResponse(deserialized);
+                    }
+                    error_code = res.err;
 
-            throw TarkovAPIException(Error::JsonParseFailed, ss.str());
-        }
-        if (!user_ctx.contains("access_token"))
-        {
-            throw TarkovAPIException(Error::JsonParseFailed, "'access_token' key is not available");
-        }
+                    if (res.err == ErrorCodes::RateLimited && m_pkScheduler)
+                    {
+                        Log(__FUNCTION__, LL_ERR, fmt::format("Rate limited by server, backing off: {}", HttpClientPool::GetHostKey(url)));
+                        m_pkScheduler->OnRateLimited(url);
+                    }
+                }
+                catch (const json::exception & ex)
+                {
+                    std::stringstream ss;
+                    ss << "Message: " << ex.what() << '\n' << "exception id: " << ex.id << std::endl;
 
-        Login_Token(user_ctx["access_token"].get<std::string>(), hwid);
-    }
+                    error = std::make_exception_ptr(TarkovAPIException(Error::JsonParseFailed, ss.str()));
+                }
+                catch (...)
+                {
+                    error = std::current_exception();
+                }
 
-    void TarkovAPIManager::Login_2FA(const std::string& email, const std::string& password, const std::string& code, const std::string& hwid)
-    {
-        if (email.empty() || password.empty() || code.empty() || hwid.empty())
-        {
-            throw TarkovAPIException(Error::InvalidParameter);
-        }
+                MetricsRegistry::Instance().RecordRequest(url, handled, error_code);
+
+                callback(std::move(res), error);
+            };
 
-        if (!m_pkClient)
+        if (!m_pkScheduler)
         {
-            throw TarkovAPIException(Error::CprSessionFailed);
+            m_pkAsyncClient->PostJson(url, body, BuildRequestHeaders(), std::move(on_response));
+            return;
         }
 
-        auth::ActivateHardware(m_pkClient, email, code, hwid);
+        // Async client has its own handles, only token bucket and cooldown of host apply
+        // Admission doesn't block either, a call from a completion callback must not stall the loop thread
+        m_pkScheduler->AcquireAsync(priority, url, [this, url, body, headers = BuildRequestHeaders(), on_response = std::move(on_response)]() mutable
+            {
+                m_pkAsyncClient->PostJson(url, body, headers, std::move(on_response));
+            });
+    }
 
-        Login(email, password, hwid);
-    }
-
-    void TarkovAPIManager::Login_Captcha(const std::string& email, const std::string& password, const std::string& captcha, const std::string& hwid)
+    std::future <json> TarkovAPIManager::RequestAsync(const std::string& func, const std::string& url, const std::string& body, RequestPriority priority)
     {
-        if (email.empty() || password.empty() || captcha.empty() || hwid.empty())
-        {
-            throw TarkovAPIException(Error::InvalidParameter);
-        }
+        auto promise = std::make_shared<std::promise <json>>();
+        auto future = promise->get_future();
 
-        if (!m_pkClient)
-        {
-            throw TarkovAPIException(Error::CprSessionFailed);
-        }
+        Post_JsonAsync(url, body, [this, func, promise](quicktype::ResponseBody&& res, std::exception_ptr error)
+            {
+                if (error)
+                {
+                    promise->set_exception(error);
+                    return;
+                }
+                if (!OnResponseHandle(func, res.err, res.data.dump()))
+                {
+                    promise->set_exception(std::make_exception_ptr(TarkovAPIException(Error::ResponseHandleFailed, res.errmsg)));
+                    return;
+                }
+                promise->set_value(std::move(res.data));
+            }, priority);
 
-        Login(email, password, hwid, captcha);
+        return future;
     }
 
-
-    void TarkovAPIManager::KeepAlive()
+    void TarkovAPIManager::EnableCapture(const std::string& path)
     {
-        auto url = fmt::format(
-            "{}/client/game/keepalive",
-            PROD_ENDPOINT
-        );
-
-        auto res = Post_Json(url);
+        assert(m_pkClientPool && "Null m_pkClientPool");
 
-        switch (res.err)
+        auto capture = std::make_shared<TrafficCapture>(path);
+        if (m_pkAsyncClient)
         {
-        case ErrorCodes::OK:
-            break;
-        default:
-            throw TarkovAPIException(Error::KeepAliveFailed, res.err);
-            break;
+            m_pkAsyncClient->SetCapture(capture);
         }
+        m_pkClientPool->SetCapture(std::move(capture));
+        Log(__FUNCTION__, LL_SYS, fmt::format("Traffic is captured to: {}", path));
     }
 
-    json TarkovAPIManager::GetProfiles()
+    void TarkovAPIManager::EnableReplay(const std::string& path)
     {
-        auto url = fmt::format(
-            "{}/client/game/profile/list",
-            PROD_ENDPOINT
-        );
+        assert(m_pkClientPool && "Null m_pkClientPool");
 
-        auto res = Post_Json(url);
+        auto replay = std::make_shared<TrafficReplay>(path);
+        Log(__FUNCTION__, LL_SYS, fmt::format("Traffic is replayed from: {} ({} records)", path, replay->GetRecordCount()));
 
-        if (!OnResponseHandle(__FUNCTION__, res.err, res.data.dump()))
+        if (m_pkAsyncClient)
         {
-            throw TarkovAPIException(Error::ResponseHandleFailed, res.errmsg);
+            m_pkAsyncClient->SetReplay(replay);
         }
-
-        return res.data;
+        m_pkClientPool->SetReplay(std::move(replay));
     }
 
-    json TarkovAPIManager::GetMyProfile()
+    ConnectionStats TarkovAPIManager::GetConnectionStats() const
     {
-        json out{};
-
-        auto profiles = GetProfiles();
-        if (profiles.empty())
+        if (!m_pkClientPool)
         {
-            throw TarkovAPIException(Error::ResponseHandleFailed, "GetProfiles null data");
+            return ConnectionStats{};
         }
+        return m_pkClientPool->GetStats();
+    }
 
-        try
-        {
-            auto it = std::find_if(profiles.begin(), profiles.end(), [](const nlohmann::json& x)
-                {
-                    return (
-                        x.is_object() &&
-                        x.contains("Info") && x["Info"].is_object() &&
-                        x["Info"].contains("Side") && x["Info"]["Side"].is_string() &&
-                        x["Info"]["Side"].get<std::string>() != "Savage"
-                        );
-                });
-
-            out = nlohmann::json::parse(it->dump());
-        }
-        catch (const json::exception & ex)
+    std::map <std::string, ConnectionStats> TarkovAPIManager::GetConnectionStatsByHost() const
+    {
+        if (!m_pkClientPool)
         {
-            Log(__FUNCTION__, LL_ERR, fmt::format("An exception handled! Data: {}", ex.what()));
+            return std::map <std::string, ConnectionStats>();
         }
-
-        return out;
+        return m_pkClientPool->GetStatsByHost();
     }
 
-    void TarkovAPIManager::SelectProfile(const std::string& user_id)
+    void TarkovAPIManager::EnableMetricsDump(const std::string& path, std::chrono::seconds interval)
     {
-        if (user_id.empty())
-        {
-            throw TarkovAPIException(Error::InvalidParameter);
-        }
+        MetricsRegistry::Instance().StartDump(path, interval);
+        Log(__FUNCTION__, LL_SYS, fmt::format("Metrics are written to: {} every {} seconds", path, interval.count()));
+    }
 
-        auto url = fmt::format(
-            "{}/client/game/profile/select",
-            PROD_ENDPOINT
-        );
+    void TarkovAPIManager::SetDefaultRateBudget(const RateBudget& budget)
+    {
+        assert(m_pkScheduler && "Null m_pkScheduler");
 
-        json body{};
-        body["uid"] = user_id;
+        m_pkScheduler->SetDefaultBudget(budget);
+    }
 
-        auto res = Post_Json(url, body.dump());
+    void TarkovAPIManager::SetRateBudget(const std::string& url, const RateBudget& budget)
+    {
+        assert(m_pkScheduler && "Null m_pkScheduler");
 
-        if (!OnResponseHandle(__FUNCTION__, res.err, res.data.dump()))
-        {
-            throw TarkovAPIException(Error::SelectProfileFail);
-        }
+        m_pkScheduler->SetHostBudget(url, budget);
     }
 
-    json TarkovAPIManager::GetFriends()
+    void TarkovAPIManager::SetVersionCacheTTL(std::chrono::seconds ttl)
     {
-        auto url = fmt::format(
-            "{}/client/friend/list",
-            PROD_ENDPOINT
-        );
+        m_nVersionCacheTTL = ttl;
+    }
 
-        auto res = Post_Json(url);
+    void TarkovAPIManager::SetDataCacheDirectory(const std::string& directory)
+    {
+        m_stDataCacheDirectory = directory;
+    }
 
-        if (!OnResponseHandle(__FUNCTION__, res.err, res.data.dump()))
-        {
-            throw TarkovAPIException(Error::ResponseHandleFailed, res.errmsg);
-        }
-        return res.data;
+    void TarkovAPIManager::SetMaintenanceConfig(const MaintenanceConfig& config)
+    {
+        m_kMaintenanceConfig = config;
     }
 
-    json TarkovAPIManager::GetI18n(const std::string& language)
+    void TarkovAPIManager::StartMaintenance()
     {
-        if (language.empty())
-        {
-            throw TarkovAPIException(Error::InvalidParameter);
-        }
+        assert(m_pkTimerService && "Null m_pkTimerService");
 
-        auto it = m_pkJsonLocale.find(language);
-        if (it != m_pkJsonLocale.end())
-        {
-            return it->second;
-        }
+        StopMaintenance();
 
-        auto url = fmt::format(
-            "{}/client/locale/{}",
-            PROD_ENDPOINT, language
-        );
+        const auto& config = m_kMaintenanceConfig;
+        auto schedule = [this](const std::string& name, std::chrono::seconds interval, TimerJob job) {
+            if (interval.count() > 0)
+            {
+                m_vMaintenanceJobs.emplace_back(m_pkTimerService->Schedule(name, interval, std::move(job)));
+            }
+        };
 
-        auto res = Post_Json(url);
+        schedule("KeepAlive", config.keep_alive_interval, [this] { KeepAlive(); });
+        schedule("RefreshItemPrices", config.item_prices_interval, [this] { RefreshItemPrices(); });
+        schedule("RefreshTraderAssorts", config.trader_assort_interval, [this] { RefreshTraderAssorts(); });
+        schedule("ExpireCaches", config.cache_expiry_interval, [this] { ExpireCaches(); });
 
-        if (!OnResponseHandle(__FUNCTION__, res.err, res.data.dump()))
+        Log(__FUNCTION__, LL_SYS, fmt::format("Maintenance started with {} jobs", m_vMaintenanceJobs.size()));
+    }
+
+    void TarkovAPIManager::StopMaintenance()
+    {
+        if (!m_pkTimerService)
         {
-            throw TarkovAPIException(Error::ResponseHandleFailed, res.errmsg);
+            return;
         }
 
-        m_pkJsonLocale[language] = res.data;
-        return m_pkJsonLocale[language];
+        for (auto id : m_vMaintenanceJobs)
+        {
+            m_pkTimerService->Cancel(id);
+        }
+        m_vMaintenanceJobs.clear();
     }
 
-    json TarkovAPIManager::GetTraders()
+    std::vector <TimerJobStats> TarkovAPIManager::GetMaintenanceStats() const
     {
-        auto url = fmt::format(
-            "{}/client/trading/api/getTradersList",
-            TRADING_ENDPOINT
-        );
-
-        auto res = Post_Json(url);
-
-        if (!OnResponseHandle(__FUNCTION__, res.err, res.data.dump()))
+        if (!m_pkTimerService)
         {
-            throw TarkovAPIException(Error::ResponseHandleFailed, res.errmsg);
+            return std::vector <TimerJobStats>();
         }
-        return res.data;
+        return m_pkTimerService->GetJobStats();
     }
 
-    json TarkovAPIManager::GetTrader(const std::string& trader_id)
+    // Refreshes only caches somebody asked for
+    void TarkovAPIManager::RefreshItemPrices()
     {
-        if (trader_id.empty())
+        if (!std::atomic_load(&m_pkJsonItemPrices))
         {
-            throw TarkovAPIException(Error::InvalidParameter);
+            return;
         }
 
-        auto url = fmt::format(
-            "{}/client/trading/api/getTrader/{}",
-            TRADING_ENDPOINT, trader_id
-        );
+        // Readers keep using old snapshot until new one is published
+        auto prices = std::make_shared<const json>(FetchItemPrices());
+        std::atomic_store(&m_pkJsonItemPrices, JsonSnapshot(std::move(prices)));
 
-        auto res = Post_Json(url);
+        std::lock_guard <std::mutex> lock(m_pkCacheMutex);
+        m_pkCacheTimes["prices"] = std::chrono::steady_clock::now();
+    }
 
-        if (!OnResponseHandle(__FUNCTION__, res.err, res.data.dump()))
-        {
-            throw TarkovAPIException(Error::ResponseHandleFailed, res.errmsg);
-        }
-        return res.data;
+    int64_t TarkovAPIManager::GetUnixTime() const
+    {
+        return std::chrono::duration_cast<std::chrono::seconds>(std::chrono::system_clock::now().time_since_epoch()).count();
     }
 
-    std::string TarkovAPIManager::GetTraderIdByName(const std::string& name)
+    // Only traders past their resupply are fetched, a check without any is free of requests
+    void TarkovAPIManager::RefreshTraderAssorts()
     {
-        auto locale = GetI18n("en");
-        if (locale.empty())
-        {
-            throw TarkovAPIException(Error::NullDataForParse, "locale");
-        }
+        const auto now = GetUnixTime();
 
-        auto target = std::string();
-        auto iter = std::find_if(locale.begin(), locale.end(), [&target, &name](const nlohmann::json& root)
+        auto trader_ids = std::vector <std::string>();
+        {
+            std::lock_guard <std::mutex> lock(m_pkCacheMutex);
+            for (const auto& [trader_id, assort] : m_pkTraderAssorts)
             {
-                if (root.is_object())
+                if (IsTraderAssortStale(trader_id, now))
                 {
-                    for (const auto& it : root.items())
-                    {
-                        if (it.value().is_object())
-                        {
-                            for (const auto& it2 : it.value().items())
-                            {
-                                if (it2.key() == "Nickname" && it2.value() == name)
-                                {
-                                    target = it.key();
-                                    return true;
-                                }
-                            }
-                        }
-                    }
+                    trader_ids.emplace_back(trader_id);
                 }
-                return false;
-            });
+            }
+        }
 
-        if (iter == locale.end())
+        if (trader_ids.empty())
         {
-            throw TarkovAPIException(Error::TraderNotFound, name);
+            return;
+        }
+
+        GetTraders(); // next resupply times
+
+        for (const auto& trader_id : trader_ids)
+        {
+            auto items = std::make_shared<const json>(GetTraderItemsRaw(trader_id));
+            auto prices = std::make_shared<const json>(GetTraderPricesRaw(trader_id));
+
+            std::lock_guard <std::mutex> lock(m_pkCacheMutex);
+            StoreTraderAssort(trader_id, std::move(items), std::move(prices));
         }
 
-        return target;
+        Log(__FUNCTION__, LL_DEV, fmt::format("Refreshed {} resupplied traders", trader_ids.size()));
     }
 
-    json TarkovAPIManager::GetTraderItemsRaw(const std::string& trader_id)
+    void TarkovAPIManager::ExpireCaches()
     {
-        if (trader_id.empty())
+        auto now = std::chrono::steady_clock::now();
+        auto expired = std::vector <std::string>();
+
+        std::lock_guard <std::mutex> lock(m_pkCacheMutex);
+
+        for (auto it = m_pkCacheTimes.begin(); it != m_pkCacheTimes.end();)
         {
-            throw TarkovAPIException(Error::InvalidParameter);
-        }
+            const auto& key = it->first;
 
-        auto url = fmt::format(
-            "{}/client/trading/api/getTraderAssort/{}",
-            TRADING_ENDPOINT, trader_id
-        );
+            auto fresh = now - it->second < m_kMaintenanceConfig.cache_ttl;
 
-        auto res = Post_Json(url);
+            // Assorts with a known resupply time are replaced by RefreshTraderAssorts instead
+            if (key.rfind("assort/", 0) == 0 && m_pkTraderAssortExpiry.count(key.substr(7)))
+            {
+                fresh = true;
+            }
 
-        if (!OnResponseHandle(__FUNCTION__, res.err, res.data.dump()))
+            if (fresh)
+            {
+                ++it;
+                continue;
+            }
+
+            if (key == "items")
+            {
+                std::atomic_store(&m_pkJsonItems, JsonSnapshot());
+                m_pkContainerIndex.reset();
+            }
+            else if (key == "prices")
+            {
+                std::atomic_store(&m_pkJsonItemPrices, JsonSnapshot());
+            }
+            else if (key == "locations")
+            {
+                std::atomic_store(&m_pkJsonLocations, JsonSnapshot());
+            }
+            else if (key.rfind("locale/", 0) == 0)
+            {
+                m_pkJsonLocale.erase(key.substr(7));
+                m_pkLocaleIndexes.erase(key.substr(7));
+            }
+            else if (key.rfind("assort/", 0) == 0)
+            {
+                m_pkTraderAssorts.erase(key.substr(7));
+                m_pkTraderAssortExpiry.erase(key.substr(7));
+                m_pkTraderCatalog.reset();
+                ++m_nTraderAssortGeneration;
+            }
+            else if (key == "inventory")
+            {
+                std::atomic_store(&m_pkInventory, std::shared_ptr <const Inventory>());
+                m_pkContainerIndex.reset();
+            }
+
+            expired.emplace_back(key);
+            it = m_pkCacheTimes.erase(it);
+        }
+
+        if (!expired.empty())
         {
-            throw TarkovAPIException(Error::ResponseHandleFailed, res.errmsg);
+            Log(__FUNCTION__, LL_DEV, fmt::format("Expired {} caches", expired.size()));
         }
-        return res.data;
     }
 
-    json TarkovAPIManager::GetTraderPricesRaw(const std::string& trader_id)
+    void TarkovAPIManager::InvalidateTraderAssort(const std::string& trader_id)
     {
+        std::lock_guard <std::mutex> lock(m_pkCacheMutex);
+
+        m_pkTraderCatalog.reset();
+        ++m_nTraderAssortGeneration;
+
         if (trader_id.empty())
         {
-            throw TarkovAPIException(Error::InvalidParameter);
+            for (const auto& [id, assort] : m_pkTraderAssorts)
+            {
+                m_pkCacheTimes.erase(fmt::format("assort/{}", id));
+            }
+            m_pkTraderAssorts.clear();
+            m_pkTraderAssortExpiry.clear();
+            return;
         }
 
-        auto url = fmt::format(
-            "{}/client/trading/api/getUserAssortPrice/trader/{}",
-            TRADING_ENDPOINT, trader_id
-        );
+        m_pkTraderAssorts.erase(trader_id);
+        m_pkTraderAssortExpiry.erase(trader_id);
+        m_pkCacheTimes.erase(fmt::format("assort/{}", trader_id));
+    }
 
-        auto res = Post_Json(url);
+    void TarkovAPIManager::RecordTraderResupply(const json& traders)
+    {
+        // Cached assorts keep time they were fetched for, a later time doesn't make them look fresh
+        auto record = [this](const json& trader) {
+            auto id = trader.find("_id");
+            auto supply_next_time = trader.find("supply_next_time");
+            if (id != trader.end() && id->is_string() && supply_next_time != trader.end() && supply_next_time->is_number())
+            {
+                m_pkTraderResupply[id->get<std::string>()] = supply_next_time->get<int64_t>();
+            }
+        };
 
-        if (!OnResponseHandle(__FUNCTION__, res.err, res.data.dump()))
+        std::lock_guard <std::mutex> lock(m_pkCacheMutex);
+
+        if (traders.is_array())
         {
-            throw TarkovAPIException(Error::ResponseHandleFailed, res.errmsg);
+            for (const auto& trader : traders)
+            {
+                record(trader);
+            }
+        }
+        else if (traders.is_object())
+        {
+            record(traders);
         }
-        return res.data;
     }
 
-    json TarkovAPIManager::GetWeather()
+    bool TarkovAPIManager::IsTraderAssortStale(const std::string& trader_id, int64_t now) const
     {
-        auto url = fmt::format(
-            "{}/client/weather",
-            PROD_ENDPOINT
-        );
+        auto it = m_pkTraderAssortExpiry.find(trader_id);
+        return it != m_pkTraderAssortExpiry.end() && now >= it->second + TRADER_RESUPPLY_GRACE_SECONDS;
+    }
 
-        auto res = Post_Json(url);
+    bool TarkovAPIManager::IsTraderResupplyKnown(const std::string& trader_id, int64_t now) const
+    {
+        auto it = m_pkTraderResupply.find(trader_id);
+        return it != m_pkTraderResupply.end() && now < it->second + TRADER_RESUPPLY_GRACE_SECONDS;
+    }
 
-        if (!OnResponseHandle(__FUNCTION__, res.err, res.data.dump()))
+    void TarkovAPIManager::StoreTraderAssort(const std::string& trader_id, JsonSnapshot items, JsonSnapshot prices)
+    {
+        const auto now = GetUnixTime();
+
+        // A time which passed means server hasn't restocked yet, assort may predate it and is fetched again after grace
+        auto resupply = m_pkTraderResupply.find(trader_id);
+        if (resupply != m_pkTraderResupply.end())
         {
-            throw TarkovAPIException(Error::ResponseHandleFailed, res.errmsg);
+            m_pkTraderAssortExpiry[trader_id] = IsTraderResupplyKnown(trader_id, now) ? resupply->second : now;
         }
-        return res.data;
+        else
+        {
+            m_pkTraderAssortExpiry.erase(trader_id);
+        }
+
+        m_pkCacheTimes[fmt::format("assort/{}", trader_id)] = std::chrono::steady_clock::now();
+        m_pkTraderAssorts[trader_id] = std::make_pair(std::move(items), std::move(prices));
+        m_pkTraderCatalog.reset();
+        ++m_nTraderAssortGeneration;
     }
 
-    json TarkovAPIManager::GetItems()
+    void TarkovAPIManager::InvalidateInventory()
     {
-        if (!m_pkJsonItems.empty())
-        {
-            return m_pkJsonItems;
-        }
+        std::lock_guard <std::mutex> lock(m_pkCacheMutex);
 
-        auto url = fmt::format(
-            "{}/client/items",
-            PROD_ENDPOINT
-        );
+        ++m_nInventoryGeneration;
+        std::atomic_store(&m_pkInventory, std::shared_ptr <const Inventory>());
+        m_pkContainerIndex.reset();
+        m_pkCacheTimes.erase("inventory");
+    }
 
-        json body{};
-        body["crc"] = 0;
+    void TarkovAPIManager::ApplyInventoryChanges(const json& data)
+    {
+        std::lock_guard <std::mutex> lock(m_pkCacheMutex);
 
-        auto res = Post_Json(url, body.dump());
+        ++m_nInventoryGeneration; // a profile download which started before this response is already stale
 
-        if (!OnResponseHandle(__FUNCTION__, res.err, res.data.dump()))
+        auto current = std::atomic_load(&m_pkInventory);
+        if (!current)
         {
-            throw TarkovAPIException(Error::ResponseHandleFailed, res.errmsg);
+            return;
         }
-        m_pkJsonItems = res.data;
-        return m_pkJsonItems;
+
+        // Older backends send item changes at root, newer ones per profile in profileChanges
+        const json* changes = nullptr;
+        if (data.contains("profileChanges") && data["profileChanges"].is_object())
+        {
+            auto profile = data["profileChanges"].find(m_stSelectedProfileID);
+            if (profile != data["profileChanges"].end() && profile->contains("items"))
+            {
+                changes = &profile->at("items");
+            }
+        }
+        else if (data.contains("items"))
+        {
+            changes = &data["items"];
+        }
+
+        auto next = std::make_shared<Inventory>(*current);
+        auto touched = std::vector <ObjectId>();
+        if (!changes || !next->ApplyChanges(*changes, &touched))
+        {
+            Log(__FUNCTION__, LL_ERR, "Inventory changes could not be applied, profile will be reloaded on next query");
+
+            std::atomic_store(&m_pkInventory, std::shared_ptr <const Inventory>());
+            m_pkContainerIndex.reset();
+            m_pkCacheTimes.erase("inventory");
+            return;
+        }
+
+        auto inventory = std::shared_ptr <const Inventory>(std::move(next));
+        std::atomic_store(&m_pkInventory, inventory);
+
+        // Grids of containers this response did not touch stay valid
+        if (m_pkContainerIndex)
+        {
+            m_pkContainerIndex->Update(std::move(inventory), touched);
+        }
+    }
+
+    std::shared_ptr <ContainerIndex> TarkovAPIManager::GetContainerIndex()
+    {
+        TRACE_FUNCTION();
+
+        auto items = GetItems();
+        auto inventory = GetMyInventory();
+
+        {
+            std::lock_guard <std::mutex> lock(m_pkCacheMutex);
+
+            if (m_pkContainerIndex && m_pkContainerIndex->GetItems() == items)
+            {
+                return m_pkContainerIndex;
+            }
+        }
+
+        auto index = std::make_shared<ContainerIndex>(items, inventory);
+
+        std::lock_guard <std::mutex> lock(m_pkCacheMutex);
+
+        // Inventory or items DB was replaced meanwhile, index is only good for this query
+        if (std::atomic_load(&m_pkInventory) != inventory || std::atomic_load(&m_pkJsonItems) != items)
+        {
+            return index;
+        }
+        m_pkContainerIndex = index;
+        return index;
+    }
+
+    void TarkovAPIManager::EnableTrace(const std::string& path)
+    {
+        m_stTracePath = path;
+        TraceCollector::Instance().Enable();
+        Log(__FUNCTION__, LL_SYS, fmt::format("Trace is written on finalize to: {}", path));
+    }
+
+    std::vector <EndpointMetricsSnapshot> TarkovAPIManager::GetMetrics() const
+    {
+        return MetricsRegistry::Instance().GetSnapshot();
+    }
+
+    bool TarkovAPIManager::GetEndpointMetrics(const std::string& path, EndpointMetricsSnapshot& out) const
+    {
+        return MetricsRegistry::Instance().GetEndpointSnapshot(path, out);
+    }
+
+
+    bool TarkovAPIManager::OnResponseHandle(const std::string& func, int64_t error_code, const std::string& data)
+    {
+        ScopedHandleTimer handle_timer;
+
+        switch (error_code)
+        {
+        case ErrorCodes::OK:
+        {
+            Log(func, LL_DEV, "Request completed!");
+        } return true;
+
+        case ErrorCodes::NotAuthorized:
+        {
+            Log(func, LL_ERR, fmt::format("Func: {} - Error: {}", func, "Not authorized or game profile not selected"));
+        } break;
+        case ErrorCodes::InvalidUserID:
+        {
+            Log(func, LL_ERR, fmt::format("Func: {} - Error: {}", func, "Invalid user ID selected."));
+        } break;
+        case ErrorCodes::InvalidParameters:
+        {
+            Log(func, LL_ERR, fmt::format("Func: {} - Error: {}", func, "Invalid or missing parameters."));
+        } break;
+        case ErrorCodes::InvalidBarterItems:
+        {
+            Log(func, LL_ERR, fmt::format("Func: {} - Error: {}", func, "Provided `BarterItem` is invalid, not enough quantities available or not found."));
+        } break;
+        case ErrorCodes::Maintenance:
+        {
+            Log(func, LL_ERR, fmt::format("Func: {} - Error: {}", func, "EFT API is down for maintenance."));
+        } break;
+        case ErrorCodes::BackendError:
+        {
+            Log(func, LL_ERR, fmt::format("Func: {} - Error: {}", func, "Backend error. No other information is given."));
+        } break;
+        case ErrorCodes::MaxOfferCount:
+        {
+            Log(func, LL_ERR, fmt::format("Func: {} - Error: {}", func, "Maximum outstanding offer count of 3 was reached."));
+        } break;
+        case ErrorCodes::InsufficientTaxFunds:
+        {
+            Log(func, LL_ERR, fmt::format("Func: {} - Error: {}", func, "Insufficient funds to pay the flea market fee."));
+        } break;
+        case ErrorCodes::OfferNotFound:
+        {
+            Log(func, LL_ERR, fmt::format("Func: {} - Error: {}", func, "Offer not found, sold out or out of stock."));
+        } break;
+        case ErrorCodes::BadLoyaltyLevel:
+        {
+            Log(func, LL_ERR, fmt::format("Func: {} - Error: {}", func, "Loyalty level is not high enough to purchase this item."));
+        } break;
+        case ErrorCodes::OfferNotAvailableYet:
+        {
+            Log(func, LL_ERR, fmt::format("Func: {} - Error: {}", func, "Offer is not available yet."));
+        } break;
+        case ErrorCodes::TransactionError:
+        {
+            Log(func, LL_ERR, fmt::format("Func: {} - Error: {}", func, "Transaction error"));
+        } break;
+
+        default:
+            Log(func, LL_ERR, fmt::format("Func: {} - Unknown error code: {} Data: {}", func, error_code, data));
+            break;
+        }
+        return false;
+    }
+
+
+    void TarkovAPIManager::Login_Session(const std::string& session, const std::string& hwid)
+    {
+        TRACE_FUNCTION();
+
+        if (session.empty() || hwid.empty())
+        {
+            throw TarkovAPIException(Error::InvalidParameter);
+        }
+
+        if (!m_pkClientPool)
+        {
+            throw TarkovAPIException(Error::CprSessionFailed);
+        }
+
+        m_stHwid = hwid;
+        {
+            std::lock_guard <std::mutex> lock(m_pkSessionMutex);
+            m_stSessionID = session;
+        }
+
+        {
+            std::lock_guard <std::mutex> lock(m_pkCacheMutex);
+            m_stSelectedProfileID.clear();
+        }
+        InvalidateInventory();
+
+        Log(__FUNCTION__, LL_SYS, fmt::format("Login succesfully completed! Hardware ID: {} Session ID: {}", m_stHwid, session));
+
+        if (m_kMaintenanceConfig.auto_start && m_pkTimerService)
+        {
+            StartMaintenance();
+        }
+    }
+
+    void TarkovAPIManager::Login_Token(const std::string& token, const std::string& hwid)
+    {
+        TRACE_FUNCTION();
+
+        if (token.empty() || hwid.empty())
+        {
+            throw TarkovAPIException(Error::InvalidParameter);
+        }
+
+        if (!m_pkClientPool)
+        {
+            throw TarkovAPIException(Error::CprSessionFailed);
+        }
+
+        auto session = RunScheduled(RequestPriority::Session, PROD_ENDPOINT, [&] {
+            return auth::ExchangeAccessToken(m_pkClientPool->Acquire(PROD_ENDPOINT), token, hwid);
+        });
+        if (session.empty())
+        {
+            throw TarkovAPIException(Error::JsonBadFormat, "Null json data(session)");
+        }
+
+        json session_ctx{};
+        try
+        {
+            session_ctx = json::parse(session.data());
+        }
+        catch (const json::parse_error & ex)
+        {
+            std::stringstream ss;
+            ss << "JSON data(session) could not parsed: Error:" << "Message: " << ex.what() << '\n' << "exception id: " << ex.id << '\n' << "byte position of error: " << ex.byte << std::endl;
+
+            throw TarkovAPIException(Error::JsonParseFailed, ss.str());
+        }
+        if (!session_ctx.contains("session"))
+        {
+            throw TarkovAPIException(Error::JsonParseFailed, "'session' key is not available");
+        }
+
+        Login_Session(session_ctx["session"].get<std::string>(), hwid);
+    }
+
+    void TarkovAPIManager::Login(const std::string& email, const std::string& password, const std::string& hwid, const std::string& captcha)
+    {
+        TRACE_FUNCTION();
+
+        if (email.empty() || password.empty() || hwid.empty())
+        {
+            throw TarkovAPIException(Error::InvalidParameter);
+        }
+
+        if (!m_pkClientPool)
+        {
+            throw TarkovAPIException(Error::CprSessionFailed);
+        }
+
+        auto user = RunScheduled(RequestPriority::Session, LAUNCHER_ENDPOINT, [&] {
+            return auth::LoginImpl(m_pkClientPool->Acquire(LAUNCHER_ENDPOINT), email, password, captcha, hwid);
+        });
+        if (user.empty())
+        {
+            throw TarkovAPIException(Error::JsonBadFormat, "Null json data(user)");
+        }
+
+        json user_ctx{};
+        try
+        {
+            user_ctx = json::parse(user.data());
+        }
+        catch (const json::parse_error & ex)
+        {
+            std::stringstream ss;
+            ss << "JSON data(user) could not parsed: Error:" << "Message: " << ex.what() << '\n' << "exception id: " << ex.id << '\n' << "byte position of error: " << ex.byte << std::endl;
+
+            throw TarkovAPIException(Error::JsonParseFailed, ss.str());
+        }
+        if (!user_ctx.contains("access_token"))
+        {
+            throw TarkovAPIException(Error::JsonParseFailed, "'access_token' key is not available");
+        }
+
+        Login_Token(user_ctx["access_token"].get<std::string>(), hwid);
+    }
+
+    void TarkovAPIManager::Login_2FA(const std::string& email, const std::string& password, const std::string& code, const std::string& hwid)
+    {
+        TRACE_FUNCTION();
+
+        if (email.empty() || password.empty() || code.empty() || hwid.empty())
+        {
+            throw TarkovAPIException(Error::InvalidParameter);
+        }
+
+        if (!m_pkClientPool)
+        {
+            throw TarkovAPIException(Error::CprSessionFailed);
+        }
+
+        RunScheduled(RequestPriority::Session, LAUNCHER_ENDPOINT, [&] {
+            auth::ActivateHardware(m_pkClientPool->Acquire(LAUNCHER_ENDPOINT), email, code, hwid);
+        });
+
+        Login(email, password, hwid);
+    }
+
+    void TarkovAPIManager::Login_Captcha(const std::string& email, const std::string& password, const std::string& captcha, const std::string& hwid)
+    {
+        TRACE_FUNCTION();
+
+        if (email.empty() || password.empty() || captcha.empty() || hwid.empty())
+        {
+            throw TarkovAPIException(Error::InvalidParameter);
+        }
+
+        if (!m_pkClientPool)
+        {
+            throw TarkovAPIException(Error::CprSessionFailed);
+        }
+
+        Login(email, password, hwid, captcha);
+    }
+
+
+    void TarkovAPIManager::KeepAlive()
+    {
+        TRACE_FUNCTION();
+
+        auto url = fmt::format(
+            "{}/client/game/keepalive",
+            PROD_ENDPOINT
+        );
+
+        auto res = Post_Json(url, "", RequestPriority::Session);
+
+        switch (res.err)
+        {
+        case ErrorCodes::OK:
+            break;
+        default:
+            throw TarkovAPIException(Error::KeepAliveFailed, res.err);
+            break;
+        }
+    }
+
+    json TarkovAPIManager::GetProfiles()
+    {
+        TRACE_FUNCTION();
+
+        auto url = fmt::format(
+            "{}/client/game/profile/list",
+            PROD_ENDPOINT
+        );
+
+        auto res = Post_Json(url);
+
+        if (!OnResponseHandle(__FUNCTION__, res.err, res.data.dump()))
+        {
+            throw TarkovAPIException(Error::ResponseHandleFailed, res.errmsg);
+        }
+
+        return res.data;
+    }
+
+    json TarkovAPIManager::GetMyProfile()
+    {
+        TRACE_FUNCTION();
+
+        json out{};
+
+        auto profiles = GetProfiles();
+        if (profiles.empty())
+        {
+            throw TarkovAPIException(Error::ResponseHandleFailed, "GetProfiles null data");
+        }
+
+        try
+        {
+            auto it = std::find_if(profiles.begin(), profiles.end(), [](const nlohmann::json& x)
+                {
+                    return (
+                        x.is_object() &&
+                        x.contains("Info") && x["Info"].is_object() &&
+                        x["Info"].contains("Side") && x["Info"]["Side"].is_string() &&
+                        x["Info"]["Side"].get<std::string>() != "Savage"
+                        );
+                });
+
+            out = nlohmann::json::parse(it->dump());
+        }
+        catch (const json::exception & ex)
+        {
+            Log(__FUNCTION__, LL_ERR, fmt::format("An exception handled! Data: {}", ex.what()));
+        }
+
+        return out;
+    }
+
+    void TarkovAPIManager::SelectProfile(const std::string& user_id)
+    {
+        TRACE_FUNCTION();
+
+        if (user_id.empty())
+        {
+            throw TarkovAPIException(Error::InvalidParameter);
+        }
+
+        auto url = fmt::format(
+            "{}/client/game/profile/select",
+            PROD_ENDPOINT
+        );
+
+        json body{};
+        body["uid"] = user_id;
+
+        auto res = Post_Json(url, body.dump(), RequestPriority::Session);
+
+        if (!OnResponseHandle(__FUNCTION__, res.err, res.data.dump()))
+        {
+            throw TarkovAPIException(Error::SelectProfileFail);
+        }
+
+        std::lock_guard <std::mutex> lock(m_pkCacheMutex);
+        m_stSelectedProfileID = user_id;
+    }
+
+    json TarkovAPIManager::GetFriends()
+    {
+        TRACE_FUNCTION();
+
+        auto url = fmt::format(
+            "{}/client/friend/list",
+            PROD_ENDPOINT
+        );
+
+        auto res = Post_Json(url);
+
+        if (!OnResponseHandle(__FUNCTION__, res.err, res.data.dump()))
+        {
+            throw TarkovAPIException(Error::ResponseHandleFailed, res.errmsg);
+        }
+        return res.data;
     }
 
-    json TarkovAPIManager::GetItemPrices()
+    JsonSnapshot TarkovAPIManager::GetI18n(const std::string& language)
     {
-        if (!m_pkJsonItemPrices.empty())
+        TRACE_FUNCTION();
+
+        if (language.empty())
+        {
+            throw TarkovAPIException(Error::InvalidParameter);
+        }
+
         {
-            return m_pkJsonItemPrices;
+            std::lock_guard <std::mutex> lock(m_pkCacheMutex);
+
+            auto it = m_pkJsonLocale.find(language);
+            if (it != m_pkJsonLocale.end())
+            {
+                return it->second;
+            }
         }
 
         auto url = fmt::format(
-            "{}/client/items/prices",
+            "{}/client/locale/{}",
+            PROD_ENDPOINT, language
+        );
+
+        auto locale = std::make_shared<const json>(FetchStaticData(__FUNCTION__, url, fmt::format("locale_{}", language)));
+
+        std::lock_guard <std::mutex> lock(m_pkCacheMutex);
+
+        m_pkCacheTimes[fmt::format("locale/{}", language)] = std::chrono::steady_clock::now();
+        m_pkJsonLocale[language] = locale;
+        m_pkLocaleIndexes.erase(language);
+        return locale;
+    }
+
+    std::shared_ptr <const LocaleIndex> TarkovAPIManager::GetLocaleIndex(const std::string& language)
+    {
+        TRACE_FUNCTION();
+
+        {
+            std::lock_guard <std::mutex> lock(m_pkCacheMutex);
+
+            auto it = m_pkLocaleIndexes.find(language);
+            if (it != m_pkLocaleIndexes.end())
+            {
+                return it->second;
+            }
+        }
+
+        auto locale = GetI18n(language);
+        if (locale->empty())
+        {
+            throw TarkovAPIException(Error::NullDataForParse, "locale");
+        }
+
+        // Built outside of lock, a concurrent builder of same locale simply loses
+        auto index = std::make_shared<const LocaleIndex>(locale);
+
+        std::lock_guard <std::mutex> lock(m_pkCacheMutex);
+
+        auto it = m_pkJsonLocale.find(language);
+        if (it == m_pkJsonLocale.end() || it->second != locale)
+        {
+            return index; // locale was expired or reloaded meanwhile, not cached
+        }
+        return m_pkLocaleIndexes.emplace(language, std::move(index)).first->second;
+    }
+
+    json TarkovAPIManager::GetTraders()
+    {
+        TRACE_FUNCTION();
+
+        auto url = fmt::format(
+            "{}/client/trading/api/getTradersList",
+            TRADING_ENDPOINT
+        );
+
+        auto res = Post_Json(url);
+
+        if (!OnResponseHandle(__FUNCTION__, res.err, res.data.dump()))
+        {
+            throw TarkovAPIException(Error::ResponseHandleFailed, res.errmsg);
+        }
+        RecordTraderResupply(res.data);
+        return res.data;
+    }
+
+    json TarkovAPIManager::GetTrader(const std::string& trader_id)
+    {
+        TRACE_FUNCTION();
+
+        if (trader_id.empty())
+        {
+            throw TarkovAPIException(Error::InvalidParameter);
+        }
+
+        auto url = fmt::format(
+            "{}/client/trading/api/getTrader/{}",
+            TRADING_ENDPOINT, trader_id
+        );
+
+        auto res = Post_Json(url);
+
+        if (!OnResponseHandle(__FUNCTION__, res.err, res.data.dump()))
+        {
+            throw TarkovAPIException(Error::ResponseHandleFailed, res.errmsg);
+        }
+        RecordTraderResupply(res.data);
+        return res.data;
+    }
+
+    std::string TarkovAPIManager::GetTraderIdByName(const std::string& name, const std::string& language)
+    {
+        TRACE_FUNCTION();
+
+        auto index = GetLocaleIndex(language);
+
+        auto trader_id = index->FindTraderId(name);
+        if (trader_id.empty())
+        {
+            throw TarkovAPIException(Error::TraderNotFound, name);
+        }
+
+        return std::string(trader_id);
+    }
+
+    json TarkovAPIManager::GetTraderItemsRaw(const std::string& trader_id)
+    {
+        TRACE_FUNCTION();
+
+        if (trader_id.empty())
+        {
+            throw TarkovAPIException(Error::InvalidParameter);
+        }
+
+        auto url = fmt::format(
+            "{}/client/trading/api/getTraderAssort/{}",
+            TRADING_ENDPOINT, trader_id
+        );
+
+        auto res = Post_Json(url);
+
+        if (!OnResponseHandle(__FUNCTION__, res.err, res.data.dump()))
+        {
+            throw TarkovAPIException(Error::ResponseHandleFailed, res.errmsg);
+        }
+        return res.data;
+    }
+
+    json TarkovAPIManager::GetTraderPricesRaw(const std::string& trader_id)
+    {
+        TRACE_FUNCTION();
+
+        if (trader_id.empty())
+        {
+            throw TarkovAPIException(Error::InvalidParameter);
+        }
+
+        auto url = fmt::format(
+            "{}/client/trading/api/getUserAssortPrice/trader/{}",
+            TRADING_ENDPOINT, trader_id
+        );
+
+        auto res = Post_Json(url);
+
+        if (!OnResponseHandle(__FUNCTION__, res.err, res.data.dump()))
+        {
+            throw TarkovAPIException(Error::ResponseHandleFailed, res.errmsg);
+        }
+        return res.data;
+    }
+
+    json TarkovAPIManager::GetWeather()
+    {
+        TRACE_FUNCTION();
+
+        auto url = fmt::format(
+            "{}/client/weather",
+            PROD_ENDPOINT
+        );
+
+        auto res = Post_Json(url);
+
+        if (!OnResponseHandle(__FUNCTION__, res.err, res.data.dump()))
+        {
+            throw TarkovAPIException(Error::ResponseHandleFailed, res.errmsg);
+        }
+        return res.data;
+    }
+
+    JsonSnapshot TarkovAPIManager::GetItems()
+    {
+        TRACE_FUNCTION();
+
+        if (auto snapshot = std::atomic_load(&m_pkJsonItems))
+        {
+            return snapshot;
+        }
+
+        auto url = fmt::format(
+            "{}/client/items",
             PROD_ENDPOINT
         );
 
+        auto items = std::make_shared<const json>(FetchStaticData(__FUNCTION__, url, "items"));
+        std::atomic_store(&m_pkJsonItems, JsonSnapshot(items));
+
+        std::lock_guard <std::mutex> lock(m_pkCacheMutex);
+
+        m_pkCacheTimes["items"] = std::chrono::steady_clock::now();
+        return items;
+    }
+
+    JsonSnapshot TarkovAPIManager::GetItemPrices()
+    {
+        TRACE_FUNCTION();
+
+        if (auto snapshot = std::atomic_load(&m_pkJsonItemPrices))
+        {
+            return snapshot;
+        }
+
+        auto prices = std::make_shared<const json>(FetchItemPrices());
+        std::atomic_store(&m_pkJsonItemPrices, JsonSnapshot(prices));
+
+        std::lock_guard <std::mutex> lock(m_pkCacheMutex);
+
+        m_pkCacheTimes["prices"] = std::chrono::steady_clock::now();
+        return prices;
+    }
+
+    json TarkovAPIManager::FetchStaticData(const std::string& func, const std::string& url, const std::string& cache_key)
+    {
+        // Server answers with null data when crc of our disk copy is still current
+        auto crc = m_pkDataCache ? m_pkDataCache->GetCrc(cache_key) : 0;
+
         json body{};
-        body["crc"] = 0;
+        body["crc"] = crc;
 
-        auto res = Post_Json(url, body.dump());
+        auto res = Post_Json(url, body.dump(), RequestPriority::Bulk);
 
-        if (!OnResponseHandle(__FUNCTION__, res.err, res.data.dump()))
+        if (!OnResponseHandle(func, res.err, res.data.dump()))
         {
             throw TarkovAPIException(Error::ResponseHandleFailed, res.errmsg);
         }
-        m_pkJsonItemPrices = res.data;
-        return m_pkJsonItemPrices;
+
+        if (!m_pkDataCache)
+        {
+            return res.data;
+        }
+
+        if (crc && res.data.is_null())
+        {
+            json data{};
+            if (m_pkDataCache->Load(cache_key, data))
+            {
+                Log(func, LL_DEV, fmt::format("Unchanged, served from disk cache: {}", cache_key));
+                return data;
+            }
+
+            // Disk copy is lost, Load dropped its crc so full payload is sent this time
+            return FetchStaticData(func, url, cache_key);
+        }
+
+        if (!m_pkDataCache->Store(cache_key, res.data, res.crc))
+        {
+            Log(func, LL_DEV, fmt::format("Not stored in disk cache: {}", cache_key));
+        }
+        return res.data;
+    }
+
+    json TarkovAPIManager::FetchItemPrices()
+    {
+        auto url = fmt::format(
+            "{}/client/items/prices",
+            PROD_ENDPOINT
+        );
+
+        return FetchStaticData("GetItemPrices", url, "prices");
     }
 
     json TarkovAPIManager::GetMailList()
     {
+        TRACE_FUNCTION();
+
         auto url = fmt::format(
             "{}/client/mail/dialog/list",
             PROD_ENDPOINT
@@ -708,6 +1548,8 @@ namespace TarkovAPI
 
     json TarkovAPIManager::GetMail(const std::string& mail_id, int64_t type)
     {
+        TRACE_FUNCTION();
+
         auto url = fmt::format(
             "{}/client/mail/dialog/view",
             PROD_ENDPOINT
@@ -728,6 +1570,8 @@ namespace TarkovAPI
 
     json TarkovAPIManager::GetMailAttachments(const std::string& mail_id)
     {
+        TRACE_FUNCTION();
+
         auto url = fmt::format(
             "{}/client/mail/dialog/getAllAttachments",
             PROD_ENDPOINT
@@ -747,6 +1591,8 @@ namespace TarkovAPI
 
     json TarkovAPIManager::GetMailReward(const std::string& from_item_id, const std::string& to_item_id, const std::string& previous_owner_id, const quicktype::MailRewardToLocation& to_stash_location)
     {
+        TRACE_FUNCTION();
+
         if (from_item_id.empty() || to_item_id.empty() || previous_owner_id.empty())
         {
             throw TarkovAPIException(Error::InvalidParameter);
@@ -782,7 +1628,7 @@ namespace TarkovAPI
         };
         
         auto req = serialize_get_mail_reward(body).dump();
-        auto res = Post_Json(url, req);
+        auto res = PostItemsMoving(url, req);
 
         if (!OnResponseHandle(__FUNCTION__, res.err, res.data.dump()))
         {
@@ -795,11 +1641,13 @@ namespace TarkovAPI
         return res.data;
     }
 
-    json TarkovAPIManager::GetLocations()
+    JsonSnapshot TarkovAPIManager::GetLocations()
     {
-        if (!m_pkJsonLocations.empty())
+        TRACE_FUNCTION();
+
+        if (auto snapshot = std::atomic_load(&m_pkJsonLocations))
         {
-            return m_pkJsonLocations;
+            return snapshot;
         }
 
         auto url = fmt::format(
@@ -807,21 +1655,19 @@ namespace TarkovAPI
             PROD_ENDPOINT
         );
 
-        json body{};
-        body["crc"] = 0;
+        auto locations = std::make_shared<const json>(FetchStaticData(__FUNCTION__, url, "locations"));
+        std::atomic_store(&m_pkJsonLocations, JsonSnapshot(locations));
 
-        auto res = Post_Json(url, body.dump());
+        std::lock_guard <std::mutex> lock(m_pkCacheMutex);
 
-        if (!OnResponseHandle(__FUNCTION__, res.err, res.data.dump()))
-        {
-            throw TarkovAPIException(Error::ResponseHandleFailed, res.errmsg);
-        }
-        m_pkJsonLocations = res.data;
-        return m_pkJsonLocations;
+        m_pkCacheTimes["locations"] = std::chrono::steady_clock::now();
+        return locations;
     }
 
     json TarkovAPIManager::SearchMarket(const quicktype::MarketFilterBody& filter)
     {
+        TRACE_FUNCTION();
+
         if (!filter.limit)
         {
             throw TarkovAPIException(Error::InvalidParameter);
@@ -843,6 +1689,8 @@ namespace TarkovAPI
 
     json TarkovAPIManager::BuyItem(const std::string& offer_id, int64_t quantity, const std::vector <quicktype::TraderBarterItem>& barter_items)
     {
+        TRACE_FUNCTION();
+
         if (offer_id.empty() || !quantity || barter_items.empty())
         {
             throw TarkovAPIException(Error::InvalidParameter);
@@ -868,7 +1716,7 @@ namespace TarkovAPI
         };
 
         auto req = serialize_market_buy_request(body).dump();
-        auto res = Post_Json(url, req);
+        auto res = PostItemsMoving(url, req);
 
         if (!OnResponseHandle(__FUNCTION__, res.err, res.data.dump()))
         {
@@ -899,6 +1747,8 @@ namespace TarkovAPI
 
     json TarkovAPIManager::GetItemPrice(const std::string& schema_id)
     {
+        TRACE_FUNCTION();
+
         if (schema_id.empty())
         {
             throw TarkovAPIException(Error::InvalidParameter);
@@ -912,7 +1762,7 @@ namespace TarkovAPI
         json body{};
         body["templateId"] = schema_id;
 
-        auto res = Post_Json(url, body.dump());
+        auto res = Post_Json(url, body.dump(), RequestPriority::Bulk);
 
         if (!OnResponseHandle(__FUNCTION__, res.err, res.data.dump()))
         {
@@ -923,6 +1773,8 @@ namespace TarkovAPI
 
     json TarkovAPIManager::TradeItem(const std::string& trader_id, const std::string& item_id, int64_t quantity, const std::vector <quicktype::TraderBarterItem>& barter_items)
     {
+        TRACE_FUNCTION();
+
         if (trader_id.empty() || item_id.empty() || !quantity || barter_items.empty())
         {
             throw TarkovAPIException(Error::InvalidParameter);
@@ -951,7 +1803,9 @@ namespace TarkovAPI
         };
 
         auto req = serialize_trade_item_request(body).dump();
-        auto res = Post_Json(url, req);
+        auto res = PostItemsMoving(url, req);
+
+        InvalidateTraderAssort(trader_id); // stock and buy restrictions changed
 
         if (!OnResponseHandle(__FUNCTION__, res.err, res.data.dump()))
         {
@@ -970,15 +1824,79 @@ namespace TarkovAPI
 
     std::vector <quicktype::TraderItem> TarkovAPIManager::GetTraderItems(const std::string& trader_id)
     {
-        auto result = std::vector <quicktype::TraderItem>();
+        TRACE_FUNCTION();
 
         if (trader_id.empty())
         {
             throw TarkovAPIException(Error::InvalidParameter);
         }
 
-        auto items = GetTraderItemsRaw(trader_id);
-        auto prices = GetTraderPricesRaw(trader_id);
+        const auto now = GetUnixTime();
+        auto resupply_known = false;
+        {
+            std::unique_lock <std::mutex> lock(m_pkCacheMutex);
+
+            auto it = m_pkTraderAssorts.find(trader_id);
+            if (it != m_pkTraderAssorts.end() && !IsTraderAssortStale(trader_id, now))
+            {
+                auto assort = it->second;
+                lock.unlock();
+
+                return AssembleTraderItems(trader_id, *assort.first, *assort.second);
+            }
+
+            resupply_known = IsTraderResupplyKnown(trader_id, now);
+        }
+
+        // Next resupply time tells how long assort can be served from memory
+        if (!resupply_known)
+        {
+            GetTrader(trader_id);
+        }
+
+        auto items = std::make_shared<const json>(GetTraderItemsRaw(trader_id));
+        auto prices = std::make_shared<const json>(GetTraderPricesRaw(trader_id));
+
+        {
+            std::lock_guard <std::mutex> lock(m_pkCacheMutex);
+            StoreTraderAssort(trader_id, items, prices);
+        }
+
+        return AssembleTraderItems(trader_id, *items, *prices);
+    }
+
+    // Barter schemes and prices are lists of schemes, [[{ _tpl, count }, ...], ...]; traders only offer first one
+    static void ParseTraderCosts(const json& schemes, const char* name, std::vector <quicktype::TraderBarterItem>& costs)
+    {
+        if (!schemes.is_array() || schemes.empty())
+        {
+            return;
+        }
+
+        const auto& scheme = schemes.front();
+        costs.reserve(costs.size() + scheme.size());
+
+        for (const auto& entry : scheme)
+        {
+            if (!entry.is_object())
+            {
+                throw TarkovAPIException(Error::JsonBadFormat, fmt::format("{}.type() != nlohmann::json::object()", name));
+            }
+
+            auto tpl = entry.find("_tpl");
+            auto count = entry.find("count");
+            if (tpl == entry.end() || count == entry.end())
+            {
+                throw TarkovAPIException(Error::JsonBadFormat, fmt::format("!{0}.contains('_tpl') || !{0}.contains('count')", name));
+            }
+
+            costs.emplace_back(quicktype::TraderBarterItem{ tpl->get<ObjectId>(), count->get<double>() });
+        }
+    }
+
+    std::vector <quicktype::TraderItem> TarkovAPIManager::AssembleTraderItems(const std::string& trader_id, const json& items, const json& prices)
+    {
+        TRACE_FUNCTION();
 
         if (!items.contains("barter_scheme"))
         {
@@ -993,106 +1911,302 @@ namespace TarkovAPI
             throw TarkovAPIException(Error::JsonParseFailed, "items::loyal_level_items");
         }
 
-        auto barter_scheme = items["barter_scheme"];
+        // Assort is walked by reference, it's shared with the cache and nothing of it is copied
+        const auto& barter_scheme = items["barter_scheme"];
         if (barter_scheme.empty())
         {
             throw TarkovAPIException(Error::NullDataForParse, "barter_scheme");
         }
 
-        auto loyal_level_items = items["loyal_level_items"];
+        const auto& loyal_level_items = items["loyal_level_items"];
         if (loyal_level_items.empty())
         {
             throw TarkovAPIException(Error::NullDataForParse, "loyal_level_items");
         }
 
-        for (const auto& item : items["items"].items())
+        const auto& assort_items = items["items"];
+
+        auto result = std::vector <quicktype::TraderItem>();
+        result.reserve(assort_items.size());
+
+        for (const auto& ctx : assort_items)
         {
-            auto ctx = item.value();
+            if (ctx.empty() || !ctx.contains("_id"))
+            {
+                continue;
+            }
 
-            if (ctx.empty() || (ctx.contains("parentId") && ctx["parentId"] != "hideout") || !ctx.contains("_id"))
+            // Attachments of an offered item have another item as parent
+            auto parent = ctx.find("parentId");
+            if (parent != ctx.end() && (!parent->is_string() || parent->get_ref<const std::string&>() != "hideout"))
             {
                 continue;
             }
 
-            auto item_data = parse_trader_item(ctx);
+            const auto& item_id = ctx["_id"].get_ref<const std::string&>(); // assort tables are keyed by text form
 
-            if (!loyal_level_items.contains(item_data._id))
+            auto loyalty_level = loyal_level_items.find(item_id);
+            if (loyalty_level == loyal_level_items.end())
             {
                 Log(__FUNCTION__, LL_ERR, "Loyalty level could not be mapped.");
                 continue;
             }
-            auto loyalty_level = loyal_level_items[item_data._id];
 
-            auto item_costs_container = std::vector <quicktype::TraderBarterItem>();
+            auto item_data = parse_trader_item(ctx);
+            item_data.loyalty_level = loyalty_level->get<int64_t>();
 
-            if (!barter_scheme.contains(item_data._id))
+            auto barter_items = barter_scheme.find(item_id);
+            if (barter_items != barter_scheme.end())
+            {
+                ParseTraderCosts(*barter_items, "barter_item", item_data.costs);
+            }
+            else
             {
-                if (!prices.contains(item_data._id))
+                auto item_prices = prices.find(item_id);
+                if (item_prices == prices.end())
                 {
-                    Log(__FUNCTION__, LL_CRI, fmt::format("Any price or barter data could not found! Trader: {} Item: '{}' - '{}", trader_id, item_data._id, item_data._tpl));
+                    Log(__FUNCTION__, LL_CRI, fmt::format("Any price or barter data could not found! Trader: {} Item: '{}' - '{}", trader_id, item_id, item_data._tpl.ToString()));
                     continue;
                 }
-                else
+                ParseTraderCosts(*item_prices, "price_item", item_data.costs);
+            }
+
+            result.emplace_back(std::move(item_data));
+        }
+
+        return result;
+    }
+
+    std::shared_ptr <const TraderCatalog> TarkovAPIManager::GetAllTraderItems()
+    {
+        TRACE_FUNCTION();
+
+        {
+            std::lock_guard <std::mutex> lock(m_pkCacheMutex);
+
+            const auto now = GetUnixTime();
+            if (m_pkTraderCatalog)
+            {
+                const auto& cached_ids = m_pkTraderCatalog->GetTraderIds();
+                if (std::none_of(cached_ids.begin(), cached_ids.end(), [this, now](const std::string& trader_id) { return IsTraderAssortStale(trader_id, now); }))
+                {
+                    return m_pkTraderCatalog;
+                }
+            }
+        }
+
+        auto traders = GetTraders();
+        if (!traders.is_array())
+        {
+            throw TarkovAPIException(Error::JsonBadFormat, "traders.type() != nlohmann::json::array()");
+        }
+
+        // Assort changes after listing, e.g. by a trade, are checked before catalog is kept
+        auto generation = uint64_t(0);
+        {
+            std::lock_guard <std::mutex> lock(m_pkCacheMutex);
+            generation = m_nTraderAssortGeneration;
+        }
+
+        struct PendingAssort
+        {
+            size_t slot{ 0 }; // position in trader_ids
+            std::string trader_id;
+            JsonSnapshot items; // set when cached
+            JsonSnapshot prices;
+            std::future <json> items_request;
+            std::future <json> prices_request;
+        };
+
+        auto trader_ids = std::vector <std::string>();
+        trader_ids.reserve(traders.size());
+        for (const auto& trader : traders)
+        {
+            auto id = trader.find("_id");
+            if (id != trader.end() && id->is_string())
+            {
+                trader_ids.emplace_back(id->get<std::string>());
+            }
+        }
+
+        // Slot of a trader is set only once its assort is decoded
+        auto decoded = std::vector <std::pair <std::string, std::vector <quicktype::TraderItem>>>(trader_ids.size());
+        std::atomic <bool> complete{ true };
+
+        // A finished trader is decoded by a fixed set of workers while requests of next ones are still in flight
+        struct DecodeJob
+        {
+            size_t slot;
+            std::string trader_id;
+            JsonSnapshot items;
+            JsonSnapshot prices;
+        };
+        struct DecodePool
+        {
+            std::mutex mutex;
+            std::condition_variable condition;
+            std::deque <DecodeJob> jobs;
+            bool closed{ false };
+            std::vector <std::thread> workers;
+
+            ~DecodePool()
+            {
+                Join();
+            }
+
+            void Push(DecodeJob&& job)
+            {
+                {
+                    std::lock_guard <std::mutex> lock(mutex);
+                    jobs.emplace_back(std::move(job));
+                }
+                condition.notify_one();
+            }
+
+            bool Pop(DecodeJob& job)
+            {
+                std::unique_lock <std::mutex> lock(mutex);
+                condition.wait(lock, [this] { return !jobs.empty() || closed; });
+                if (jobs.empty())
+                {
+                    return false;
+                }
+                job = std::move(jobs.front());
+                jobs.pop_front();
+                return true;
+            }
+
+            // Workers finish queued jobs first
+            void Join()
+            {
                 {
-                    auto item_prices = prices[item_data._id][0];
+                    std::lock_guard <std::mutex> lock(mutex);
+                    closed = true;
+                }
+                condition.notify_all();
 
-                    for (const auto& price_item : item_prices.items())
+                for (auto& worker : workers)
+                {
+                    if (worker.joinable())
                     {
-                        if (price_item.value().type() != nlohmann::json::object())
-                        {
-                            throw TarkovAPIException(Error::JsonBadFormat, "price_item.value().type() != nlohmann::json::object()");
-                        }
-
-                        auto price_item_ctx = price_item.value();
-                        if (!price_item_ctx.contains("_tpl") || !price_item_ctx.contains("count"))
-                        {
-                            throw TarkovAPIException(Error::JsonBadFormat, "!price_item_ctx.contains('_tpl') ||!ctx.contains('count')");
-                        }
-
-                        quicktype::TraderBarterItem price_node{};
-                        price_node._tpl = price_item_ctx["_tpl"].get<std::string>();
-                        price_node.count = price_item_ctx["count"].get<double>();
-                        item_costs_container.emplace_back(price_node);
+                        worker.join();
                     }
                 }
             }
+        } pool;
 
-            auto barter_items = barter_scheme[item_data._id][0];
-            for (const auto& barter_item : barter_items.items())
-            {
-                if (barter_item.value().type() != nlohmann::json::object())
+        for (size_t i = 0; i < std::min(TRADER_SWEEP_CONCURRENCY, trader_ids.size()); ++i)
+        {
+            pool.workers.emplace_back([this, &pool, &decoded, &complete] {
+                auto job = DecodeJob{};
+                while (pool.Pop(job))
                 {
-                    throw TarkovAPIException(Error::JsonBadFormat, "barter_item.value().type() != nlohmann::json::object()");
+                    try
+                    {
+                        decoded[job.slot] = std::make_pair(job.trader_id, AssembleTraderItems(job.trader_id, *job.items, *job.prices));
+                    }
+                    catch (const std::exception& ex)
+                    {
+                        Log(__FUNCTION__, LL_ERR, fmt::format("Assort of trader: {} could not be decoded: {}", job.trader_id, ex.what()));
+                        complete = false;
+                    }
                 }
+            });
+        }
 
-                auto barter_item_ctx = barter_item.value();
-                if (!barter_item_ctx.contains("_tpl") || !barter_item_ctx.contains("count"))
+        // Each request waits for a token of trading host's budget
+        auto pending = std::deque <PendingAssort>();
+
+        size_t next = 0;
+        while (next < trader_ids.size() || !pending.empty())
+        {
+            while (next < trader_ids.size() && pending.size() < TRADER_SWEEP_CONCURRENCY)
+            {
+                auto assort = PendingAssort{};
+                assort.slot = next;
+                assort.trader_id = trader_ids[next++];
                 {
-                    throw TarkovAPIException(Error::JsonBadFormat, "!barter_item_ctx.contains('_tpl') ||!ctx.contains('count')");
+                    std::lock_guard <std::mutex> lock(m_pkCacheMutex);
+
+                    auto it = m_pkTraderAssorts.find(assort.trader_id);
+                    if (it != m_pkTraderAssorts.end() && !IsTraderAssortStale(assort.trader_id, GetUnixTime()))
+                    {
+                        assort.items = it->second.first;
+                        assort.prices = it->second.second;
+                    }
                 }
 
-                quicktype::TraderBarterItem barter_node{};
-                barter_node._tpl = barter_item_ctx["_tpl"].get<std::string>();
-                barter_node.count = barter_item_ctx["count"].get<double>();
-                item_costs_container.emplace_back(barter_node);
+                if (!assort.items)
+                {
+                    assort.items_request = GetTraderItemsRawAsync(assort.trader_id, RequestPriority::Bulk);
+                    assort.prices_request = GetTraderPricesRawAsync(assort.trader_id, RequestPriority::Bulk);
+                }
+                pending.emplace_back(std::move(assort));
             }
 
-            result.emplace_back(
-                quicktype::TraderItem{
-                    item_data._id,
-                    item_data._tpl,
-                    item_data.upd,
-                    item_costs_container,
-                    loyalty_level
+            auto assort = std::move(pending.front());
+            pending.pop_front();
+
+            if (!assort.items)
+            {
+                try
+                {
+                    assort.items = std::make_shared<const json>(assort.items_request.get());
+                    assort.prices = std::make_shared<const json>(assort.prices_request.get());
+                }
+                catch (const std::exception& ex)
+                {
+                    Log(__FUNCTION__, LL_ERR, fmt::format("Assort of trader: {} could not be loaded: {}", assort.trader_id, ex.what()));
+                    complete = false;
+                    continue;
+                }
+
+                std::lock_guard <std::mutex> lock(m_pkCacheMutex);
+
+                // Own stores don't count as a change, catalog is built from them
+                auto unchanged = (m_nTraderAssortGeneration == generation);
+                StoreTraderAssort(assort.trader_id, assort.items, assort.prices);
+                if (unchanged)
+                {
+                    generation = m_nTraderAssortGeneration;
                 }
-            );
+            }
+
+            auto job = DecodeJob{};
+            job.slot = assort.slot;
+            job.trader_id = assort.trader_id;
+            job.items = assort.items;
+            job.prices = assort.prices;
+            pool.Push(std::move(job));
         }
+        pool.Join();
 
-        return result;
+        // Traders left out keep an empty slot
+        auto assorts = std::vector <std::pair <std::string, std::vector <quicktype::TraderItem>>>();
+        assorts.reserve(decoded.size());
+        for (auto& assort : decoded)
+        {
+            if (!assort.first.empty())
+            {
+                assorts.emplace_back(std::move(assort));
+            }
+        }
+
+        auto catalog = std::make_shared<const TraderCatalog>(std::move(assorts));
+
+        // Assorts changed meanwhile, e.g. by a trade, or a trader is missing: catalog is returned but not kept, next call loads again
+        std::lock_guard <std::mutex> lock(m_pkCacheMutex);
+        if (complete && m_nTraderAssortGeneration == generation)
+        {
+            m_pkTraderCatalog = catalog;
+        }
+        return catalog;
     }
 
     json TarkovAPIManager::SellItem(const std::string& trader_id, const std::string& item_id, int64_t quantity)
     {
+        TRACE_FUNCTION();
+
         if (trader_id.empty() || item_id.empty() || !quantity)
         {
             throw TarkovAPIException(Error::InvalidParameter);
@@ -1122,7 +2236,9 @@ namespace TarkovAPI
         };
 
         auto req = serialize_market_sell_request(body).dump();
-        auto res = Post_Json(url, req);
+        auto res = PostItemsMoving(url, req);
+
+        InvalidateTraderAssort(trader_id);
 
         if (!OnResponseHandle(__FUNCTION__, res.err, res.data.dump()) ||
             !res.data.contains("items"))
@@ -1135,6 +2251,8 @@ namespace TarkovAPI
 
     json TarkovAPIManager::OfferItem(const std::vector <std::string>& items, const quicktype::OfferRequirementContext& requirement, bool sell_all)
     {
+        TRACE_FUNCTION();
+
         if (items.empty() || (requirement._tpl.empty() && !requirement.price))
         {
             throw TarkovAPIException(Error::InvalidParameter);
@@ -1164,7 +2282,7 @@ namespace TarkovAPI
         };
 
         auto req = serialize_market_offer_request(body).dump();
-        auto res = Post_Json(url, req);
+        auto res = PostItemsMoving(url, req);
 
         if (!OnResponseHandle(__FUNCTION__, res.err, res.data.dump()))
         {
@@ -1184,6 +2302,8 @@ namespace TarkovAPI
 
     json TarkovAPIManager::StackItem(const std::string& from_item_id, const std::string& to_item_id, int64_t count)
     {
+        TRACE_FUNCTION();
+
         if (from_item_id.empty() || from_item_id.empty())
         {
             throw TarkovAPIException(Error::InvalidParameter);
@@ -1233,176 +2353,347 @@ namespace TarkovAPI
             req = serialize_item_transfer_request(body).dump();
         }
 
-        auto res = Post_Json(url, req);
+        auto res = PostItemsMoving(url, req);
+
+        if (!OnResponseHandle(__FUNCTION__, res.err, res.data.dump()))
+        {
+            throw TarkovAPIException(Error::ResponseHandleFailed, res.errmsg);
+        }
+
+        return res.data;
+    }
+
+    json TarkovAPIManager::MoveItem(const std::string& item_id, const quicktype::ItemMoveTo& destination)
+    {
+        TRACE_FUNCTION();
+
+        if (item_id.empty() || destination.id.empty())
+        {
+            throw TarkovAPIException(Error::InvalidParameter);
+        }
+
+        auto url = fmt::format(
+            "{}/client/game/profile/items/moving",
+            PROD_ENDPOINT
+        );
+
+        auto body = quicktype::ItemMoveBody
+        {
+            std::vector <quicktype::ItemMoveDatum>
+            {
+                quicktype::ItemMoveDatum
+                {
+                    "Move",
+                    item_id,
+                    quicktype::ItemMoveTo
+                    {
+                        destination.id,
+                        destination.container,
+                        destination.location
+                    }
+                }
+            },
+            2
+        };
+
+        auto req = serialize_item_move_request(body).dump();
+        auto res = PostItemsMoving(url, req);
+
+        if (!OnResponseHandle(__FUNCTION__, res.err, res.data.dump()))
+        {
+            throw TarkovAPIException(Error::ResponseHandleFailed, res.errmsg);
+        }
+
+        return res.data;
+    }
+
+    ActionBatchResult TarkovAPIManager::ExecuteActions(const ActionBatch& batch)
+    {
+        TRACE_FUNCTION();
+
+        if (batch.Empty())
+        {
+            throw TarkovAPIException(Error::InvalidParameter);
+        }
+
+        auto url = fmt::format(
+            "{}/client/game/profile/items/moving",
+            PROD_ENDPOINT
+        );
+
+        auto req = batch.Serialize().dump();
+        auto res = PostItemsMoving(url, req);
+
+        if (!OnResponseHandle(__FUNCTION__, res.err, res.data.dump()))
+        {
+            throw TarkovAPIException(Error::ResponseHandleFailed, res.errmsg);
+        }
+
+        auto result = batch.MapResults(res.data);
+        auto traded = std::vector <std::string>();
+        for (const auto& action : result.results)
+        {
+            if (!action.succeeded)
+            {
+                Log(__FUNCTION__, LL_ERR, fmt::format("Action: {} ({}) failed! Error: {} ({})", action.index, action.action, action.errmsg, action.err));
+                continue;
+            }
+            if (action.action == "TradingConfirm" && std::find(traded.begin(), traded.end(), action.trader_id) == traded.end())
+            {
+                traded.emplace_back(action.trader_id);
+            }
+        }
+
+        // Only traders a trade went through with changed their stock
+        for (const auto& trader_id : traded)
+        {
+            InvalidateTraderAssort(trader_id);
+        }
+        return result;
+    }
+
+    json TarkovAPIManager::FetchMyInventory()
+    {
+        TRACE_FUNCTION();
+
+        auto me = GetMyProfile();
+        if (!me.contains("_id"))
+        {
+            throw TarkovAPIException(Error::JsonParseFailed, "!me.contains('_id')");
+        }
+
+        auto profile_id = me["_id"].get<std::string>();
+
+        auto selected = false;
+        {
+            std::lock_guard <std::mutex> lock(m_pkCacheMutex);
+            selected = (m_stSelectedProfileID == profile_id);
+        }
+        if (!selected)
+        {
+            SelectProfile(profile_id);
+        }
+
+        if (!me.contains("Info") || !me["Info"].contains("Nickname"))
+        {
+            throw TarkovAPIException(Error::JsonParseFailed, "!me.contains('Info') || !me['Info'].contains('Nickname')");
+        }
+
+        auto inventory = me["Inventory"];
+        if (inventory.empty())
+        {
+            throw TarkovAPIException(Error::JsonParseFailed, "inventory.empty()");
+        }
+
+        if (inventory["items"].empty())
+        {
+            throw TarkovAPIException(Error::JsonParseFailed, "items.empty()");
+        }
+
+        return inventory;
+    }
+
+    json TarkovAPIManager::GetMyItems()
+    {
+        TRACE_FUNCTION();
+
+        return FetchMyInventory()["items"];
+    }
+
+    std::shared_ptr <const Inventory> TarkovAPIManager::GetMyInventory()
+    {
+        TRACE_FUNCTION();
+
+        auto inventory = std::atomic_load(&m_pkInventory);
+        if (inventory)
+        {
+            return inventory;
+        }
+        return ReloadInventory();
+    }
+
+    std::shared_ptr <const Inventory> TarkovAPIManager::ReloadInventory()
+    {
+        TRACE_FUNCTION();
+
+        uint64_t generation = 0;
+        {
+            std::lock_guard <std::mutex> lock(m_pkCacheMutex);
+            generation = m_nInventoryGeneration;
+        }
+
+        auto inventory = std::make_shared<const Inventory>(FetchMyInventory());
+
+        std::lock_guard <std::mutex> lock(m_pkCacheMutex);
+
+        // Profile may predate an items/moving response received meanwhile, next query downloads it again
+        if (generation == m_nInventoryGeneration)
+        {
+            std::atomic_store(&m_pkInventory, inventory);
+            m_pkContainerIndex.reset();
+            m_pkCacheTimes["inventory"] = std::chrono::steady_clock::now();
+        }
+        return inventory;
+    }
+
+    uint64_t TarkovAPIManager::GetRoubleCount()
+    {
+        TRACE_FUNCTION();
+
+        return GetMyInventory()->GetStackTotal(ROUBLE_OBJECT_ID);
+    }
+
+    std::string TarkovAPIManager::GetMainStashID()
+    {
+        TRACE_FUNCTION();
+
+        auto inventory = GetMyInventory();
+        if (!inventory->GetStashId().IsNull())
+        {
+            return inventory->GetStashId().ToString();
+        }
+
+        // Older profiles have no stash field, first stash ID is parent of all other single items
+        auto locale_index = GetLocaleIndex("en");
+
+        auto count = std::min<uint32_t>(static_cast<uint32_t>(inventory->GetCount()), MAXIMUM_STASH_SIZE);
+        for (uint32_t i = 0; i < count; ++i)
+        {
+            if (FindItemLocale(locale_index, inventory->GetTemplate(i).ToString()).name == "Stash")
+            {
+                return inventory->GetId(i).ToString();
+            }
+        }
+        return std::string();
+    }
+
+    quicktype::ItemMoveLocation TarkovAPIManager::FindBlankStashPos(int32_t item_width, int32_t item_height)
+    {
+        TRACE_FUNCTION();
 
-        if (!OnResponseHandle(__FUNCTION__, res.err, res.data.dump()))
+        auto stash_id = GetMyInventory()->GetStashId();
+        if (stash_id.IsNull())
         {
-            throw TarkovAPIException(Error::ResponseHandleFailed, res.errmsg);
+            stash_id = ObjectId(GetMainStashID());
         }
 
-        return res.data;
+        // Stash size depends on game edition, it's the first grid of stash template
+        return FindBlankSlot(stash_id, item_width, item_height, ObjectId(), false).location;
     }
 
-    json TarkovAPIManager::MoveItem(const std::string& item_id, const quicktype::ItemMoveTo& destination)
+    quicktype::ItemMoveLocation TarkovAPIManager::FindBlankStashPos(const std::string& schema_id)
     {
-        if (item_id.empty() || destination.id.empty())
+        TRACE_FUNCTION();
+
+        auto items = GetItems();
+        if (!items->contains(schema_id))
         {
-            throw TarkovAPIException(Error::InvalidParameter);
+            throw TarkovAPIException(Error::ItemNotFound, schema_id);
         }
 
-        auto url = fmt::format(
-            "{}/client/game/profile/items/moving",
-            PROD_ENDPOINT
-        );
+        auto props = items->at(schema_id).value("_props", json::object());
+        return FindBlankStashPos(props.value("Width", 1), props.value("Height", 1));
+    }
 
-        auto body = quicktype::ItemMoveBody
-        {
-            std::vector <quicktype::ItemMoveDatum>
-            {
-                quicktype::ItemMoveDatum
-                {
-                    "Move",
-                    item_id,
-                    quicktype::ItemMoveTo
-                    {
-                        destination.id,
-                        destination.container,
-                        destination.location
-                    }
-                }
-            },
-            2
-        };
+    quicktype::ItemMoveTo TarkovAPIManager::FindBlankSlot(const std::string& root_id, int32_t item_width, int32_t item_height)
+    {
+        TRACE_FUNCTION();
 
-        auto req = serialize_item_move_request(body).dump();
-        auto res = Post_Json(url, req);
+        return FindBlankSlot(ObjectId(root_id), item_width, item_height, ObjectId(), true);
+    }
 
-        if (!OnResponseHandle(__FUNCTION__, res.err, res.data.dump()))
+    quicktype::ItemMoveTo TarkovAPIManager::FindBlankSlot(const std::string& root_id, const std::string& schema_id)
+    {
+        TRACE_FUNCTION();
+
+        auto items = GetItems();
+        if (!items->contains(schema_id))
         {
-            throw TarkovAPIException(Error::ResponseHandleFailed, res.errmsg);
+            throw TarkovAPIException(Error::ItemNotFound, schema_id);
         }
 
-        return res.data;
+        auto props = items->at(schema_id).value("_props", json::object());
+        return FindBlankSlot(ObjectId(root_id), props.value("Width", 1), props.value("Height", 1), ObjectId(schema_id), true);
     }
 
-    json TarkovAPIManager::GetMyItems()
+    std::pair <int32_t, int32_t> TarkovAPIManager::GetItemSize(const std::string& item_id)
     {
-        auto me = GetMyProfile();
-        if (!me.contains("_id"))
+        TRACE_FUNCTION();
+
+        auto size = std::make_pair(0, 0);
+        if (!GetContainerIndex()->GetItemSize(ObjectId(item_id), size.first, size.second))
         {
-            throw TarkovAPIException(Error::JsonParseFailed, "!me.contains('_id')");
+            throw TarkovAPIException(Error::ItemNotFound, item_id);
         }
+        return size;
+    }
 
-        SelectProfile(me["_id"].get<std::string>());
-        if (!me.contains("Info") || !me["Info"].contains("Nickname"))
+    StashDefragPlan TarkovAPIManager::PlanStashDefrag(int32_t item_width, int32_t item_height, size_t max_moves)
+    {
+        TRACE_FUNCTION();
+
+        if (item_width <= 0 || item_height <= 0)
         {
-            throw TarkovAPIException(Error::JsonParseFailed, "!me.contains('Info') || !me['Info'].contains('Nickname')");
+            throw TarkovAPIException(Error::InvalidParameter);
         }
 
-        auto inventory = me["Inventory"];
-        if (inventory.empty())
+        auto stash_id = GetMyInventory()->GetStashId();
+        if (stash_id.IsNull())
         {
-            throw TarkovAPIException(Error::JsonParseFailed, "inventory.empty()");
+            stash_id = ObjectId(GetMainStashID());
         }
 
-        auto items = inventory["items"];
-        if (items.empty())
+        auto plan = DefragPlan();
+        if (!GetContainerIndex()->PlanDefrag(stash_id, item_width, item_height, max_moves, plan))
         {
-            throw TarkovAPIException(Error::JsonParseFailed, "items.empty()");
+            throw TarkovAPIException(Error::NoStashSpace, fmt::format("{}x{}", item_width, item_height));
         }
 
-        return items;
-    }
-
-    uint64_t TarkovAPIManager::GetRoubleCount()
-    {
-        auto items = GetMyItems();
+        auto result = StashDefragPlan();
+        result.target = quicktype::ItemMoveTo{ stash_id.ToString(), plan.grid, quicktype::ItemMoveLocation{ plan.target.x, plan.target.y, plan.target.rotated ? 1 : 0 } };
 
-        uint64_t roubleCount = 0;
-        auto iter = std::find_if(items.begin(), items.end(), [&roubleCount](const nlohmann::json& root)
-            {
-                if (root.is_object() && root.contains("_tpl") && root["_tpl"] == ROUBLE_ITEM_ID && root.contains("upd") && root["upd"].contains("StackObjectsCount"))
-                {
-                    roubleCount += root["upd"]["StackObjectsCount"].get<uint64_t>();
-                }
-                return false;
+        result.moves.reserve(plan.moves.size());
+        for (const auto& move : plan.moves)
+        {
+            result.moves.emplace_back(quicktype::ItemMoveDatum{
+                "Move",
+                move.item_id.ToString(),
+                quicktype::ItemMoveTo{ stash_id.ToString(), plan.grid, quicktype::ItemMoveLocation{ move.location.x, move.location.y, move.location.rotated ? 1 : 0 } }
             });
-        return roubleCount;
+        }
+        return result;
     }
 
-    std::string TarkovAPIManager::GetMainStashID()
+    quicktype::ItemMoveTo TarkovAPIManager::FindBlankSlot(const ObjectId& root_id, int32_t item_width, int32_t item_height, const ObjectId& schema_id, bool nested)
     {
-        auto my_items = GetMyItems();
-
-        auto main_stash_id = std::string();
-        for (auto i = 0; i < MAXIMUM_STASH_SIZE; ++i)
+        if (item_width <= 0 || item_height <= 0)
         {
-            auto item = my_items[i];
-            if (!item.empty())
-            {
-                if (GetItemName(item["_tpl"].get<std::string>()) == "Stash") // Find first stash ID, which is parent of all other single items
-                {
-                    main_stash_id = item["_id"];
-                    break;
-                }
-            }
+            throw TarkovAPIException(Error::InvalidParameter);
         }
-        return main_stash_id;
-    }
-
-    quicktype::ItemMoveLocation TarkovAPIManager::FindBlankStashPos() // Not works ATM
-    {   
-        quicktype::ItemMoveLocation a; 
-        return a;
-        
-        auto stash_helper = StashHelper{10, 26};
-        auto items = GetItems();
 
-        auto main_stash_id = GetMainStashID();
+        auto index = GetContainerIndex();
+        if (index->GetInventory()->Find(root_id) == Inventory::NPOS)
+        {
+            throw TarkovAPIException(Error::ItemNotFound, root_id.ToString());
+        }
 
-        auto my_items = GetMyItems();
-        for (const auto& root : my_items)
+        auto placement = GridPlacement();
+        if (!index->FindBlank(root_id, item_width, item_height, placement, schema_id, nested))
         {
-                if (root.is_object() && root.contains("_tpl") &&
-                    root.contains("parentId") && root["parentId"].get<std::string>() == main_stash_id &&
-                    root.contains("location") && root["location"].is_object())
-                {
-                    auto x = root["location"]["x"].get<int32_t>() + 1;
-                    auto y = root["location"]["y"].get<int32_t>() + 1;
+            throw TarkovAPIException(Error::NoStashSpace, fmt::format("{}x{}", item_width, item_height));
+        }
 
-                    if (items.contains(root["_tpl"]))
-                    {
-                        auto item_data = items[root["_tpl"].get<std::string>()];
-                        if (item_data.is_object() && item_data.contains("_props") &&
-                            item_data["_props"].contains("Width") && item_data["_props"].contains("Height"))
-                        {
-                            auto width = item_data["_props"]["Width"].get<int32_t>();
-                            auto height = item_data["_props"]["Height"].get<int32_t>();
-                            // FIXME: Customized weapon sizes are not correct, it's just throw base weapon size
-
-                            if (root["location"]["r"].get<int64_t>())
-                                std::swap(width, height);
-
-                            auto stash_base_pos = ((y * stash_helper.GetWidth()) + x) - stash_helper.GetWidth();
-
-                            Log(__FUNCTION__, LL_SYS, fmt::format("{} / {} - {} ({})  | {} - {}",
-                                GetItemName(root["_tpl"].get<std::string>()), x, y, stash_base_pos, width, height));
-
-                            stash_helper.Put(
-                                stash_base_pos,
-                                width,
-                                height
-                            );
-                        }
-                    }
-                }
+        return quicktype::ItemMoveTo{
+            placement.container_id.ToString(),
+            placement.grid,
+            quicktype::ItemMoveLocation{ placement.location.x, placement.location.y, placement.location.rotated ? 1 : 0 }
         };
-        
-        stash_helper.Dump();
     }
 
     std::vector <quicktype::TraderBarterItem> TarkovAPIManager::FindItemStack(const std::string& schema_id, uint64_t required)
     {
+        TRACE_FUNCTION();
+
         auto container = std::vector <quicktype::TraderBarterItem>();
 
         if (schema_id.empty())
@@ -1410,38 +2701,20 @@ namespace TarkovAPI
             throw TarkovAPIException(Error::InvalidParameter);
         }
 
-        auto items = GetMyItems();
+        auto inventory = GetMyInventory();
 
-        uint64_t roubleCount = 0;
-        auto iter = std::find_if(items.begin(), items.end(), [&schema_id, &required, &container](const nlohmann::json& root)
+        for (auto i : inventory->FindByTemplate(ObjectId(schema_id)))
+        {
+            auto count = inventory->GetStackCount(i);
+            if (count >= required)
             {
-                if (root.is_object() && root.contains("_tpl") && root["_tpl"] == schema_id)
-                {
-                    auto count = (root.contains("upd") && root["upd"].contains("StackObjectsCount")) ? root["upd"]["StackObjectsCount"].get<uint64_t>() : 1;
-                    if (count >= required)
-                    {
-                        container.emplace_back(quicktype::TraderBarterItem{ root["_id"].get<std::string>(), static_cast<double>(required) });
-                        return true;
-                    }
-                    else
-                    {
-                        container.emplace_back(quicktype::TraderBarterItem{ root["_id"].get<std::string>(), static_cast<double>(count) });
-                        required -= count;
-                    }
+                container.emplace_back(quicktype::TraderBarterItem{ inventory->GetId(i), static_cast<double>(required) });
+                break;
+            }
 
-                    if (!required)
-                    {
-                        return true;
-                    }
-                }
-                return false;
-            });
-        /*
-        if (iter == items.end())
-        {
-            container.clear();
+            container.emplace_back(quicktype::TraderBarterItem{ inventory->GetId(i), static_cast<double>(count) });
+            required -= count;
         }
-        */
         return container;
     }
 
@@ -1457,39 +2730,195 @@ namespace TarkovAPI
         return whole;
     }
 
-    std::string TarkovAPIManager::GetItemName(const std::string& schema_id)
+    ItemLocale TarkovAPIManager::FindItemLocale(const std::shared_ptr <const LocaleIndex>& index, const std::string& schema_id)
     {
-        auto locale = GetI18n("en");
-        if (locale.empty())
+        auto item = index->FindItem(schema_id);
+        if (!item)
         {
-            throw TarkovAPIException(Error::NullDataForParse, "locale");
+            throw TarkovAPIException(Error::ItemNotFound, schema_id);
         }
+        return *item;
+    }
 
-        auto target = std::string();
-        auto iter = std::find_if(locale.begin(), locale.end(), [&target, &schema_id](const nlohmann::json& root)
-            {
-                if (root.is_object())
-                {
-                    for (const auto& it : root.items())
-                    {
-                        if (it.value().is_object())
-                        {
-                            if (it.key() == schema_id && it.value().type() == nlohmann::json::object() && it.value().contains("Name"))
-                            {
-                                target = it.value()["Name"].get<std::string>();
-                                return true;
-                            }
-                        }
-                    }
-                }
-                return false;
-            });
+    std::string TarkovAPIManager::GetItemName(const std::string& schema_id, const std::string& language)
+    {
+        TRACE_FUNCTION();
+
+        auto index = GetLocaleIndex(language);
+        return std::string(FindItemLocale(index, schema_id).name);
+    }
+
+    std::string TarkovAPIManager::GetItemShortName(const std::string& schema_id, const std::string& language)
+    {
+        TRACE_FUNCTION();
+
+        auto index = GetLocaleIndex(language);
+        return std::string(FindItemLocale(index, schema_id).short_name);
+    }
+
+    std::string TarkovAPIManager::GetItemDescription(const std::string& schema_id, const std::string& language)
+    {
+        TRACE_FUNCTION();
+
+        auto index = GetLocaleIndex(language);
+        return std::string(FindItemLocale(index, schema_id).description);
+    }
+
+    std::future <json> TarkovAPIManager::GetProfilesAsync()
+    {
+        auto url = fmt::format(
+            "{}/client/game/profile/list",
+            PROD_ENDPOINT
+        );
+
+        return RequestAsync(__FUNCTION__, url);
+    }
+
+    std::future <json> TarkovAPIManager::GetFriendsAsync()
+    {
+        auto url = fmt::format(
+            "{}/client/friend/list",
+            PROD_ENDPOINT
+        );
+
+        return RequestAsync(__FUNCTION__, url);
+    }
+
+    std::future <json> TarkovAPIManager::GetWeatherAsync()
+    {
+        auto url = fmt::format(
+            "{}/client/weather",
+            PROD_ENDPOINT
+        );
+
+        return RequestAsync(__FUNCTION__, url);
+    }
+
+    std::future <json> TarkovAPIManager::GetTradersAsync()
+    {
+        auto url = fmt::format(
+            "{}/client/trading/api/getTradersList",
+            TRADING_ENDPOINT
+        );
+
+        return RequestAsync(__FUNCTION__, url);
+    }
+
+    std::future <json> TarkovAPIManager::GetTraderAsync(const std::string& trader_id)
+    {
+        if (trader_id.empty())
+        {
+            throw TarkovAPIException(Error::InvalidParameter);
+        }
+
+        auto url = fmt::format(
+            "{}/client/trading/api/getTrader/{}",
+            TRADING_ENDPOINT, trader_id
+        );
+
+        return RequestAsync(__FUNCTION__, url);
+    }
 
-        if (iter == locale.end())
+    std::future <json> TarkovAPIManager::GetTraderItemsRawAsync(const std::string& trader_id, RequestPriority priority)
+    {
+        if (trader_id.empty())
         {
-            throw TarkovAPIException(Error::ItemNotFound, schema_id);
+            throw TarkovAPIException(Error::InvalidParameter);
+        }
+
+        auto url = fmt::format(
+            "{}/client/trading/api/getTraderAssort/{}",
+            TRADING_ENDPOINT, trader_id
+        );
+
+        return RequestAsync(__FUNCTION__, url, "", priority);
+    }
+
+    std::future <json> TarkovAPIManager::GetTraderPricesRawAsync(const std::string& trader_id, RequestPriority priority)
+    {
+        if (trader_id.empty())
+        {
+            throw TarkovAPIException(Error::InvalidParameter);
+        }
+
+        auto url = fmt::format(
+            "{}/client/trading/api/getUserAssortPrice/trader/{}",
+            TRADING_ENDPOINT, trader_id
+        );
+
+        return RequestAsync(__FUNCTION__, url, "", priority);
+    }
+
+    std::future <json> TarkovAPIManager::SearchMarketAsync(const quicktype::MarketFilterBody& filter)
+    {
+        if (!filter.limit)
+        {
+            throw TarkovAPIException(Error::InvalidParameter);
+        }
+
+        auto url = fmt::format(
+            "{}/client/ragfair/find",
+            RAGFAIR_ENDPOINT
+        );
+
+        return RequestAsync(__FUNCTION__, url, serialize_market_finder(filter).dump());
+    }
+
+    std::future <json> TarkovAPIManager::GetItemPriceAsync(const std::string& schema_id)
+    {
+        if (schema_id.empty())
+        {
+            throw TarkovAPIException(Error::InvalidParameter);
         }
 
-        return target;
+        auto url = fmt::format(
+            "{}/client/ragfair/itemMarketPrice",
+            RAGFAIR_ENDPOINT
+        );
+
+        json body{};
+        body["templateId"] = schema_id;
+
+        return RequestAsync(__FUNCTION__, url, body.dump());
+    }
+
+    std::future <json> TarkovAPIManager::GetMailListAsync()
+    {
+        auto url = fmt::format(
+            "{}/client/mail/dialog/list",
+            PROD_ENDPOINT
+        );
+
+        json body{};
+        body["crc"] = 0;
+
+        return RequestAsync(__FUNCTION__, url, body.dump());
+    }
+
+    std::future <json> TarkovAPIManager::GetMailAsync(const std::string& mail_id, int64_t type)
+    {
+        auto url = fmt::format(
+            "{}/client/mail/dialog/view",
+            PROD_ENDPOINT
+        );
+
+        json body{};
+        body["dialogId"] = mail_id;
+        body["type"] = type;
+
+        return RequestAsync(__FUNCTION__, url, body.dump());
+    }
+
+    std::future <json> TarkovAPIManager::GetMailAttachmentsAsync(const std::string& mail_id)
+    {
+        auto url = fmt::format(
+            "{}/client/mail/dialog/getAllAttachments",
+            PROD_ENDPOINT
+        );
+
+        json body{};
+        body["dialogId"] = mail_id;
+
+        return RequestAsync(__FUNCTION__, url, body.dump());
     }
 };
@@ -6,12 +6,27 @@
 #include <map>
 #include <sstream>
 #include <functional>
+#include <future>
+#include <atomic>
+#include <mutex>
+#include <chrono>
 #include <ctime>
 #include <limits>
 
 #include "Constants.hpp"
 #include "Exception.hpp"
 #include "StashHelper.hpp"
+#include "HttpClient.hpp"
+#include "Metrics.hpp"
+#include "RequestScheduler.hpp"
+#include "TimerService.hpp"
+#include "GameDataCache.hpp"
+#include "LocaleIndex.hpp"
+#include "Inventory.hpp"
+#include "ContainerIndex.hpp"
+#include "TraderCatalog.hpp"
+#include "AsyncHttpClient.hpp"
+#include "ActionBatch.hpp"
 
 #include <cpr/cpr.h>
 #include <json.hpp>
@@ -20,8 +35,32 @@ namespace TarkovAPI
 {
 	using json = nlohmann::json;
 
+	// Immutable cached payload, holders keep it alive across refreshes; a refresh publishes a new snapshot
+	using JsonSnapshot = std::shared_ptr <const json>;
+
+	// Background jobs, zero interval disables a job
+	struct MaintenanceConfig
+	{
+		bool auto_start{ false }; // start jobs on every login, otherwise call StartMaintenance
+		std::chrono::seconds keep_alive_interval{ 300 };
+		std::chrono::seconds item_prices_interval{ 600 };
+		std::chrono::seconds trader_assort_interval{ 15 }; // resupply times are checked, only traders past theirs are fetched
+		std::chrono::seconds cache_expiry_interval{ 60 };
+		std::chrono::seconds cache_ttl{ 3600 };
+	};
+
+	// See TarkovAPIManager::PlanStashDefrag
+	struct StashDefragPlan
+	{
+		quicktype::ItemMoveTo target; // free area for item after moves, r is 1 when item has to be turned
+		std::vector <quicktype::ItemMoveDatum> moves;
+	};
+
 	class TarkovAPIManager
 	{
+	public:
+		using ResponseCallback = std::function<void(quicktype::ResponseBody&& response, std::exception_ptr error)>;
+
 	public:
 		virtual ~TarkovAPIManager();
 
@@ -33,16 +72,51 @@ namespace TarkovAPI
 	public:
 		TarkovAPIManager();
 
+		// Version checks and connection warm-up of prod/trading/ragfair hosts run side by side
 		bool InitializeTarkovAPIManager();
 		bool FinalizeTarkovAPIManager();
 
 		void Log(const std::string& func, int32_t level, const std::string& data);
 
+		void SetVersionCacheTTL(std::chrono::seconds ttl); // call before initialize, zero always checks versions
+		void SetDataCacheDirectory(const std::string& directory); // call before initialize, empty disables disk cache of static data; default is per-user, see GameDataCache::GetDefaultDirectory
+
 		static TarkovAPIManager* InstancePtr();
 		static TarkovAPIManager& Instance();
 
 		std::string Generate_Random_Hwid();
-		quicktype::ResponseBody Post_Json(const std::string& url, const std::string& body = "");
+		// Waits for admission by request scheduler, then sends request on calling thread
+		quicktype::ResponseBody Post_Json(const std::string& url, const std::string& body = "", RequestPriority priority = RequestPriority::Interactive);
+
+		// Non-blocking variants, all of them share one curl multi event loop
+		// Waits for a token of host's rate budget on calling thread, then sends request on async client
+		void Post_JsonAsync(const std::string& url, const std::string& body, ResponseCallback callback, RequestPriority priority = RequestPriority::Interactive);
+		std::future <json> RequestAsync(const std::string& func, const std::string& url, const std::string& body = "", RequestPriority priority = RequestPriority::Interactive);
+
+		// Records or replays Post_Json and launcher traffic, see TrafficCapture.hpp for file format
+		void EnableCapture(const std::string& path);
+		void EnableReplay(const std::string& path);
+
+		ConnectionStats GetConnectionStats() const;
+		std::map <std::string /* host */, ConnectionStats> GetConnectionStatsByHost() const;
+
+		// Per endpoint request counts, error codes, sizes and phase timings of Post_Json and launcher traffic
+		void EnableMetricsDump(const std::string& path, std::chrono::seconds interval = std::chrono::seconds(15));
+		std::vector <EndpointMetricsSnapshot> GetMetrics() const;
+		bool GetEndpointMetrics(const std::string& path, EndpointMetricsSnapshot& out) const;
+
+		// Request budget of Post_Json per endpoint host, requests_per_second <= 0 disables throttling
+		void SetDefaultRateBudget(const RateBudget& budget);
+		void SetRateBudget(const std::string& url, const RateBudget& budget);
+
+		// Keep-alive, cache refresh and expiry on timer service thread; restarts jobs when already running
+		void SetMaintenanceConfig(const MaintenanceConfig& config); // applied on next login or StartMaintenance
+		void StartMaintenance();
+		void StopMaintenance();
+		std::vector <TimerJobStats> GetMaintenanceStats() const;
+
+		// Chrome trace event JSON of API call spans is written to path on finalize, see Trace.hpp
+		void EnableTrace(const std::string& path);
 
 		bool OnResponseHandle(const std::string& func, int64_t error_code, const std::string& data);
 
@@ -53,7 +127,9 @@ namespace TarkovAPI
 		void Login_Session(const std::string& session, const std::string& hwid);
 
 		void KeepAlive();
-		json GetI18n(const std::string& language);
+		JsonSnapshot GetI18n(const std::string& language);
+		// Built once per loaded locale, views in it stay valid while returned pointer is held
+		std::shared_ptr <const LocaleIndex> GetLocaleIndex(const std::string& language = "en");
 		json GetWeather();
 
 		json GetProfiles();
@@ -61,14 +137,20 @@ namespace TarkovAPI
 		void SelectProfile(const std::string& user_id);
 		json GetFriends();
 
+		// Both record supply_next_time of traders, cached assorts are served until then
 		json GetTraders();
 		json GetTrader(const std::string& trader_id);
-		std::string GetTraderIdByName(const std::string& name);
+		std::string GetTraderIdByName(const std::string& name, const std::string& language = "en");
 		json GetTraderItemsRaw(const std::string& trader_id);
 		json GetTraderPricesRaw(const std::string& trader_id);
 		json SellItem(const std::string& trader_id, const std::string& item_id, int64_t quantity);
 		json TradeItem(const std::string& trader_id, const std::string& item_id, int64_t quantity, const std::vector <quicktype::TraderBarterItem>& barter_items);
 		std::vector <quicktype::TraderItem> GetTraderItems(const std::string& trader_id);
+		std::vector <quicktype::TraderItem> AssembleTraderItems(const std::string& trader_id, const json& items, const json& prices);
+		// Offers of every trader in GetTraders; assorts of up to TRADER_SWEEP_CONCURRENCY traders are requested at once and decoded by as many workers
+		// Cached assorts are reused, traders whose assort can't be loaded are logged and left out; such a catalog is not kept
+		// Catalog is kept until one of its traders resupplies or an assort changes
+		std::shared_ptr <const TraderCatalog> GetAllTraderItems();
 
 		json SearchMarket(const quicktype::MarketFilterBody& filter);
 		json BuyItem(const std::string& offer_id, int64_t quantity, const std::vector <quicktype::TraderBarterItem>& barter_items);
@@ -77,6 +159,7 @@ namespace TarkovAPI
 
 		json StackItem(const std::string& from_item_id, const std::string& to_item_id, int64_t count = 0);
 		json MoveItem(const std::string& item_id, const quicktype::ItemMoveTo& destination);
+		ActionBatchResult ExecuteActions(const ActionBatch& batch);
 
 		json GetMailList();
 		json GetMail(const std::string& mail_id, int64_t type);
@@ -84,26 +167,116 @@ namespace TarkovAPI
 		json GetMailReward(const std::string& from_item_id, const std::string& to_item_id, const std::string& previous_owner_id, const quicktype::MailRewardToLocation& to_stash_location);
 
 		double GetItemPrice(double listed_price, int64_t amount);
-		json GetItems();
-		json GetItemPrices();
-		json GetLocations();
+		JsonSnapshot GetItems();
+		JsonSnapshot GetItemPrices();
+		JsonSnapshot GetLocations();
 		json GetMyItems();
+		// Profile is downloaded once, then kept current with changes in items/moving responses, see Inventory.hpp
+		// Reload picks up changes made elsewhere, e.g. by game client
+		std::shared_ptr <const Inventory> GetMyInventory();
+		std::shared_ptr <const Inventory> ReloadInventory();
 		uint64_t GetRoubleCount();
 		std::vector <quicktype::TraderBarterItem> FindItemStack(const std::string& schema_id, uint64_t required = 1);
 		std::string GetMainStashID();
-		quicktype::ItemMoveLocation FindBlankStashPos();
-		std::string GetItemName(const std::string& schema_id);
+		// Free top-left cell of main stash, r is 1 when item has to be turned; throws Error::NoStashSpace
+		quicktype::ItemMoveLocation FindBlankStashPos(int32_t item_width = 1, int32_t item_height = 1);
+		quicktype::ItemMoveLocation FindBlankStashPos(const std::string& schema_id); // base size of template
+		// Free cell anywhere under root item (stash, equipment, a backpack), nested containers are searched too; throws Error::NoStashSpace
+		quicktype::ItemMoveTo FindBlankSlot(const std::string& root_id, int32_t item_width, int32_t item_height);
+		quicktype::ItemMoveTo FindBlankSlot(const std::string& root_id, const std::string& schema_id); // base size of template, grid filters apply
+		// Size of an assembled item in inventory as placed unrotated, attached mods and folding included
+		std::pair <int32_t, int32_t> GetItemSize(const std::string& item_id);
+		// Fewest moves inside main stash which free an area for item, no moves when it fits already; throws Error::NoStashSpace
+		// Moves don't depend on each other, all of them can go in a single items/moving request, see ActionBatch::Move
+		StashDefragPlan PlanStashDefrag(int32_t item_width, int32_t item_height, size_t max_moves = DEFRAG_MAX_MOVES);
+		std::string GetItemName(const std::string& schema_id, const std::string& language = "en");
+		std::string GetItemShortName(const std::string& schema_id, const std::string& language = "en");
+		std::string GetItemDescription(const std::string& schema_id, const std::string& language = "en");
+
+		std::future <json> GetProfilesAsync();
+		std::future <json> GetFriendsAsync();
+		std::future <json> GetWeatherAsync();
+		std::future <json> GetTradersAsync();
+		std::future <json> GetTraderAsync(const std::string& trader_id);
+		std::future <json> GetTraderItemsRawAsync(const std::string& trader_id, RequestPriority priority = RequestPriority::Interactive);
+		std::future <json> GetTraderPricesRawAsync(const std::string& trader_id, RequestPriority priority = RequestPriority::Interactive);
+		std::future <json> SearchMarketAsync(const quicktype::MarketFilterBody& filter);
+		std::future <json> GetItemPriceAsync(const std::string& schema_id);
+		std::future <json> GetMailListAsync();
+		std::future <json> GetMailAsync(const std::string& mail_id, int64_t type);
+		std::future <json> GetMailAttachmentsAsync(const std::string& mail_id);
+
+	protected:
+		std::string GetSessionID() const; // copy, maintenance jobs build headers while a login replaces it
+		cpr::Header BuildRequestHeaders();
+		quicktype::ResponseBody HandleRawResponse(const json& deserialized);
+		quicktype::ResponseBody Post_JsonUnscheduled(const std::string& url, const std::string& body);
+
+		// Every use of a pooled client goes through here or Post_Json, scheduler's in flight slot keeps other threads off its host
+		template <typename F>
+		auto RunScheduled(RequestPriority priority, const std::string& url, F&& request) -> decltype(request())
+		{
+			if (!m_pkScheduler)
+			{
+				return request();
+			}
+			return m_pkScheduler->Run(priority, url, std::forward<F>(request));
+		}
+		quicktype::ResponseBody PostItemsMoving(const std::string& url, const std::string& body); // applies inventory changes of response
+
+		json FetchStaticData(const std::string& func, const std::string& url, const std::string& cache_key);
+		json FetchItemPrices();
+		json FetchMyInventory();
+		void RefreshItemPrices();
+		void RefreshTraderAssorts();
+		void ExpireCaches();
+		void InvalidateTraderAssort(const std::string& trader_id); // all traders when empty
+		void RecordTraderResupply(const json& traders); // a trader or list of them
+		virtual int64_t GetUnixTime() const; // clock resupply times are compared with
+		// m_pkCacheMutex must be held for these
+		bool IsTraderAssortStale(const std::string& trader_id, int64_t now) const; // resupply assort was fetched for passed; false when it had no time
+		bool IsTraderResupplyKnown(const std::string& trader_id, int64_t now) const; // recorded time is still ahead
+		void StoreTraderAssort(const std::string& trader_id, JsonSnapshot items, JsonSnapshot prices);
+		void InvalidateInventory();
+		void ApplyInventoryChanges(const json& data);
+		std::shared_ptr <ContainerIndex> GetContainerIndex();
+		quicktype::ItemMoveTo FindBlankSlot(const ObjectId& root_id, int32_t item_width, int32_t item_height, const ObjectId& schema_id, bool nested);
+		ItemLocale FindItemLocale(const std::shared_ptr <const LocaleIndex>& index, const std::string& schema_id);
 
 	private:
-		cpr::Session* m_pkClient;
+		HttpClientPool* m_pkClientPool;
+		AsyncHttpClient* m_pkAsyncClient;
+		RequestScheduler* m_pkScheduler;
 		std::string m_stHwid;
-		std::string m_stSessionID;
+		mutable std::mutex m_pkSessionMutex;
+		std::string m_stSessionID; // guarded by m_pkSessionMutex
+		std::string m_stTracePath;
+		std::chrono::seconds m_nVersionCacheTTL{ VERSION_CACHE_TTL_SECONDS };
+		std::string m_stDataCacheDirectory{ GameDataCache::GetDefaultDirectory() };
+		GameDataCache* m_pkDataCache;
+
+		TimerService* m_pkTimerService;
+		MaintenanceConfig m_kMaintenanceConfig;
+		std::vector <TimerJobId> m_vMaintenanceJobs;
 
-		std::map <std::string /* locale_id */, json /* dump */> m_pkJsonLocale;
-		json m_pkJsonItems;
-		json m_pkJsonItemPrices;
-		json m_pkJsonLocations;
+		// Caches are shared with maintenance jobs; snapshots are swapped with std::atomic_load/atomic_store, maps need m_pkCacheMutex
+		mutable std::mutex m_pkCacheMutex;
+		std::map <std::string /* locale_id */, JsonSnapshot /* dump */> m_pkJsonLocale;
+		std::map <std::string /* locale_id */, std::shared_ptr <const LocaleIndex>> m_pkLocaleIndexes; // dropped with its locale
+		JsonSnapshot m_pkJsonItems;
+		JsonSnapshot m_pkJsonItemPrices;
+		JsonSnapshot m_pkJsonLocations;
+		std::map <std::string /* trader_id */, std::pair <JsonSnapshot /* items */, JsonSnapshot /* prices */>> m_pkTraderAssorts;
+		std::map <std::string /* trader_id */, int64_t /* supply_next_time */> m_pkTraderResupply;
+		std::map <std::string /* trader_id */, int64_t /* resupply it was fetched for */> m_pkTraderAssortExpiry; // such assorts don't expire by cache_ttl
+		std::shared_ptr <const TraderCatalog> m_pkTraderCatalog; // dropped when an assort changes
+		uint64_t m_nTraderAssortGeneration{ 0 }; // bumped by every assort change
+		std::map <std::string /* cache key */, std::chrono::steady_clock::time_point> m_pkCacheTimes;
+		std::shared_ptr <const Inventory> m_pkInventory;
+		uint64_t m_nInventoryGeneration{ 0 }; // bumped by every items/moving response
+		std::shared_ptr <ContainerIndex> m_pkContainerIndex; // follows m_pkInventory, dropped with it
+		std::string m_stSelectedProfileID;
 
-		int64_t m_nReqCounter{ 1 };
+		std::atomic <int64_t> m_nReqCounter{ 1 };
 	};
 };
@@ -0,0 +1,216 @@
+#include "TimerService.hpp"
+#include "Metrics.hpp"
+#include "Trace.hpp"
+#include <algorithm>
+#include <exception>
+
+namespace TarkovAPI
+{
+    TimerService::TimerService() :
+        m_vSlots(TIMER_WHEEL_SLOTS)
+    {
+        m_kThread = std::thread(&TimerService::Run, this);
+    }
+
+    TimerService::~TimerService()
+    {
+        Stop();
+    }
+
+    void TimerService::Insert(const std::shared_ptr <Job>& job, std::chrono::milliseconds delay)
+    {
+        auto ticks = std::max<int64_t>(1, (delay.count() + TIMER_TICK.count() - 1) / TIMER_TICK.count());
+
+        job->slot = (m_nCursor + static_cast<size_t>(ticks)) % TIMER_WHEEL_SLOTS;
+        job->rounds = static_cast<size_t>(ticks - 1) / TIMER_WHEEL_SLOTS;
+        m_vSlots[job->slot].emplace_back(job);
+    }
+
+    TimerJobId TimerService::Schedule(const std::string& name, std::chrono::milliseconds interval, TimerJob job, std::chrono::milliseconds first_delay)
+    {
+        auto entry = std::make_shared<Job>();
+        entry->stats.name = name;
+        entry->stats.interval = std::max(interval, std::chrono::milliseconds(TIMER_TICK));
+        entry->fn = std::move(job);
+
+        std::lock_guard <std::mutex> lock(m_pkMutex);
+
+        entry->stats.id = m_nNextId++;
+        m_pkJobs.emplace(entry->stats.id, entry);
+
+        Insert(entry, (first_delay.count() < 0) ? entry->stats.interval : first_delay);
+        return entry->stats.id;
+    }
+
+    bool TimerService::Cancel(TimerJobId id)
+    {
+        std::unique_lock <std::mutex> lock(m_pkMutex);
+
+        auto it = m_pkJobs.find(id);
+        if (it == m_pkJobs.end())
+        {
+            return false;
+        }
+
+        auto job = it->second;
+        job->cancelled = true;
+        m_pkJobs.erase(it);
+
+        auto& slot = m_vSlots[job->slot];
+        slot.remove(job);
+
+        if (std::this_thread::get_id() != m_kThread.get_id())
+        {
+            m_kJobDoneCondition.wait(lock, [this, id] { return m_nRunningId != id; });
+        }
+        return true;
+    }
+
+    void TimerService::CancelAll()
+    {
+        auto ids = std::vector <TimerJobId>();
+        {
+            std::lock_guard <std::mutex> lock(m_pkMutex);
+            for (const auto& [id, job] : m_pkJobs)
+            {
+                ids.emplace_back(id);
+            }
+        }
+
+        for (auto id : ids)
+        {
+            Cancel(id);
+        }
+    }
+
+    void TimerService::Stop()
+    {
+        CancelAll();
+
+        {
+            std::lock_guard <std::mutex> lock(m_pkMutex);
+            m_bRunning = false;
+        }
+        m_kCondition.notify_all();
+
+        if (m_kThread.joinable())
+        {
+            m_kThread.join();
+        }
+    }
+
+    std::vector <TimerJobStats> TimerService::GetJobStats() const
+    {
+        std::lock_guard <std::mutex> lock(m_pkMutex);
+
+        auto stats = std::vector <TimerJobStats>();
+        stats.reserve(m_pkJobs.size());
+        for (const auto& [id, job] : m_pkJobs)
+        {
+            stats.emplace_back(job->stats);
+        }
+        return stats;
+    }
+
+    size_t TimerService::GetJobCount() const
+    {
+        std::lock_guard <std::mutex> lock(m_pkMutex);
+        return m_pkJobs.size();
+    }
+
+    void TimerService::Execute(const std::shared_ptr <Job>& job)
+    {
+        TRACE_SCOPE_DETAIL("TimerJob", job->stats.name);
+
+        auto duration_us = uint64_t(0);
+        auto error = std::string();
+        auto failed = false;
+        {
+            ScopedTimer timer(duration_us);
+            try
+            {
+                job->fn();
+            }
+            catch (const std::exception& ex)
+            {
+                failed = true;
+                error = ex.what();
+            }
+            catch (...)
+            {
+                failed = true;
+                error = "unknown exception";
+            }
+        }
+
+        MetricsRegistry::Instance().RecordJob(job->stats.name, duration_us, !failed);
+
+        std::lock_guard <std::mutex> lock(m_pkMutex);
+
+        job->stats.runs++;
+        job->stats.last_duration_us = duration_us;
+        job->stats.total_duration_us += duration_us;
+        if (failed)
+        {
+            job->stats.failures++;
+            job->stats.last_error = error;
+        }
+    }
+
+    void TimerService::Run()
+    {
+        auto next_tick = std::chrono::steady_clock::now() + TIMER_TICK;
+
+        std::unique_lock <std::mutex> lock(m_pkMutex);
+        while (m_bRunning)
+        {
+            if (m_kCondition.wait_until(lock, next_tick, [this] { return !m_bRunning; }))
+            {
+                break;
+            }
+
+            // Late ticks are caught up, so a slow job delays others but never loses them
+            while (next_tick <= std::chrono::steady_clock::now() && m_bRunning)
+            {
+                next_tick += TIMER_TICK;
+                m_nCursor = (m_nCursor + 1) % TIMER_WHEEL_SLOTS;
+
+                auto due = std::vector <std::shared_ptr <Job>>();
+                auto& slot = m_vSlots[m_nCursor];
+                for (auto it = slot.begin(); it != slot.end();)
+                {
+                    if ((*it)->rounds)
+                    {
+                        (*it)->rounds--;
+                        ++it;
+                        continue;
+                    }
+                    due.emplace_back(*it);
+                    it = slot.erase(it);
+                }
+
+                for (const auto& job : due)
+                {
+                    if (job->cancelled || !m_bRunning)
+                    {
+                        continue;
+                    }
+
+                    m_nRunningId = job->stats.id;
+                    lock.unlock();
+
+                    Execute(job);
+
+                    lock.lock();
+                    m_nRunningId = 0;
+                    m_kJobDoneCondition.notify_all();
+
+                    if (!job->cancelled)
+                    {
+                        Insert(job, job->stats.interval);
+                    }
+                }
+            }
+        }
+    }
+};
@@ -0,0 +1,86 @@
+#pragma once
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <list>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <atomic>
+#include <thread>
+#include <chrono>
+#include <functional>
+#include <condition_variable>
+
+namespace TarkovAPI
+{
+	using TimerJobId = uint64_t;
+	using TimerJob = std::function <void()>;
+
+	static constexpr auto TIMER_TICK = std::chrono::milliseconds(100);
+	static constexpr size_t TIMER_WHEEL_SLOTS = 512; // one revolution is ~51 seconds, longer intervals wait extra rounds
+
+	struct TimerJobStats
+	{
+		TimerJobId id{ 0 };
+		std::string name;
+		std::chrono::milliseconds interval{ 0 };
+		uint64_t runs{ 0 };
+		uint64_t failures{ 0 };
+		uint64_t last_duration_us{ 0 };
+		uint64_t total_duration_us{ 0 };
+		std::string last_error;
+	};
+
+	// Hashed timer wheel driven by one service thread
+	// Jobs run on service thread one after another, a job that throws is counted as failed and stays scheduled
+	class TimerService
+	{
+	public:
+		TimerService();
+		virtual ~TimerService();
+
+		TimerService(const TimerService&) = delete;
+		TimerService& operator=(const TimerService&) = delete;
+
+		// Periodic job, first run after first_delay (interval when negative)
+		TimerJobId Schedule(const std::string& name, std::chrono::milliseconds interval, TimerJob job, std::chrono::milliseconds first_delay = std::chrono::milliseconds(-1));
+
+		// Returns false when id is unknown; waits for a running invocation unless called from a job
+		bool Cancel(TimerJobId id);
+		void CancelAll();
+
+		void Stop(); // cancels everything and joins service thread
+
+		std::vector <TimerJobStats> GetJobStats() const;
+		size_t GetJobCount() const;
+
+	protected:
+		struct Job
+		{
+			TimerJobStats stats;
+			TimerJob fn;
+			size_t rounds{ 0 };
+			size_t slot{ 0 };
+			bool cancelled{ false };
+		};
+
+		void Insert(const std::shared_ptr <Job>& job, std::chrono::milliseconds delay); // m_pkMutex must be held
+		void Run();
+		void Execute(const std::shared_ptr <Job>& job);
+
+	private:
+		mutable std::mutex m_pkMutex;
+		std::condition_variable m_kCondition;
+		std::condition_variable m_kJobDoneCondition;
+
+		std::vector <std::list <std::shared_ptr <Job>>> m_vSlots;
+		std::map <TimerJobId, std::shared_ptr <Job>> m_pkJobs;
+		size_t m_nCursor{ 0 };
+		TimerJobId m_nNextId{ 1 };
+		TimerJobId m_nRunningId{ 0 };
+		bool m_bRunning{ true };
+
+		std::thread m_kThread;
+	};
+};
@@ -0,0 +1,167 @@
+#include "Trace.hpp"
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+
+#include <json.hpp>
+
+namespace TarkovAPI
+{
+    namespace
+    {
+        const auto gs_kTraceEpoch = std::chrono::steady_clock::now();
+
+        thread_local void* tls_pkTraceBuffer = nullptr;
+    }
+
+    std::atomic <bool> TraceCollector::ms_bEnabled{ false };
+
+    TraceCollector& TraceCollector::Instance()
+    {
+        static TraceCollector instance;
+        return instance;
+    }
+
+    TraceCollector::~TraceCollector()
+    {
+        for (auto& buffer : m_vBuffers)
+        {
+            auto chunk = buffer->head;
+            while (chunk)
+            {
+                auto next = chunk->next.load(std::memory_order_acquire);
+                delete chunk;
+                chunk = next;
+            }
+        }
+    }
+
+    void TraceCollector::Enable()
+    {
+        ms_bEnabled.store(true, std::memory_order_relaxed);
+    }
+
+    void TraceCollector::Disable()
+    {
+        ms_bEnabled.store(false, std::memory_order_relaxed);
+    }
+
+    uint64_t TraceCollector::Now()
+    {
+        return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - gs_kTraceEpoch).count());
+    }
+
+    TraceCollector::ThreadBuffer* TraceCollector::GetThreadBuffer()
+    {
+        if (tls_pkTraceBuffer)
+        {
+            return static_cast<ThreadBuffer*>(tls_pkTraceBuffer);
+        }
+
+        // Buffers outlive their threads, exporter still needs events of finished threads
+        std::lock_guard <std::mutex> lock(m_pkMutex);
+
+        auto buffer = std::make_unique<ThreadBuffer>();
+        buffer->tid = static_cast<uint32_t>(m_vBuffers.size() + 1);
+        buffer->head = buffer->tail = new Chunk();
+
+        tls_pkTraceBuffer = buffer.get();
+        m_vBuffers.emplace_back(std::move(buffer));
+        return static_cast<ThreadBuffer*>(tls_pkTraceBuffer);
+    }
+
+    void TraceCollector::Record(const char* name, uint64_t begin_us, uint64_t duration_us, const char* detail, size_t detail_size)
+    {
+        auto buffer = GetThreadBuffer();
+
+        auto chunk = buffer->tail;
+        auto index = chunk->count.load(std::memory_order_relaxed);
+        if (index == TRACE_CHUNK_EVENTS)
+        {
+            // Full chunk is never touched by writer again once next is linked, exporter may free it from then on
+            auto next = new Chunk();
+            chunk->next.store(next, std::memory_order_release);
+            buffer->tail = chunk = next;
+            index = 0;
+        }
+
+        auto& event = chunk->events[index];
+        event.name = name;
+        event.begin_us = begin_us;
+        event.duration_us = duration_us;
+
+        detail_size = std::min(detail_size, TRACE_DETAIL_SIZE - 1);
+        std::memcpy(event.detail, detail, detail_size);
+        event.detail[detail_size] = '\0';
+
+        chunk->count.store(index + 1, std::memory_order_release);
+    }
+
+    template <typename F>
+    void TraceCollector::Drain(F&& on_event)
+    {
+        std::lock_guard <std::mutex> lock(m_pkMutex);
+
+        for (auto& buffer : m_vBuffers)
+        {
+            while (true)
+            {
+                auto chunk = buffer->head;
+                auto count = chunk->count.load(std::memory_order_acquire);
+                for (; buffer->read < count; ++buffer->read)
+                {
+                    on_event(buffer->tid, chunk->events[buffer->read]);
+                }
+
+                auto next = chunk->next.load(std::memory_order_acquire);
+                if (!next)
+                {
+                    break;
+                }
+
+                delete chunk;
+                buffer->head = next;
+                buffer->read = 0;
+            }
+        }
+    }
+
+    std::string TraceCollector::ExportJson()
+    {
+        auto events = nlohmann::json::array();
+        Drain([&events](uint32_t tid, const TraceEvent& event) {
+            auto out = nlohmann::json{
+                {"name", event.name},
+                {"cat", "TarkovAPI"},
+                {"ph", "X"},
+                {"ts", event.begin_us},
+                {"dur", event.duration_us},
+                {"pid", 1},
+                {"tid", tid}
+            };
+            if (event.detail[0])
+            {
+                out["args"] = { {"detail", event.detail} };
+            }
+            events.emplace_back(std::move(out));
+        });
+
+        return nlohmann::json{ {"traceEvents", std::move(events)}, {"displayTimeUnit", "ms"} }.dump();
+    }
+
+    bool TraceCollector::WriteJson(const std::string& path)
+    {
+        std::ofstream file(path, std::ios::binary | std::ios::trunc);
+        if (!file)
+        {
+            return false;
+        }
+        file << ExportJson();
+        return static_cast<bool>(file);
+    }
+
+    void TraceCollector::Clear()
+    {
+        Drain([](uint32_t, const TraceEvent&) {});
+    }
+};
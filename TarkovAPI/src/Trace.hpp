@@ -0,0 +1,130 @@
+#pragma once
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <memory>
+#include <mutex>
+#include <atomic>
+#include <chrono>
+
+namespace TarkovAPI
+{
+	static constexpr auto TRACE_ENV = "TARKOVAPI_TRACE";
+
+	static constexpr size_t TRACE_DETAIL_SIZE = 64;
+	static constexpr size_t TRACE_CHUNK_EVENTS = 512;
+
+	// One complete ("ph":"X") event, name must have static storage duration
+	struct TraceEvent
+	{
+		const char* name;
+		uint64_t begin_us;
+		uint64_t duration_us;
+		char detail[TRACE_DETAIL_SIZE]; // shown as args.detail, truncated
+	};
+
+	// Collects spans into per thread buffers and exports them as Chrome trace event JSON (chrome://tracing, ui.perfetto.dev)
+	// Recording thread only appends to its own buffer without locks; exporter drains buffers and frees consumed chunks
+	class TraceCollector
+	{
+	public:
+		static TraceCollector& Instance();
+
+		TraceCollector(const TraceCollector&) = delete;
+		TraceCollector& operator=(const TraceCollector&) = delete;
+
+		static bool IsEnabled()
+		{
+			return ms_bEnabled.load(std::memory_order_relaxed);
+		}
+		void Enable();
+		void Disable();
+
+		static uint64_t Now(); // microseconds since collector was created
+
+		void Record(const char* name, uint64_t begin_us, uint64_t duration_us, const char* detail, size_t detail_size);
+
+		// Export removes exported events from buffers
+		std::string ExportJson();
+		bool WriteJson(const std::string& path);
+		void Clear();
+
+	protected:
+		TraceCollector() = default;
+		~TraceCollector();
+
+		struct Chunk
+		{
+			TraceEvent events[TRACE_CHUNK_EVENTS];
+			std::atomic <size_t> count{ 0 }; // published by writer
+			std::atomic <Chunk*> next{ nullptr };
+		};
+
+		struct ThreadBuffer
+		{
+			uint32_t tid{ 0 };
+			Chunk* head{ nullptr }; // exporter side
+			size_t read{ 0 }; // exporter cursor in head
+			Chunk* tail{ nullptr }; // writer side
+		};
+
+		ThreadBuffer* GetThreadBuffer();
+
+		template <typename F>
+		void Drain(F&& on_event);
+
+	private:
+		static std::atomic <bool> ms_bEnabled;
+
+		std::mutex m_pkMutex; // guards buffer list and exporter cursors, never taken on record path after first span of a thread
+		std::vector <std::unique_ptr <ThreadBuffer>> m_vBuffers;
+	};
+
+	class TraceSpan
+	{
+	public:
+		explicit TraceSpan(const char* name) :
+			m_szName(TraceCollector::IsEnabled() ? name : nullptr)
+		{
+			if (m_szName)
+			{
+				m_nBegin = TraceCollector::Now();
+			}
+		}
+		TraceSpan(const char* name, const std::string& detail) :
+			TraceSpan(name)
+		{
+			if (m_szName)
+			{
+				m_stDetail = detail;
+			}
+		}
+		~TraceSpan()
+		{
+			if (m_szName)
+			{
+				TraceCollector::Instance().Record(m_szName, m_nBegin, TraceCollector::Now() - m_nBegin, m_stDetail.data(), m_stDetail.size());
+			}
+		}
+
+		TraceSpan(const TraceSpan&) = delete;
+		TraceSpan& operator=(const TraceSpan&) = delete;
+
+	private:
+		const char* m_szName;
+		uint64_t m_nBegin{ 0 };
+		std::string m_stDetail;
+	};
+};
+
+#define TARKOVAPI_TRACE_CONCAT_IMPL(a, b) a##b
+#define TARKOVAPI_TRACE_CONCAT(a, b) TARKOVAPI_TRACE_CONCAT_IMPL(a, b)
+
+#ifdef TARKOVAPI_DISABLE_TRACING
+#define TRACE_SCOPE(name) (void)0
+#define TRACE_SCOPE_DETAIL(name, detail) (void)0
+#else
+#define TRACE_SCOPE(name) TarkovAPI::TraceSpan TARKOVAPI_TRACE_CONCAT(trace_span_, __LINE__)(name)
+#define TRACE_SCOPE_DETAIL(name, detail) TarkovAPI::TraceSpan TARKOVAPI_TRACE_CONCAT(trace_span_, __LINE__)(name, TarkovAPI::TraceCollector::IsEnabled() ? (detail) : std::string())
+#endif
+#define TRACE_FUNCTION() TRACE_SCOPE(__FUNCTION__)
@@ -0,0 +1,131 @@
+#include "TraderCatalog.hpp"
+
+#include <algorithm>
+#include <numeric>
+
+namespace TarkovAPI
+{
+    TraderCatalog::TraderCatalog(std::vector <std::pair <std::string, std::vector <quicktype::TraderItem>>>&& assorts)
+    {
+        auto count = size_t(0);
+        for (const auto& assort : assorts)
+        {
+            count += assort.second.size();
+        }
+        m_vOffers.reserve(count);
+        m_vTraders.reserve(count);
+
+        for (auto& [trader_id, items] : assorts)
+        {
+            // Same trader twice keeps offers of both
+            auto trader = static_cast<uint32_t>(std::find(m_vTraderIds.begin(), m_vTraderIds.end(), trader_id) - m_vTraderIds.begin());
+            if (trader == m_vTraderIds.size())
+            {
+                m_vTraderIds.emplace_back(trader_id);
+            }
+
+            for (auto& item : items)
+            {
+                m_vOffers.emplace_back(std::move(item));
+                m_vTraders.emplace_back(trader);
+            }
+        }
+
+        BuildIndexes();
+    }
+
+    void TraderCatalog::BuildIndexes()
+    {
+        const auto count = static_cast<uint32_t>(m_vOffers.size());
+
+        // Stable sorts keep assort order inside a key
+        m_vByTrader.resize(count);
+        std::iota(m_vByTrader.begin(), m_vByTrader.end(), 0);
+        std::stable_sort(m_vByTrader.begin(), m_vByTrader.end(), [this](uint32_t lhs, uint32_t rhs) {
+            if (m_vTraders[lhs] != m_vTraders[rhs])
+            {
+                return m_vTraders[lhs] < m_vTraders[rhs];
+            }
+            return m_vOffers[lhs].loyalty_level < m_vOffers[rhs].loyalty_level;
+        });
+
+        m_vByTemplate.resize(count);
+        std::iota(m_vByTemplate.begin(), m_vByTemplate.end(), 0);
+        std::stable_sort(m_vByTemplate.begin(), m_vByTemplate.end(), [this](uint32_t lhs, uint32_t rhs) {
+            return m_vOffers[lhs]._tpl < m_vOffers[rhs]._tpl;
+        });
+
+        m_pkTraderRanges.clear();
+        m_pkTemplateRanges.clear();
+
+        uint32_t begin = 0;
+        for (uint32_t i = 1; i <= count; ++i)
+        {
+            if (i == count || m_vTraders[m_vByTrader[i]] != m_vTraders[m_vByTrader[begin]])
+            {
+                m_pkTraderRanges.emplace(m_vTraderIds[m_vTraders[m_vByTrader[begin]]], std::make_pair(begin, i));
+                begin = i;
+            }
+        }
+
+        begin = 0;
+        for (uint32_t i = 1; i <= count; ++i)
+        {
+            if (i == count || m_vOffers[m_vByTemplate[i]]._tpl != m_vOffers[m_vByTemplate[begin]]._tpl)
+            {
+                m_pkTemplateRanges.emplace(m_vOffers[m_vByTemplate[begin]]._tpl, std::make_pair(begin, i));
+                begin = i;
+            }
+        }
+    }
+
+    size_t TraderCatalog::GetCount() const
+    {
+        return m_vOffers.size();
+    }
+
+    size_t TraderCatalog::GetTraderCount() const
+    {
+        return m_vTraderIds.size();
+    }
+
+    const std::vector <std::string>& TraderCatalog::GetTraderIds() const
+    {
+        return m_vTraderIds;
+    }
+
+    const quicktype::TraderItem& TraderCatalog::GetOffer(uint32_t index) const
+    {
+        return m_vOffers[index];
+    }
+
+    const std::string& TraderCatalog::GetTraderId(uint32_t index) const
+    {
+        return m_vTraderIds[m_vTraders[index]];
+    }
+
+    ItemRange TraderCatalog::FindByTrader(const std::string& trader_id, int64_t max_loyalty_level) const
+    {
+        auto it = m_pkTraderRanges.find(trader_id);
+        if (it == m_pkTraderRanges.end())
+        {
+            return ItemRange();
+        }
+
+        auto first = m_vByTrader.data() + it->second.first;
+        auto last = std::upper_bound(first, m_vByTrader.data() + it->second.second, max_loyalty_level, [this](int64_t value, uint32_t i) {
+            return value < m_vOffers[i].loyalty_level;
+        });
+        return ItemRange(first, last);
+    }
+
+    ItemRange TraderCatalog::FindByTemplate(const ObjectId& schema_id) const
+    {
+        auto it = m_pkTemplateRanges.find(schema_id);
+        if (it == m_pkTemplateRanges.end())
+        {
+            return ItemRange();
+        }
+        return ItemRange(m_vByTemplate.data() + it->second.first, m_vByTemplate.data() + it->second.second);
+    }
+};
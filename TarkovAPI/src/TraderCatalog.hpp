@@ -0,0 +1,48 @@
+#pragma once
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <limits>
+#include <utility>
+#include <unordered_map>
+
+#include "Constants.hpp"
+#include "ObjectId.hpp"
+#include "Inventory.hpp"
+
+namespace TarkovAPI
+{
+	// Offers of many traders merged into one table, see TarkovAPIManager::GetAllTraderItems
+	// Offers are stored in trader order, with lookups by template and by trader sorted by loyalty level
+	// Positions returned by lookups index GetOffer, ranges stay valid as long as catalog is alive
+	class TraderCatalog
+	{
+	public:
+		TraderCatalog() = default;
+		explicit TraderCatalog(std::vector <std::pair <std::string /* trader_id */, std::vector <quicktype::TraderItem>>>&& assorts);
+
+		size_t GetCount() const;
+		size_t GetTraderCount() const;
+		const std::vector <std::string>& GetTraderIds() const; // in order of assorts given
+		const quicktype::TraderItem& GetOffer(uint32_t index) const;
+		const std::string& GetTraderId(uint32_t index) const; // trader selling offer
+
+		// Offers unlocked up to max_loyalty_level, lowest level first and in assort order inside a level
+		ItemRange FindByTrader(const std::string& trader_id, int64_t max_loyalty_level = std::numeric_limits<int64_t>::max()) const;
+		ItemRange FindByTemplate(const ObjectId& schema_id) const; // every trader, in trader order
+
+	protected:
+		void BuildIndexes();
+
+	private:
+		std::vector <std::string> m_vTraderIds;
+		std::vector <quicktype::TraderItem> m_vOffers;
+		std::vector <uint32_t> m_vTraders; // position in m_vTraderIds of each offer
+
+		// Positions sorted by key, maps point to [begin, end) of a key
+		std::vector <uint32_t> m_vByTrader;
+		std::vector <uint32_t> m_vByTemplate;
+		std::unordered_map <std::string /* trader_id */, std::pair <uint32_t, uint32_t>> m_pkTraderRanges;
+		std::unordered_map <ObjectId /* _tpl */, std::pair <uint32_t, uint32_t>> m_pkTemplateRanges;
+	};
+};
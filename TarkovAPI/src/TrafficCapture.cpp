@@ -0,0 +1,298 @@
+#include "TrafficCapture.hpp"
+#include "Constants.hpp"
+#include "Exception.hpp"
+#include <chrono>
+#include <cstring>
+#include <algorithm>
+#include <cctype>
+
+#include <zlib.h>
+#include <json.hpp>
+
+namespace TarkovAPI
+{
+    namespace
+    {
+        static constexpr char CAPTURE_FILE_MAGIC[8] = { 'T', 'K', 'V', 'C', 'A', 'P', '0', '1' };
+        static constexpr uint32_t CAPTURE_RECORD_MAGIC = 0x52564B54; // "TKVR"
+
+        struct RecordHeader
+        {
+            uint32_t magic;
+            int32_t status;
+            uint64_t timestamp_us;
+            uint32_t url_size;
+            uint32_t body_size;
+            uint32_t headers_size;
+            uint32_t response_size;
+        };
+        static_assert(sizeof(RecordHeader) == 32, "RecordHeader must not be padded");
+
+        struct IndexEntry
+        {
+            uint64_t offset;
+            uint32_t size;
+            uint32_t key_crc;
+        };
+        static_assert(sizeof(IndexEntry) == 16, "IndexEntry must not be padded");
+
+        static const char* SECRET_HEADERS[] = { "Cookie", "Authorization" };
+        static const char* SECRET_BODY_FIELDS[] = { "email", "pass", "hwCode", "activateCode", "captcha" };
+
+        bool ReadRecord(std::ifstream& file, CaptureRecord& record)
+        {
+            RecordHeader header{};
+            if (!file.read(reinterpret_cast<char*>(&header), sizeof(header)) || header.magic != CAPTURE_RECORD_MAGIC)
+            {
+                return false;
+            }
+
+            record.timestamp_us = header.timestamp_us;
+            record.status = header.status;
+
+            auto read_field = [&file](std::string& out, uint32_t size) {
+                out.resize(size);
+                return size == 0 || static_cast<bool>(file.read(&out[0], size));
+            };
+            return read_field(record.url, header.url_size) &&
+                read_field(record.body, header.body_size) &&
+                read_field(record.headers, header.headers_size) &&
+                read_field(record.response, header.response_size);
+        }
+    }
+
+    TrafficCapture::TrafficCapture(const std::string& path)
+    {
+        m_kDataFile.open(path, std::ios::binary | std::ios::app);
+        m_kIndexFile.open(path + ".idx", std::ios::binary | std::ios::app);
+        if (!m_kDataFile || !m_kIndexFile)
+        {
+            throw TarkovAPIException(Error::CaptureFailed, path);
+        }
+
+        m_kDataFile.seekp(0, std::ios::end);
+        m_nOffset = static_cast<uint64_t>(m_kDataFile.tellp());
+        if (!m_nOffset)
+        {
+            m_kDataFile.write(CAPTURE_FILE_MAGIC, sizeof(CAPTURE_FILE_MAGIC));
+            m_kDataFile.flush();
+            m_nOffset = sizeof(CAPTURE_FILE_MAGIC);
+        }
+    }
+
+    void TrafficCapture::Append(const std::string& url, const std::string& body, const cpr::Header& headers, int32_t status, const std::string& response)
+    {
+        auto redacted_body = RedactBody(body);
+        auto serialized_headers = SerializeHeaders(headers);
+
+        RecordHeader header{};
+        header.magic = CAPTURE_RECORD_MAGIC;
+        header.status = status;
+        header.timestamp_us = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::system_clock::now().time_since_epoch()).count());
+        header.url_size = static_cast<uint32_t>(url.size());
+        header.body_size = static_cast<uint32_t>(redacted_body.size());
+        header.headers_size = static_cast<uint32_t>(serialized_headers.size());
+        header.response_size = static_cast<uint32_t>(response.size());
+
+        auto key = GetRequestKey(url);
+
+        IndexEntry entry{};
+        entry.size = static_cast<uint32_t>(sizeof(header) + url.size() + redacted_body.size() + serialized_headers.size() + response.size());
+        entry.key_crc = static_cast<uint32_t>(crc32(0L, reinterpret_cast<const Bytef*>(key.data()), static_cast<uInt>(key.size())));
+
+        std::lock_guard <std::mutex> lock(m_pkMutex);
+
+        entry.offset = m_nOffset;
+
+        m_kDataFile.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        m_kDataFile.write(url.data(), url.size());
+        m_kDataFile.write(redacted_body.data(), redacted_body.size());
+        m_kDataFile.write(serialized_headers.data(), serialized_headers.size());
+        m_kDataFile.write(response.data(), response.size());
+        m_kDataFile.flush();
+
+        // Index entry is written after its record is on disk, a torn tail can always be recovered by scanning
+        m_kIndexFile.write(reinterpret_cast<const char*>(&entry), sizeof(entry));
+        m_kIndexFile.flush();
+
+        if (!m_kDataFile || !m_kIndexFile)
+        {
+            throw TarkovAPIException(Error::CaptureFailed, url);
+        }
+
+        m_nOffset += entry.size;
+        m_nRecords++;
+    }
+
+    uint64_t TrafficCapture::GetRecordCount() const
+    {
+        std::lock_guard <std::mutex> lock(m_pkMutex);
+        return m_nRecords;
+    }
+
+    std::string TrafficCapture::SerializeHeaders(const cpr::Header& headers)
+    {
+        auto out = std::string();
+        for (const auto& [key, value] : headers)
+        {
+            auto is_secret = std::any_of(std::begin(SECRET_HEADERS), std::end(SECRET_HEADERS), [&key](const std::string& secret) {
+                return key.size() == secret.size() && std::equal(key.begin(), key.end(), secret.begin(), [](char a, char b) {
+                    return std::tolower(static_cast<unsigned char>(a)) == std::tolower(static_cast<unsigned char>(b));
+                });
+            });
+            if (!is_secret)
+            {
+                out += fmt::format("{}: {}\r\n", key, value);
+            }
+        }
+        return out;
+    }
+
+    std::string TrafficCapture::RedactBody(const std::string& body)
+    {
+        if (body.empty() || body.front() != '{')
+        {
+            return body;
+        }
+
+        auto deserialized = nlohmann::json::parse(body, nullptr, false);
+        if (deserialized.is_discarded() || !deserialized.is_object())
+        {
+            return body;
+        }
+
+        auto redacted = false;
+        for (auto field : SECRET_BODY_FIELDS)
+        {
+            if (deserialized.contains(field))
+            {
+                deserialized[field] = "<redacted>";
+                redacted = true;
+            }
+        }
+        return redacted ? deserialized.dump() : body;
+    }
+
+    std::string TrafficCapture::GetRequestKey(const std::string& url)
+    {
+        auto scheme_end = url.find("://");
+        auto host_begin = (scheme_end == std::string::npos) ? 0 : scheme_end + 3;
+
+        auto path_begin = url.find('/', host_begin);
+        return (path_begin == std::string::npos) ? "/" : url.substr(path_begin);
+    }
+
+    std::vector <CaptureRecord> TrafficCapture::ReadRecords(const std::string& path)
+    {
+        std::ifstream data_file(path, std::ios::binary);
+
+        char magic[sizeof(CAPTURE_FILE_MAGIC)]{};
+        if (!data_file.read(magic, sizeof(magic)) || std::memcmp(magic, CAPTURE_FILE_MAGIC, sizeof(magic)))
+        {
+            throw TarkovAPIException(Error::CaptureFailed, fmt::format("{} is not a capture file", path));
+        }
+
+        data_file.seekg(0, std::ios::end);
+        auto data_size = static_cast<uint64_t>(data_file.tellg());
+
+        auto records = std::vector <CaptureRecord>();
+
+        // Index is used when it covers the whole data file
+        std::ifstream index_file(path + ".idx", std::ios::binary);
+        auto entries = std::vector <IndexEntry>();
+        IndexEntry entry{};
+        while (index_file && index_file.read(reinterpret_cast<char*>(&entry), sizeof(entry)))
+        {
+            entries.emplace_back(entry);
+        }
+
+        if (!entries.empty() && entries.back().offset + entries.back().size == data_size)
+        {
+            records.reserve(entries.size());
+            for (const auto& it : entries)
+            {
+                data_file.clear();
+                data_file.seekg(static_cast<std::streamoff>(it.offset));
+
+                auto record = CaptureRecord{};
+                if (!ReadRecord(data_file, record))
+                {
+                    records.clear();
+                    break;
+                }
+                records.emplace_back(std::move(record));
+            }
+
+            if (records.size() == entries.size())
+            {
+                return records;
+            }
+        }
+
+        // Missing or stale index, scan records until end or first torn record
+        data_file.clear();
+        data_file.seekg(sizeof(CAPTURE_FILE_MAGIC));
+
+        auto record = CaptureRecord{};
+        while (ReadRecord(data_file, record))
+        {
+            records.emplace_back(std::move(record));
+            record = CaptureRecord{};
+        }
+        return records;
+    }
+
+
+    TrafficReplay::TrafficReplay(const std::string& path)
+    {
+        m_vRecords = TrafficCapture::ReadRecords(path);
+
+        for (size_t i = 0; i < m_vRecords.size(); ++i)
+        {
+            auto key = TrafficCapture::GetRequestKey(m_vRecords[i].url);
+
+            m_pkExactIndex[key + '\n' + m_vRecords[i].body].emplace_back(i);
+            m_pkPathIndex[key].emplace_back(i);
+        }
+    }
+
+    const CaptureRecord* TrafficReplay::Next(std::map <std::string, std::vector <size_t>>& index, const std::string& key)
+    {
+        auto it = index.find(key);
+        if (it == index.end())
+        {
+            return nullptr;
+        }
+
+        auto& cursor = m_pkCursors[&it->second];
+        auto record = &m_vRecords[it->second[cursor]];
+        if (cursor + 1 < it->second.size())
+        {
+            cursor++;
+        }
+        return record;
+    }
+
+    const CaptureRecord& TrafficReplay::Find(const std::string& url, const std::string& body)
+    {
+        auto key = TrafficCapture::GetRequestKey(url);
+
+        std::lock_guard <std::mutex> lock(m_pkMutex);
+
+        auto record = Next(m_pkExactIndex, key + '\n' + TrafficCapture::RedactBody(body));
+        if (!record)
+        {
+            record = Next(m_pkPathIndex, key);
+        }
+        if (!record)
+        {
+            throw TarkovAPIException(Error::ReplayNotFound, key);
+        }
+        return *record;
+    }
+
+    size_t TrafficReplay::GetRecordCount() const
+    {
+        return m_vRecords.size();
+    }
+};
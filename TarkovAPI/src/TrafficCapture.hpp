@@ -0,0 +1,83 @@
+#pragma once
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <map>
+#include <mutex>
+#include <fstream>
+
+#include <cpr/cprtypes.h>
+
+namespace TarkovAPI
+{
+	static constexpr auto CAPTURE_ENV = "TARKOVAPI_CAPTURE";
+	static constexpr auto REPLAY_ENV = "TARKOVAPI_REPLAY";
+
+	// One captured exchange, response is kept exactly as received (zlib compressed)
+	struct CaptureRecord
+	{
+		uint64_t timestamp_us{ 0 };
+		int32_t status{ 0 };
+		std::string url;
+		std::string body; // secret fields are redacted
+		std::string headers; // "Key: value\r\n" lines, secret headers are dropped
+		std::string response;
+	};
+
+	// Capture file layout
+	//  <path>     : "TKVCAP01" followed by records: RecordHeader + url + body + headers + response
+	//  <path>.idx : fixed size IndexEntry per record, append-only, rebuilt from data file when missing or stale
+	class TrafficCapture
+	{
+	public:
+		explicit TrafficCapture(const std::string& path);
+		virtual ~TrafficCapture() = default;
+
+		TrafficCapture(const TrafficCapture&) = delete;
+		TrafficCapture& operator=(const TrafficCapture&) = delete;
+
+		void Append(const std::string& url, const std::string& body, const cpr::Header& headers, int32_t status, const std::string& response);
+
+		uint64_t GetRecordCount() const;
+
+		static std::string SerializeHeaders(const cpr::Header& headers);
+		static std::string RedactBody(const std::string& body);
+		static std::string GetRequestKey(const std::string& url); // path and query, host is not part of the key
+
+		static std::vector <CaptureRecord> ReadRecords(const std::string& path);
+
+	private:
+		mutable std::mutex m_pkMutex;
+		std::ofstream m_kDataFile;
+		std::ofstream m_kIndexFile;
+		uint64_t m_nOffset{ 0 };
+		uint64_t m_nRecords{ 0 };
+	};
+
+	// Serves captured responses back in recorded order
+	// Requests are matched on path+query and redacted body first, then on path+query only; last match is repeated once exhausted
+	class TrafficReplay
+	{
+	public:
+		explicit TrafficReplay(const std::string& path);
+		virtual ~TrafficReplay() = default;
+
+		TrafficReplay(const TrafficReplay&) = delete;
+		TrafficReplay& operator=(const TrafficReplay&) = delete;
+
+		const CaptureRecord& Find(const std::string& url, const std::string& body);
+
+		size_t GetRecordCount() const;
+
+	protected:
+		const CaptureRecord* Next(std::map <std::string, std::vector <size_t>>& index, const std::string& key);
+
+	private:
+		std::mutex m_pkMutex;
+		std::vector <CaptureRecord> m_vRecords;
+
+		std::map <std::string /* key + body */, std::vector <size_t>> m_pkExactIndex;
+		std::map <std::string /* key */, std::vector <size_t>> m_pkPathIndex;
+		std::map <const std::vector <size_t>*, size_t> m_pkCursors;
+	};
+};
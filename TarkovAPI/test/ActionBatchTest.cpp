@@ -0,0 +1,72 @@
+#include <catch2/catch.hpp>
+#include <json.hpp>
+
+#include "../src/ActionBatch.hpp"
+
+using namespace TarkovAPI;
+using json = nlohmann::json;
+
+TEST_CASE("Action batch serialize", "[multi-file:6]")
+{
+	auto batch = ActionBatch();
+	batch
+		.Move("5e3a0d3c9ba0e8a3c5b0e5a1", quicktype::ItemMoveTo{ "5e3a0d3c9ba0e8a3c5b0e5a0", "hideout", { 1, 2, 0 } })
+		.Merge("5e3a0d3c9ba0e8a3c5b0e5a2", "5e3a0d3c9ba0e8a3c5b0e5a3")
+		.Transfer("5e3a0d3c9ba0e8a3c5b0e5a4", "5e3a0d3c9ba0e8a3c5b0e5a5", 500)
+		.TradingSell("54cb50c76803fa8b248b4571", "5e3a0d3c9ba0e8a3c5b0e5a6", 1);
+
+	REQUIRE(batch.Size() == 4);
+
+	auto body = batch.Serialize();
+	REQUIRE(body["data"].size() == 4);
+	REQUIRE(body["data"][0]["Action"] == "Move");
+	REQUIRE(body["data"][0]["to"]["location"]["y"] == 2);
+	REQUIRE(body["data"][1]["Action"] == "Merge");
+	REQUIRE(body["data"][2]["count"] == 500);
+	REQUIRE(body["data"][3]["type"] == "sell_to_trader");
+}
+
+TEST_CASE("Action batch result mapping", "[multi-file:6]")
+{
+	auto batch = ActionBatch();
+	batch
+		.Merge("5e3a0d3c9ba0e8a3c5b0e5a2", "5e3a0d3c9ba0e8a3c5b0e5a3")
+		.Merge("5e3a0d3c9ba0e8a3c5b0e5a4", "5e3a0d3c9ba0e8a3c5b0e5a5")
+		.Merge("5e3a0d3c9ba0e8a3c5b0e5a6", "5e3a0d3c9ba0e8a3c5b0e5a7");
+
+	auto data = json::parse(R"({
+		"items": { "new": [], "change": [], "del": [ { "_id": "5e3a0d3c9ba0e8a3c5b0e5a2" } ] },
+		"badRequest": [ { "index": 1, "err": 228, "errmsg": "not enough items" } ]
+	})");
+
+	auto result = batch.MapResults(data);
+	REQUIRE(result.results.size() == 3);
+	REQUIRE(!result.AllSucceeded());
+	REQUIRE(result.results[0].succeeded);
+	REQUIRE(!result.results[1].succeeded);
+	REQUIRE(result.results[1].err == ErrorCodes::InvalidBarterItems);
+	REQUIRE(result.results[1].errmsg == "not enough items");
+	REQUIRE(result.results[2].succeeded);
+	REQUIRE(result.items["del"].size() == 1);
+}
+
+TEST_CASE("Action batch trade trader ids", "[multi-file:6]")
+{
+	auto batch = ActionBatch();
+	batch
+		.TradingSell("5935c25fb3acc3127c3d8cd9", "5e3a0d3c9ba0e8a3c5b0e5a2", 1)
+		.Merge("5e3a0d3c9ba0e8a3c5b0e5a4", "5e3a0d3c9ba0e8a3c5b0e5a5")
+		.TradingBuy("54cb50c76803fa8b248b4571", "5e3a0d3c9ba0e8a3c5b0e5a6", 1, {});
+
+	auto data = json::parse(R"({
+		"items": { "new": [], "change": [], "del": [] },
+		"badRequest": [ { "index": 2, "err": "unknown" } ]
+	})");
+
+	auto result = batch.MapResults(data);
+	REQUIRE(result.results[0].trader_id == "5935c25fb3acc3127c3d8cd9");
+	REQUIRE(result.results[1].trader_id.empty());
+	REQUIRE(result.results[2].trader_id == "54cb50c76803fa8b248b4571");
+	REQUIRE(!result.results[2].succeeded);
+	REQUIRE(result.results[2].err == ErrorCodes::BackendError);
+}
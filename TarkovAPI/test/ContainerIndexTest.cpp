@@ -0,0 +1,195 @@
+#include <catch2/catch.hpp>
+#include <json.hpp>
+#include <memory>
+#include <algorithm>
+
+#include "../src/ContainerIndex.hpp"
+
+using namespace TarkovAPI;
+using json = nlohmann::json;
+
+TEST_CASE("Container grids", "[multi-file:17]")
+{
+	// Stash 4x2, backpack with 2x3 and 1x1 grids, case taking only money category
+	auto items = std::make_shared<const json>(json::parse(R"({
+		"566abbc34bdc2d92178b4576": { "_id": "566abbc34bdc2d92178b4576", "_parent": "", "_props": { "Width": 1, "Height": 1, "Grids": [
+			{ "_name": "hideout", "_props": { "cellsH": 4, "cellsV": 2, "filters": [] } }
+		] } },
+		"5448e53e4bdc2d60728b4567": { "_id": "5448e53e4bdc2d60728b4567", "_parent": "", "_props": { "Width": 2, "Height": 1, "Grids": [
+			{ "_name": "main", "_props": { "cellsH": 2, "cellsV": 3, "filters": [] } },
+			{ "_name": "pocket", "_props": { "cellsH": 1, "cellsV": 1, "filters": [] } }
+		] } },
+		"59fb016586f7746d0d4b423a": { "_id": "59fb016586f7746d0d4b423a", "_parent": "", "_props": { "Width": 1, "Height": 1, "Grids": [
+			{ "_name": "main", "_props": { "cellsH": 2, "cellsV": 2, "filters": [ { "Filter": [ "543be5dd4bdc2deb348b4569" ], "ExcludedFilter": [ "5696686a4bdc2da3298b456a" ] } ] } }
+		] } },
+		"543be5dd4bdc2deb348b4569": { "_id": "543be5dd4bdc2deb348b4569", "_parent": "", "_props": {} },
+		"5449016a4bdc2d6f028b456f": { "_id": "5449016a4bdc2d6f028b456f", "_parent": "543be5dd4bdc2deb348b4569", "_props": { "Width": 1, "Height": 1 } },
+		"5696686a4bdc2da3298b456a": { "_id": "5696686a4bdc2da3298b456a", "_parent": "543be5dd4bdc2deb348b4569", "_props": { "Width": 1, "Height": 1 } },
+		"5447a9cd4bdc2dbd208b4567": { "_id": "5447a9cd4bdc2dbd208b4567", "_parent": "", "_props": { "Width": 2, "Height": 1 } }
+	})"));
+
+	// Stash: rifle at (0,0), backpack at (2,0), case at (0,1); backpack main has a rifle on top row
+	auto inventory = std::make_shared<const Inventory>(json::parse(R"({
+		"stash": "5fe49a0e2694b0755a504770",
+		"items": [
+			{ "_id": "5fe49a0e2694b0755a504770", "_tpl": "566abbc34bdc2d92178b4576" },
+			{ "_id": "600000000000000000000001", "_tpl": "5447a9cd4bdc2dbd208b4567", "parentId": "5fe49a0e2694b0755a504770", "slotId": "hideout", "location": { "x": 0, "y": 0, "r": 0 } },
+			{ "_id": "600000000000000000000002", "_tpl": "5448e53e4bdc2d60728b4567", "parentId": "5fe49a0e2694b0755a504770", "slotId": "hideout", "location": { "x": 2, "y": 0, "r": 0 } },
+			{ "_id": "600000000000000000000003", "_tpl": "59fb016586f7746d0d4b423a", "parentId": "5fe49a0e2694b0755a504770", "slotId": "hideout", "location": { "x": 0, "y": 1, "r": 0 } },
+			{ "_id": "600000000000000000000004", "_tpl": "5447a9cd4bdc2dbd208b4567", "parentId": "600000000000000000000002", "slotId": "main", "location": { "x": 0, "y": 0, "r": 0 } }
+		]
+	})"));
+
+	const auto stash_id = ObjectId("5fe49a0e2694b0755a504770");
+	const auto backpack_id = ObjectId("600000000000000000000002");
+	const auto case_id = ObjectId("600000000000000000000003");
+	const auto roubles = ObjectId("5449016a4bdc2d6f028b456f");
+
+	auto index = ContainerIndex(items, inventory);
+	auto placement = GridPlacement();
+
+	SECTION("Top level grid")
+	{
+		REQUIRE(index.FindBlank(stash_id, 1, 1, placement, ObjectId(), false));
+		REQUIRE(placement.container_id == stash_id);
+		REQUIRE(placement.grid == "hideout");
+		REQUIRE(placement.location.x == 1);
+		REQUIRE(placement.location.y == 1);
+		REQUIRE(placement.location.in_grid);
+
+		// Only cells (1,1) to (3,1) are left
+		REQUIRE(index.FindBlank(stash_id, 1, 2, placement, ObjectId(), false));
+		REQUIRE(placement.location.rotated);
+		REQUIRE(index.FindBlank(stash_id, 3, 1, placement, ObjectId(), false));
+		REQUIRE_FALSE(index.FindBlank(stash_id, 4, 1, placement, ObjectId(), false));
+		REQUIRE_FALSE(index.FindBlank(ObjectId("6000000000000000000000ff"), 1, 1, placement));
+	}
+
+	SECTION("Nested containers are searched depth first")
+	{
+		REQUIRE(index.FindBlank(stash_id, 2, 2, placement));
+		REQUIRE(placement.container_id == backpack_id);
+		REQUIRE(placement.grid == "main");
+		REQUIRE(placement.location.y == 1);
+
+		REQUIRE_FALSE(index.FindBlank(stash_id, 2, 3, placement));
+		REQUIRE(index.GetCachedContainerCount() == 5);
+	}
+
+	SECTION("Grid filters")
+	{
+		REQUIRE(index.FindBlank(case_id, 1, 1, placement, roubles));
+		REQUIRE(placement.container_id == case_id);
+
+		REQUIRE_FALSE(index.FindBlank(case_id, 1, 1, placement, ObjectId("5447a9cd4bdc2dbd208b4567")));
+		REQUIRE_FALSE(index.FindBlank(case_id, 1, 1, placement, ObjectId("5696686a4bdc2da3298b456a")));
+		REQUIRE(index.FindBlank(case_id, 1, 1, placement));
+	}
+
+	SECTION("Defrag plan of a container grid")
+	{
+		auto plan = DefragPlan();
+		REQUIRE(index.PlanDefrag(stash_id, 3, 1, 2, plan));
+		REQUIRE(plan.grid == "hideout");
+		REQUIRE(plan.moves.empty());
+
+		// Rifle and backpack have no room outside of top row
+		REQUIRE_FALSE(index.PlanDefrag(stash_id, 4, 1, 2, plan));
+		REQUIRE_FALSE(index.PlanDefrag(ObjectId("6000000000000000000000ff"), 1, 1, 2, plan));
+	}
+
+	SECTION("Only touched containers are rebuilt")
+	{
+		REQUIRE_FALSE(index.FindBlank(backpack_id, 2, 3, placement));
+		REQUIRE(index.GetCachedContainerCount() == 2);
+
+		// Rifle leaves backpack for stash, both are touched
+		auto next = std::make_shared<Inventory>(*inventory);
+		auto touched = std::vector <ObjectId>();
+		REQUIRE(next->ApplyChanges(json::parse(R"({
+			"change": [ { "_id": "600000000000000000000004", "parentId": "5fe49a0e2694b0755a504770", "slotId": "hideout", "location": { "x": 1, "y": 1, "r": 0 } } ]
+		})"), &touched));
+		REQUIRE(std::find(touched.begin(), touched.end(), backpack_id) != touched.end());
+		REQUIRE(std::find(touched.begin(), touched.end(), stash_id) != touched.end());
+
+		index.Update(next, touched);
+		REQUIRE(index.GetCachedContainerCount() == 0);
+		REQUIRE(index.FindBlank(backpack_id, 2, 3, placement));
+		REQUIRE(index.FindBlank(stash_id, 1, 1, placement, ObjectId(), false));
+		REQUIRE(placement.location.x == 3);
+
+		// Stack count updates keep grids
+		touched.clear();
+		REQUIRE(next->ApplyChanges(json::parse(R"({ "change": [ { "_id": "600000000000000000000004", "upd": { "StackObjectsCount": 1 } } ] })"), &touched));
+		REQUIRE(touched.empty());
+	}
+}
+
+TEST_CASE("Assembled item sizes", "[multi-file:17]")
+{
+	// Rifle 2x1 folds its stock; stock adds a cell right, muzzle a forced one left, scope one up, cartridges don't count
+	auto items = std::make_shared<const json>(json::parse(R"({
+		"566abbc34bdc2d92178b4576": { "_id": "566abbc34bdc2d92178b4576", "_parent": "", "_props": { "Width": 1, "Height": 1, "Grids": [
+			{ "_name": "hideout", "_props": { "cellsH": 4, "cellsV": 2, "filters": [] } }
+		] } },
+		"5447a9cd4bdc2dbd208b4567": { "_id": "5447a9cd4bdc2dbd208b4567", "_parent": "", "_props": { "Width": 2, "Height": 1, "Foldable": true, "FoldedSlot": "mod_stock" } },
+		"700000000000000000000001": { "_id": "700000000000000000000001", "_parent": "", "_props": { "Width": 1, "Height": 1, "ExtraSizeRight": 1 } },
+		"700000000000000000000002": { "_id": "700000000000000000000002", "_parent": "", "_props": { "Width": 1, "Height": 1, "ExtraSizeLeft": 1, "ExtraSizeForceAdd": true } },
+		"700000000000000000000003": { "_id": "700000000000000000000003", "_parent": "", "_props": { "Width": 1, "Height": 1 } },
+		"700000000000000000000004": { "_id": "700000000000000000000004", "_parent": "", "_props": { "Width": 1, "Height": 1, "ExtraSizeUp": 1 } },
+		"700000000000000000000005": { "_id": "700000000000000000000005", "_parent": "", "_props": { "Width": 1, "Height": 1 } },
+		"700000000000000000000006": { "_id": "700000000000000000000006", "_parent": "", "_props": { "Width": 1, "Height": 1, "ExtraSizeDown": 2 } }
+	})"));
+
+	auto inventory = std::make_shared<Inventory>(json::parse(R"({
+		"stash": "5fe49a0e2694b0755a504770",
+		"items": [
+			{ "_id": "5fe49a0e2694b0755a504770", "_tpl": "566abbc34bdc2d92178b4576" },
+			{ "_id": "600000000000000000000001", "_tpl": "5447a9cd4bdc2dbd208b4567", "parentId": "5fe49a0e2694b0755a504770", "slotId": "hideout", "location": { "x": 0, "y": 0, "r": 0 } },
+			{ "_id": "600000000000000000000002", "_tpl": "700000000000000000000001", "parentId": "600000000000000000000001", "slotId": "mod_stock" },
+			{ "_id": "600000000000000000000003", "_tpl": "700000000000000000000002", "parentId": "600000000000000000000001", "slotId": "mod_muzzle" },
+			{ "_id": "600000000000000000000004", "_tpl": "700000000000000000000003", "parentId": "600000000000000000000001", "slotId": "mod_handguard" },
+			{ "_id": "600000000000000000000005", "_tpl": "700000000000000000000004", "parentId": "600000000000000000000004", "slotId": "mod_scope" },
+			{ "_id": "600000000000000000000006", "_tpl": "700000000000000000000005", "parentId": "600000000000000000000001", "slotId": "mod_magazine" },
+			{ "_id": "600000000000000000000007", "_tpl": "700000000000000000000006", "parentId": "600000000000000000000006", "slotId": "cartridges", "location": 0 }
+		]
+	})"));
+
+	const auto stash_id = ObjectId("5fe49a0e2694b0755a504770");
+	const auto rifle_id = ObjectId("600000000000000000000001");
+
+	auto index = ContainerIndex(items, inventory);
+	auto placement = GridPlacement();
+	int32_t width = 0, height = 0;
+
+	REQUIRE(index.GetItemSize(rifle_id, width, height));
+	REQUIRE(width == 4);
+	REQUIRE(height == 2);
+	REQUIRE(index.GetItemSize(ObjectId("600000000000000000000004"), width, height));
+	REQUIRE(width == 1);
+	REQUIRE(height == 2);
+	REQUIRE_FALSE(index.GetItemSize(ObjectId("6000000000000000000000ff"), width, height));
+
+	// Assembled rifle fills whole stash
+	REQUIRE_FALSE(index.FindBlank(stash_id, 1, 1, placement));
+
+	// Folding rifle leaves stock out
+	auto touched = std::vector <ObjectId>();
+	REQUIRE(inventory->ApplyChanges(json::parse(R"({ "change": [ { "_id": "600000000000000000000001", "upd": { "Foldable": { "Folded": true } } } ] })"), &touched));
+	index.Update(inventory, touched);
+
+	REQUIRE(index.GetItemSize(rifle_id, width, height));
+	REQUIRE(width == 3);
+	REQUIRE(index.FindBlank(stash_id, 1, 1, placement));
+	REQUIRE(placement.location.x == 3);
+
+	// Removing scope from handguard shrinks rifle it is attached to
+	touched.clear();
+	REQUIRE(inventory->ApplyChanges(json::parse(R"({ "del": [ { "_id": "600000000000000000000005" } ] })"), &touched));
+	index.Update(inventory, touched);
+
+	REQUIRE(index.GetItemSize(rifle_id, width, height));
+	REQUIRE(height == 1);
+	REQUIRE(index.FindBlank(stash_id, 4, 1, placement));
+	REQUIRE(placement.location.y == 1);
+}
@@ -0,0 +1,78 @@
+#include <catch2/catch.hpp>
+
+#include "../src/DefragPlanner.hpp"
+
+using namespace TarkovAPI;
+
+TEST_CASE("Defrag planner", "[multi-file:18]")
+{
+	auto plan = DefragPlan();
+
+	SECTION("Single blocker in the middle")
+	{
+		auto planner = DefragPlanner{ 3, 3 };
+		REQUIRE(planner.AddItem(ObjectId("600000000000000000000001"), ItemLocation{ 1, 1, false, true }, 1, 1));
+		REQUIRE_FALSE(planner.AddItem(ObjectId("600000000000000000000002"), ItemLocation{ 2, 2, false, true }, 2, 1));
+
+		// Item fits already
+		REQUIRE(planner.Plan(1, 1, 0, plan));
+		REQUIRE(plan.moves.empty());
+		REQUIRE(plan.target.x == 0);
+		REQUIRE(plan.target.y == 0);
+
+		// Every 2x2 area covers middle cell
+		REQUIRE_FALSE(planner.Plan(2, 2, 0, plan));
+		REQUIRE(planner.Plan(2, 2, 1, plan));
+		REQUIRE(plan.target.x == 0);
+		REQUIRE(plan.target.y == 0);
+		REQUIRE(plan.moves.size() == 1);
+		REQUIRE(plan.moves[0].item_id == ObjectId("600000000000000000000001"));
+		REQUIRE(plan.moves[0].location.x == 2);
+		REQUIRE(plan.moves[0].location.y == 0);
+
+		// Blocker has nowhere else to go
+		REQUIRE_FALSE(planner.Plan(3, 3, 8, plan));
+	}
+
+	SECTION("Orientation of moved items")
+	{
+		// Vertical 1x2 at (1,0), right column is taken
+		auto planner = DefragPlanner{ 3, 3 };
+		REQUIRE(planner.AddItem(ObjectId("600000000000000000000001"), ItemLocation{ 1, 0, false, true }, 1, 2));
+		REQUIRE(planner.AddItem(ObjectId("600000000000000000000002"), ItemLocation{ 2, 0, false, true }, 1, 3));
+
+		REQUIRE(planner.Plan(2, 2, 1, plan));
+		REQUIRE(plan.target.x == 0);
+		REQUIRE(plan.target.y == 0);
+		REQUIRE(plan.moves.size() == 1);
+		REQUIRE(plan.moves[0].location.x == 0);
+		REQUIRE(plan.moves[0].location.y == 2);
+		REQUIRE(plan.moves[0].location.rotated);
+
+		// Rotated item placed 1x2 stays rotated when it keeps its shape
+		auto rotated = DefragPlanner{ 3, 2 };
+		REQUIRE(rotated.AddItem(ObjectId("600000000000000000000003"), ItemLocation{ 1, 0, true, true }, 2, 1));
+
+		REQUIRE(rotated.Plan(2, 2, 1, plan));
+		REQUIRE(plan.moves.size() == 1);
+		REQUIRE(plan.moves[0].location.x == 2);
+		REQUIRE(plan.moves[0].location.rotated);
+	}
+
+	SECTION("Fewest moves win over earlier position")
+	{
+		// Row 0 needs two moves, row 2 only one
+		auto planner = DefragPlanner{ 4, 4 };
+		REQUIRE(planner.AddItem(ObjectId("600000000000000000000001"), ItemLocation{ 0, 0, false, true }, 1, 1));
+		REQUIRE(planner.AddItem(ObjectId("600000000000000000000002"), ItemLocation{ 2, 0, false, true }, 1, 1));
+		REQUIRE(planner.AddItem(ObjectId("600000000000000000000003"), ItemLocation{ 0, 1, false, true }, 4, 1));
+		REQUIRE(planner.AddItem(ObjectId("600000000000000000000004"), ItemLocation{ 1, 2, false, true }, 1, 1));
+		REQUIRE(planner.AddItem(ObjectId("600000000000000000000005"), ItemLocation{ 0, 3, false, true }, 4, 1));
+
+		REQUIRE(planner.Plan(4, 1, 8, plan));
+		REQUIRE(plan.target.y == 2);
+		REQUIRE(plan.moves.size() == 1);
+		REQUIRE(plan.moves[0].item_id == ObjectId("600000000000000000000004"));
+		REQUIRE(plan.moves[0].location.y == 0);
+	}
+}
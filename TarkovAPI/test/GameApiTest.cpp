@@ -57,20 +57,21 @@ TEST_CASE("Constants stuff tests", "[multi-file:4]")
 
         apiMgr->Login(ACC_EMAIL, ACC_PWD, ACC_HWID);
 
-        auto data = apiMgr->GetItems();
-        REQUIRE(!data.empty());
+        auto snapshot = apiMgr->GetItems();
+        REQUIRE(!snapshot->empty());
+        REQUIRE(apiMgr->GetItems() == snapshot); // cached snapshot is shared, not copied
 
-        data = apiMgr->GetItemPrices();
-        REQUIRE(!data.empty());
+        snapshot = apiMgr->GetItemPrices();
+        REQUIRE(!snapshot->empty());
 
-        data = apiMgr->GetLocations();
-        REQUIRE(!data.empty());
+        snapshot = apiMgr->GetLocations();
+        REQUIRE(!snapshot->empty());
 
-        data = apiMgr->GetWeather();
+        auto data = apiMgr->GetWeather();
         REQUIRE(!data.empty());
 
-        data = apiMgr->GetI18n("en");
-        REQUIRE(!data.empty());
+        snapshot = apiMgr->GetI18n("en");
+        REQUIRE(!snapshot->empty());
 
         ret = apiMgr->FinalizeTarkovAPIManager();
         REQUIRE(ret);
@@ -220,7 +221,7 @@ TEST_CASE("Search trader items", "[multi-file:4]")
 
         auto it = std::find_if(mechanic_items.begin(), mechanic_items.end(), [&buy_item_tpl](const quicktype::TraderItem& x)
             {
-                return x._tpl == buy_item_tpl;
+                return x._tpl.ToString() == buy_item_tpl;
             });
         REQUIRE(it != mechanic_items.end());
 
@@ -240,6 +241,110 @@ TEST_CASE("Search trader items", "[multi-file:4]")
     apiMgr = nullptr;
 }
 
+// Exposes assort cache internals, clock can be moved past resupply times of server
+class ResupplyTestManager : public TarkovAPIManager
+{
+public:
+    using TarkovAPIManager::RefreshTraderAssorts;
+    using TarkovAPIManager::InvalidateTraderAssort;
+
+    int64_t GetUnixTime() const override
+    {
+        return TarkovAPIManager::GetUnixTime() + clock_offset;
+    }
+
+    int64_t clock_offset{ 0 };
+};
+
+static uint64_t GetTradingRequestCount()
+{
+    uint64_t count = 0;
+    for (const auto& endpoint : MetricsRegistry::Instance().GetSnapshot())
+    {
+        if (endpoint.path.find("/client/trading/") != std::string::npos)
+        {
+            count += endpoint.requests;
+        }
+    }
+    return count;
+}
+
+TEST_CASE("Trader assort cache follows resupply", "[multi-file:4]")
+{
+    auto apiMgr = new ResupplyTestManager();
+    REQUIRE(apiMgr);
+
+    try
+    {
+        auto ret = apiMgr->InitializeTarkovAPIManager();
+        REQUIRE(ret);
+
+        apiMgr->Login(ACC_EMAIL, ACC_PWD, ACC_HWID);
+
+        auto traders = apiMgr->GetTraders();
+        REQUIRE(!traders.empty());
+
+        auto trader = traders.front();
+        REQUIRE(trader.contains("supply_next_time"));
+        auto trader_id = trader["_id"].get<std::string>();
+        auto resupply_in = trader["supply_next_time"].get<int64_t>() - apiMgr->GetUnixTime();
+        REQUIRE(resupply_in > 0);
+
+        // Resupply time is known from list, only assort and prices are fetched
+        auto requests = GetTradingRequestCount();
+        auto items = apiMgr->GetTraderItems(trader_id);
+        REQUIRE(!items.empty());
+        REQUIRE(GetTradingRequestCount() - requests == 2);
+
+        // Served from memory before resupply
+        requests = GetTradingRequestCount();
+        REQUIRE(apiMgr->GetTraderItems(trader_id).size() == items.size());
+        REQUIRE(GetTradingRequestCount() == requests);
+
+        // Nothing stale, refresh job stays quiet
+        apiMgr->RefreshTraderAssorts();
+        REQUIRE(GetTradingRequestCount() == requests);
+
+        // Catalog is kept until an assort changes
+        auto catalog = apiMgr->GetAllTraderItems();
+        REQUIRE(catalog->GetCount() > 0);
+        REQUIRE(apiMgr->GetAllTraderItems() == catalog);
+
+        apiMgr->InvalidateTraderAssort(trader_id);
+        auto rebuilt = apiMgr->GetAllTraderItems();
+        REQUIRE(rebuilt != catalog);
+        REQUIRE(rebuilt->GetCount() == catalog->GetCount());
+        REQUIRE(apiMgr->GetAllTraderItems() == rebuilt);
+
+        // Resupply and grace passed, assort is fetched again; server still reports passed time, trader is asked for it too
+        apiMgr->clock_offset = resupply_in + TRADER_RESUPPLY_GRACE_SECONDS;
+        requests = GetTradingRequestCount();
+        REQUIRE(apiMgr->GetTraderItems(trader_id).size() == items.size());
+        REQUIRE(GetTradingRequestCount() - requests == 3);
+        REQUIRE(apiMgr->GetAllTraderItems() != rebuilt);
+
+        // Late restock is retried by refresh job once grace passed again
+        apiMgr->clock_offset += TRADER_RESUPPLY_GRACE_SECONDS;
+        requests = GetTradingRequestCount();
+        apiMgr->RefreshTraderAssorts();
+        REQUIRE(GetTradingRequestCount() - requests == 3);
+
+        ret = apiMgr->FinalizeTarkovAPIManager();
+        REQUIRE(ret);
+    }
+    catch (const json::exception & ex)
+    {
+        apiMgr->Log(__FUNCTION__, LL_SYS, fmt::format("json::exception - An exception handled! Data: {}", ex.what()));
+    }
+    catch (const TarkovAPIException & ex)
+    {
+        apiMgr->Log(__FUNCTION__, LL_SYS, fmt::format("TarkovAPIException - An exception handled! Data: {}", ex.details().c_str()));
+    }
+
+    delete apiMgr;
+    apiMgr = nullptr;
+}
+
 TEST_CASE("Sell item to trader", "[multi-file:4]")
 {
     auto apiMgr = new TarkovAPIManager();
@@ -386,12 +491,12 @@ TEST_CASE("Buy item than trader with cash", "[multi-file:4]")
 
         auto it = std::find_if(mechanic_items.begin(), mechanic_items.end(), [&buy_item_tpl](const quicktype::TraderItem& x)
             {
-                return x._tpl == buy_item_tpl;
+                return x._tpl.ToString() == buy_item_tpl;
             });
         REQUIRE(it != mechanic_items.end());
 
         REQUIRE(it->costs.size() == 1);
-        REQUIRE(it->costs.at(0)._tpl == ROUBLE_ITEM_ID);
+        REQUIRE(it->costs.at(0)._tpl == ROUBLE_OBJECT_ID);
         REQUIRE(buy_item_count <= it->upd->stack_objects_count);
 
         auto item_price = apiMgr->GetItemPrice(it->costs.at(0).count, buy_item_count);
@@ -400,7 +505,7 @@ TEST_CASE("Buy item than trader with cash", "[multi-file:4]")
         auto given_item_ids = apiMgr->FindItemStack(ROUBLE_ITEM_ID, static_cast<uint64_t>(item_price));
         REQUIRE(!given_item_ids.empty());
 
-        apiMgr->TradeItem(mechanic_id, it->_id, buy_item_count, given_item_ids);
+        apiMgr->TradeItem(mechanic_id, it->_id.ToString(), buy_item_count, given_item_ids);
 
         auto new_rouble = apiMgr->GetRoubleCount();
         REQUIRE(rouble_count != new_rouble);
@@ -482,7 +587,7 @@ TEST_CASE("Buy item than trader with barter", "[multi-file:4]")
 
         auto it = std::find_if(therapist_items.begin(), therapist_items.end(), [&buy_item_tpl, &matches_tpl](const quicktype::TraderItem& x)
             {
-                return x._tpl == buy_item_tpl && x.costs.at(0)._tpl == matches_tpl;
+                return x._tpl.ToString() == buy_item_tpl && x.costs.at(0)._tpl.ToString() == matches_tpl;
             });
         REQUIRE(it != therapist_items.end());
 
@@ -495,7 +600,7 @@ TEST_CASE("Buy item than trader with barter", "[multi-file:4]")
         auto given_item_ids = apiMgr->FindItemStack(matches_tpl, static_cast<int64_t>(it->costs.at(0).count)* buy_item_count);
         REQUIRE(!given_item_ids.empty());
 
-        auto trade_ret = apiMgr->TradeItem(therapist_id, it->_id, buy_item_count, given_item_ids);
+        auto trade_ret = apiMgr->TradeItem(therapist_id, it->_id.ToString(), buy_item_count, given_item_ids);
         REQUIRE(!trade_ret.empty());
 
         ret = apiMgr->FinalizeTarkovAPIManager();
@@ -592,7 +697,7 @@ TEST_CASE("Sell item to regfair", "[multi-file:4]")
         REQUIRE(avg_price > 0);
 
         auto offer_ret = apiMgr->OfferItem(
-            { painkiller.at(0)._tpl },
+            { painkiller.at(0)._tpl.ToString() },
             { ROUBLE_ITEM_ID, avg_price },
             false
         );
@@ -635,7 +740,8 @@ TEST_CASE("Buy item than regfair", "[multi-file:4]")
 
         apiMgr->Log(__FUNCTION__, LL_SYS, fmt::format("> Hello, {}!", me["Info"]["Nickname"].get<std::string>()));
 
-        auto locale = apiMgr->GetI18n("en");
+        auto locale_snapshot = apiMgr->GetI18n("en");
+        const auto& locale = *locale_snapshot;
         REQUIRE(!locale.empty());
         REQUIRE(locale.contains("handbook"));
 
@@ -792,12 +898,12 @@ TEST_CASE("Stack/Transfer roubles in inventory", "[multi-file:4]")
             {
                 if (to_id.empty() && x.count < 500000)
                 {
-                    to_id = x._tpl;
+                    to_id = x._tpl.ToString();
                     amount = 500000 - static_cast<int64_t>(x.count);
                 }
-                if (from_id.empty() && to_id != x._tpl)
+                if (from_id.empty() && to_id != x._tpl.ToString())
                 {
-                    from_id = x._tpl;
+                    from_id = x._tpl.ToString();
                 }
                 return !from_id.empty() && !to_id.empty();
             });
@@ -858,11 +964,11 @@ TEST_CASE("Merge bullets in inventory", "[multi-file:4]")
             {
                 if (to_id.empty())
                 {
-                    to_id = x._tpl;
+                    to_id = x._tpl.ToString();
                 }
-                if (from_id.empty() && to_id != x._tpl)
+                if (from_id.empty() && to_id != x._tpl.ToString())
                 {
-                    from_id = x._tpl;
+                    from_id = x._tpl.ToString();
                 }
                 return !from_id.empty() && !to_id.empty();
             });
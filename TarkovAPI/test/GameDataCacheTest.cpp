@@ -0,0 +1,89 @@
+#include <catch2/catch.hpp>
+#include <json.hpp>
+#include <fstream>
+#include <filesystem>
+
+#include "../src/GameDataCache.hpp"
+
+using namespace TarkovAPI;
+using json = nlohmann::json;
+
+TEST_CASE("Game data cache", "[multi-file:12]")
+{
+	const auto directory = std::string("GameDataCacheTest");
+	std::filesystem::remove_all(directory);
+
+	auto items = json{ { "5449016a4bdc2d6f028b456f", { { "_name", "Roubles" } } } };
+
+	SECTION("Stored data is reloaded by a new instance")
+	{
+		{
+			GameDataCache cache(directory, "0.12.3.5834");
+			REQUIRE(cache.GetCrc("items") == 0);
+			REQUIRE(cache.Store("items", items, 1234));
+			REQUIRE(cache.Store("locale_en", json{ { "interface", json::object() } }, 99));
+			REQUIRE_FALSE(cache.Store("prices", json::object(), 0)); // server sent no crc
+		}
+
+		GameDataCache cache(directory, "0.12.3.5834");
+		REQUIRE(cache.GetEntryCount() == 2);
+		REQUIRE(cache.GetCrc("items") == 1234);
+		REQUIRE(cache.GetCrc("prices") == 0);
+
+		json data{};
+		REQUIRE(cache.Load("items", data));
+		REQUIRE(data == items);
+	}
+
+	SECTION("Other game versions are dropped")
+	{
+		{
+			GameDataCache cache(directory, "0.12.3.5834");
+			REQUIRE(cache.Store("items", items, 1234));
+		}
+
+		GameDataCache cache(directory, "0.12.4.6000");
+		REQUIRE(cache.GetCrc("items") == 0);
+		REQUIRE_FALSE(std::filesystem::exists(std::filesystem::path(directory) / "0.12.3.5834"));
+	}
+
+	SECTION("Directories not written by cache are kept")
+	{
+		// Cache may be pointed at a directory shared with other data
+		std::filesystem::create_directories(std::filesystem::path(directory) / "Documents");
+		std::ofstream(std::filesystem::path(directory) / "Documents" / "notes.txt") << "keep";
+		std::filesystem::create_directories(std::filesystem::path(directory) / "Project");
+		std::ofstream(std::filesystem::path(directory) / "Project" / "index.json") << "{}";
+		std::ofstream(std::filesystem::path(directory) / "Project" / "main.cpp") << "int main() {}";
+
+		{
+			GameDataCache cache(directory, "0.12.3.5834");
+			REQUIRE(cache.Store("items", items, 1234));
+		}
+		GameDataCache cache(directory, "0.12.4.6000");
+
+		REQUIRE(std::filesystem::exists(std::filesystem::path(directory) / "Documents" / "notes.txt"));
+		REQUIRE(std::filesystem::exists(std::filesystem::path(directory) / "Project" / "main.cpp"));
+		REQUIRE_FALSE(std::filesystem::exists(std::filesystem::path(directory) / "0.12.3.5834"));
+	}
+
+	SECTION("Damaged data file forgets its crc")
+	{
+		GameDataCache cache(directory, "0.12.3.5834");
+		REQUIRE(cache.Store("items", items, 1234));
+
+		std::ofstream(std::filesystem::path(cache.GetDirectory()) / "items.data", std::ios::trunc) << "{\"truncated\":";
+
+		json data{};
+		REQUIRE_FALSE(cache.Load("items", data));
+		REQUIRE(cache.GetCrc("items") == 0);
+	}
+
+	SECTION("Keys are safe file names")
+	{
+		REQUIRE(GameDataCache::SanitizeKey("locale_en") == "locale_en");
+		REQUIRE(GameDataCache::SanitizeKey("locale/../en") == "locale_.._en");
+	}
+
+	std::filesystem::remove_all(directory);
+}
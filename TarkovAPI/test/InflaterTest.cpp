@@ -0,0 +1,63 @@
+#include <catch2/catch.hpp>
+#include <json.hpp>
+#include <zlib.h>
+
+#include "../src/Inflater.hpp"
+
+using namespace TarkovAPI;
+using json = nlohmann::json;
+
+static std::string CompressBuffer(const std::string& data)
+{
+	auto out = std::string(compressBound(static_cast<uLong>(data.size())), '\0');
+
+	auto out_size = static_cast<uLongf>(out.size());
+	auto ret = compress(reinterpret_cast<Bytef*>(&out[0]), &out_size, reinterpret_cast<const Bytef*>(data.data()), static_cast<uLong>(data.size()));
+	REQUIRE(ret == Z_OK);
+
+	out.resize(out_size);
+	return out;
+}
+
+TEST_CASE("Streaming inflate", "[multi-file:5]")
+{
+	json payload{};
+	payload["err"] = 0;
+	payload["errmsg"] = nullptr;
+	for (auto i = 0; i < 20000; ++i)
+		payload["data"][fmt::format("{:024x}", i)] = { {"Name", "Item"}, {"Width", i % 5} };
+
+	const auto raw = payload.dump();
+	const auto compressed = CompressBuffer(raw);
+
+	SECTION("Small input pieces")
+	{
+		auto out = std::string();
+		auto max_chunk = size_t(0);
+
+		ZlibInflater inflater;
+		for (size_t pos = 0; pos < compressed.size(); pos += 7)
+		{
+			inflater.Feed(compressed.data() + pos, std::min<size_t>(7, compressed.size() - pos), [&out, &max_chunk](const char* chunk, size_t size) {
+				max_chunk = std::max(max_chunk, size);
+				out.append(chunk, size);
+			});
+		}
+		inflater.Finish();
+
+		REQUIRE(max_chunk <= INFLATE_CHUNK_SIZE);
+		REQUIRE(out == raw);
+		REQUIRE(json::parse(out) == payload);
+	}
+
+	SECTION("Output larger than any fixed guess")
+	{
+		REQUIRE(raw.size() > compressed.size() * 10);
+		REQUIRE(InflateBuffer(compressed.data(), compressed.size()) == raw);
+	}
+
+	SECTION("Truncated stream")
+	{
+		REQUIRE_THROWS_AS(InflateBuffer(compressed.data(), compressed.size() / 2), TarkovAPIException);
+	}
+}
@@ -0,0 +1,109 @@
+#include <catch2/catch.hpp>
+#include <json.hpp>
+#include <vector>
+
+#include "../src/Inventory.hpp"
+#include "../src/Constants.hpp"
+
+using namespace TarkovAPI;
+using json = nlohmann::json;
+
+TEST_CASE("Inventory indexes", "[multi-file:15]")
+{
+	auto inventory = Inventory(json::parse(R"({
+		"equipment": "5fe49a0e2694b0755a50476d",
+		"stash": "5fe49a0e2694b0755a504770",
+		"items": [
+			{ "_id": "5fe49a0e2694b0755a50476d", "_tpl": "55d7217a4bdc2d86028b456d" },
+			{ "_id": "5fe49a0e2694b0755a504770", "_tpl": "566abbc34bdc2d92178b4576" },
+			{ "_id": "600000000000000000000001", "_tpl": "5449016a4bdc2d6f028b456f", "parentId": "5fe49a0e2694b0755a504770", "slotId": "hideout", "location": { "x": 0, "y": 0, "r": 0 }, "upd": { "StackObjectsCount": 500000 } },
+			{ "_id": "600000000000000000000002", "_tpl": "5447a9cd4bdc2dbd208b4567", "parentId": "5fe49a0e2694b0755a504770", "slotId": "hideout", "location": { "x": 1, "y": 0, "r": "Vertical" } },
+			{ "_id": "600000000000000000000003", "_tpl": "5449016a4bdc2d6f028b456f", "parentId": "5fe49a0e2694b0755a504770", "slotId": "hideout", "location": { "x": 6, "y": 2, "r": 1 }, "upd": { "StackObjectsCount": 1200 } },
+			{ "_id": "600000000000000000000004", "_tpl": "55d4887d4bdc2d962f8b4570", "parentId": "600000000000000000000002", "slotId": "mod_magazine" },
+			{ "_id": "600000000000000000000005", "_tpl": "54527a984bdc2d4e668b4567", "parentId": "600000000000000000000004", "slotId": "cartridges", "location": 1, "upd": { "StackObjectsCount": 30 } },
+			{ "_id": "600000000000000000000006", "_tpl": "5449016a4bdc2d6f028b456f", "parentId": "5fe49a0e2694b0755a504770", "slotId": "main", "upd": { "StackObjectsCount": 10 } },
+			{ "_id": "hideout", "_tpl": "5449016a4bdc2d6f028b456f" },
+			{ "_tpl": "5449016a4bdc2d6f028b456f" }
+		]
+	})"));
+
+	const auto stash_id = ObjectId("5fe49a0e2694b0755a504770");
+
+	SECTION("Columns and id lookup")
+	{
+		REQUIRE(inventory.GetCount() == 8);
+		REQUIRE(inventory.GetStashId() == stash_id);
+		REQUIRE(inventory.GetEquipmentId() == ObjectId("5fe49a0e2694b0755a50476d"));
+
+		auto rifle = inventory.Find(ObjectId("600000000000000000000002"));
+		REQUIRE(rifle == 3);
+		REQUIRE(inventory.GetParent(rifle) == stash_id);
+		REQUIRE(inventory.GetSlot(rifle) == "hideout");
+		REQUIRE(inventory.GetStackCount(rifle) == 1);
+		REQUIRE(inventory.GetLocation(rifle).in_grid);
+		REQUIRE(inventory.GetLocation(rifle).rotated);
+
+		auto cartridges = inventory.Find(ObjectId("600000000000000000000005"));
+		REQUIRE_FALSE(inventory.GetLocation(cartridges).in_grid);
+		REQUIRE(inventory.GetLocation(cartridges).x == 1);
+		REQUIRE(inventory.GetStackCount(cartridges) == 30);
+
+		REQUIRE(inventory.GetParent(inventory.Find(stash_id)).IsNull());
+		REQUIRE(inventory.Find(ObjectId("000000000000000000000001")) == Inventory::NPOS);
+	}
+
+	SECTION("Template index keeps inventory order")
+	{
+		auto roubles = inventory.FindByTemplate(ROUBLE_OBJECT_ID);
+		REQUIRE(std::vector<uint32_t>(roubles.begin(), roubles.end()) == std::vector<uint32_t>{ 2, 4, 7 });
+		REQUIRE(inventory.GetStackTotal(ROUBLE_OBJECT_ID) == 501210);
+
+		REQUIRE(inventory.FindByTemplate(USD_OBJECT_ID).empty());
+		REQUIRE(inventory.GetStackTotal(USD_OBJECT_ID) == 0);
+	}
+
+	SECTION("Children by container and slot")
+	{
+		REQUIRE(inventory.GetChildren(stash_id).size() == 4);
+
+		auto grid = inventory.GetChildren(stash_id, "hideout");
+		REQUIRE(std::vector<uint32_t>(grid.begin(), grid.end()) == std::vector<uint32_t>{ 2, 3, 4 });
+
+		auto main = inventory.GetChildren(stash_id, "main");
+		REQUIRE(main.size() == 1);
+		REQUIRE(inventory.GetId(*main.begin()) == ObjectId("600000000000000000000006"));
+
+		REQUIRE(inventory.GetChildren(stash_id, "cartridges").empty());
+		REQUIRE(inventory.GetChildren(ObjectId("600000000000000000000004"), "cartridges").size() == 1);
+		REQUIRE(inventory.GetChildren(ObjectId("600000000000000000000005")).empty());
+	}
+
+	SECTION("Item changes of an items/moving response")
+	{
+		REQUIRE(inventory.ApplyChanges(json::parse(R"({
+			"new": [ { "_id": "600000000000000000000007", "_tpl": "5449016a4bdc2d6f028b456f", "parentId": "5fe49a0e2694b0755a504770", "slotId": "hideout", "location": { "x": 8, "y": 9, "r": 0 }, "upd": { "StackObjectsCount": 90 } } ],
+			"change": [
+				{ "_id": "600000000000000000000003", "upd": { "StackObjectsCount": 200 } },
+				{ "_id": "600000000000000000000006", "parentId": "5fe49a0e2694b0755a504770", "slotId": "hideout", "location": { "x": 4, "y": 4, "r": 1 } }
+			],
+			"del": [ { "_id": "600000000000000000000002" } ]
+		})")));
+
+		// Rifle went with its magazine and cartridges
+		REQUIRE(inventory.GetCount() == 6);
+		REQUIRE(inventory.Find(ObjectId("600000000000000000000002")) == Inventory::NPOS);
+		REQUIRE(inventory.Find(ObjectId("600000000000000000000005")) == Inventory::NPOS);
+
+		REQUIRE(inventory.GetStackTotal(ROUBLE_OBJECT_ID) == 500300);
+		REQUIRE(inventory.GetChildren(stash_id, "main").empty());
+
+		auto moved = inventory.Find(ObjectId("600000000000000000000006"));
+		REQUIRE(inventory.GetSlot(moved) == "hideout");
+		REQUIRE(inventory.GetLocation(moved).rotated);
+		REQUIRE(inventory.GetStackCount(moved) == 10);
+		REQUIRE(inventory.GetChildren(stash_id, "hideout").size() == 4);
+
+		REQUIRE_FALSE(inventory.ApplyChanges(json::parse(R"({ "del": [ { "_id": "600000000000000000000002" } ] })")));
+		REQUIRE_FALSE(inventory.ApplyChanges(json::parse(R"({ "change": [ { "_id": "6000000000000000000000ff", "upd": { "StackObjectsCount": 1 } } ] })")));
+	}
+}
@@ -20,7 +20,7 @@ TEST_CASE("Basic auth test with random hwid", "[multi-file:3][!hide]") // Hide t
         auto ret = apiMgr->InitializeTarkovAPIManager();
         REQUIRE(ret);
 
-        auto client = new cpr::Session();
+        auto client = new HttpClient();
         REQUIRE(client);
 
         auto hwid = hwid::generate_hwid();
@@ -92,7 +92,7 @@ TEST_CASE("Basic auth test with known hwid", "[multi-file:3]")
         auto ret = apiMgr->InitializeTarkovAPIManager();
         REQUIRE(ret);
 
-        auto client = new cpr::Session();
+        auto client = new HttpClient();
         REQUIRE(client);
 
         auto hwid = ACC_HWID;
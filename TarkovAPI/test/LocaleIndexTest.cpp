@@ -0,0 +1,62 @@
+#include <catch2/catch.hpp>
+#include <json.hpp>
+#include <memory>
+
+#include "../src/LocaleIndex.hpp"
+
+using namespace TarkovAPI;
+using json = nlohmann::json;
+
+TEST_CASE("Locale index", "[multi-file:13]")
+{
+	auto locale = std::make_shared<const json>(json::parse(R"({
+		"interface": { "Attention": "Attention" },
+		"templates": {
+			"5449016a4bdc2d6f028b456f": { "Name": "Roubles", "ShortName": "RUB", "Description": "Russian currency" },
+			"566abbc34bdc2d92178b4576": { "Name": "Stash", "Description": "Standard stash" },
+			"5d1b36a186f7742523398433": { "Name": 42 }
+		},
+		"trading": {
+			"54cb50c76803fa8b248b4571": { "FullName": "Pavel Yegorovich Romanenko", "Nickname": "Prapor" },
+			"5c0647fdd443bc2504c2d371": { "FullName": "Jaeger", "Nickname": "Jaeger" }
+		},
+		"handbook": { "5b47574386f77428ca22b2ee": "Barter items" }
+	})"));
+
+	LocaleIndex index(locale);
+
+	SECTION("Item names")
+	{
+		REQUIRE(index.GetItemCount() == 2);
+
+		auto roubles = index.FindItem("5449016a4bdc2d6f028b456f");
+		REQUIRE(roubles);
+		REQUIRE(roubles->name == "Roubles");
+		REQUIRE(roubles->short_name == "RUB");
+		REQUIRE(roubles->description == "Russian currency");
+
+		auto stash = index.FindItem("566abbc34bdc2d92178b4576");
+		REQUIRE(stash);
+		REQUIRE(stash->short_name.empty());
+
+		REQUIRE(index.FindItem("5d1b36a186f7742523398433") == nullptr); // name is not a string
+		REQUIRE(index.FindItem("000000000000000000000000") == nullptr);
+	}
+
+	SECTION("Trader nicknames")
+	{
+		REQUIRE(index.GetTraderCount() == 2);
+		REQUIRE(index.FindTraderId("Prapor") == "54cb50c76803fa8b248b4571");
+		REQUIRE(index.FindTraderId("Jaeger") == "5c0647fdd443bc2504c2d371");
+		REQUIRE(index.FindTraderId("Fence").empty());
+	}
+
+	SECTION("Views stay valid while index is held")
+	{
+		auto held = std::make_shared<const LocaleIndex>(locale);
+		locale.reset();
+
+		REQUIRE(held->FindItem("5449016a4bdc2d6f028b456f")->name == "Roubles");
+		REQUIRE(held->GetLocale()->contains("handbook"));
+	}
+}
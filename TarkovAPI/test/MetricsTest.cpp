@@ -0,0 +1,135 @@
+#include <catch2/catch.hpp>
+#include <json.hpp>
+#include <zlib.h>
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+
+#include "../src/Metrics.hpp"
+#include "../src/TrafficCapture.hpp"
+#include "../src/HttpClient.hpp"
+
+using namespace TarkovAPI;
+using json = nlohmann::json;
+
+static std::string CompressString(const std::string& raw)
+{
+	auto out = std::string(compressBound(static_cast<uLong>(raw.size())), '\0');
+
+	auto out_size = static_cast<uLongf>(out.size());
+	auto ret = compress(reinterpret_cast<Bytef*>(&out[0]), &out_size, reinterpret_cast<const Bytef*>(raw.data()), static_cast<uLong>(raw.size()));
+	REQUIRE(ret == Z_OK);
+
+	out.resize(out_size);
+	return out;
+}
+
+TEST_CASE("Endpoint metrics", "[multi-file:8]")
+{
+	auto& registry = MetricsRegistry::Instance();
+	registry.Reset();
+
+	SECTION("Paths are folded")
+	{
+		REQUIRE(MetricsRegistry::NormalizePath("https://prod.escapefromtarkov.com/client/items") == "/client/items");
+		REQUIRE(MetricsRegistry::NormalizePath("https://launcher.escapefromtarkov.com/launcher/login?launcherVersion=0&branch=live") == "/launcher/login");
+		REQUIRE(MetricsRegistry::NormalizePath("https://trading.escapefromtarkov.com/client/trading/api/getTraderAssort/5935c25fb3acc3127c3d8cd9") == "/client/trading/api/getTraderAssort/:id");
+		REQUIRE(MetricsRegistry::NormalizePath("http://127.0.0.1:8080") == "/");
+	}
+
+	SECTION("Requests, codes and phases")
+	{
+		auto transfer = TransferMetrics{};
+		transfer.network_us = 2000;
+		transfer.inflate_us = 300;
+		transfer.parse_us = 40;
+		transfer.compressed_bytes = 100;
+		transfer.decompressed_bytes = 1000;
+
+		registry.RecordRequest("https://prod.escapefromtarkov.com/client/items", transfer, 0);
+		registry.RecordHandle(20);
+		registry.RecordRequest("http://127.0.0.1:8080/client/items", transfer, 0);
+		registry.RecordRequest("https://prod.escapefromtarkov.com/client/items", transfer, 201);
+		registry.RecordHandle(20000);
+		registry.RecordRequest("https://prod.escapefromtarkov.com/client/items", TransferMetrics{}, REQUEST_FAILED_CODE);
+
+		EndpointMetricsSnapshot snapshot{};
+		REQUIRE(registry.GetEndpointSnapshot("/client/items", snapshot));
+		REQUIRE(snapshot.requests == 4);
+		REQUIRE(snapshot.responses[0] == 2);
+		REQUIRE(snapshot.responses[201] == 1);
+		REQUIRE(snapshot.responses[REQUEST_FAILED_CODE] == 1);
+		REQUIRE(snapshot.compressed_bytes == 300);
+		REQUIRE(snapshot.decompressed_bytes == 3000);
+
+		REQUIRE(snapshot.network.count == 4);
+		REQUIRE(snapshot.network.sum_us == 6000);
+		REQUIRE(snapshot.network.Quantile(0.5) == 2500.0);
+		REQUIRE(snapshot.inflate.Quantile(0.99) == 500.0);
+
+		REQUIRE(snapshot.handle.count == 2);
+		REQUIRE(snapshot.handle.Mean() == 10010.0);
+		REQUIRE(snapshot.handle.Quantile(0.25) == 50.0);
+		REQUIRE(snapshot.handle.Quantile(1.0) == 25000.0);
+
+		REQUIRE_FALSE(registry.GetEndpointSnapshot("/client/weather", snapshot));
+	}
+
+	SECTION("Prometheus exposition")
+	{
+		auto transfer = TransferMetrics{};
+		transfer.network_us = 1500000;
+		registry.RecordRequest("https://prod.escapefromtarkov.com/client/game/profile/list", transfer, 0);
+		registry.RecordRequest("https://prod.escapefromtarkov.com/client/game/profile/list", transfer, REQUEST_FAILED_CODE);
+
+		auto text = registry.ToPrometheus();
+		REQUIRE(text.find("# TYPE tarkovapi_phase_seconds histogram\n") != std::string::npos);
+		REQUIRE(text.find("tarkovapi_requests_total{path=\"/client/game/profile/list\"} 2\n") != std::string::npos);
+		REQUIRE(text.find("tarkovapi_responses_total{path=\"/client/game/profile/list\",code=\"0\"} 1\n") != std::string::npos);
+		REQUIRE(text.find("tarkovapi_responses_total{path=\"/client/game/profile/list\",code=\"failed\"} 1\n") != std::string::npos);
+		REQUIRE(text.find("tarkovapi_phase_seconds_bucket{path=\"/client/game/profile/list\",phase=\"network\",le=\"1\"} 0\n") != std::string::npos);
+		REQUIRE(text.find("tarkovapi_phase_seconds_bucket{path=\"/client/game/profile/list\",phase=\"network\",le=\"2.5\"} 2\n") != std::string::npos);
+		REQUIRE(text.find("tarkovapi_phase_seconds_bucket{path=\"/client/game/profile/list\",phase=\"network\",le=\"+Inf\"} 2\n") != std::string::npos);
+		REQUIRE(text.find("tarkovapi_phase_seconds_sum{path=\"/client/game/profile/list\",phase=\"network\"} 3\n") != std::string::npos);
+
+		const auto path = std::string("MetricsTest.prom");
+		REQUIRE(registry.WriteDump(path));
+
+		std::stringstream ss;
+		ss << std::ifstream(path).rdbuf();
+		REQUIRE(ss.str() == text);
+
+		std::remove(path.c_str());
+	}
+
+	SECTION("Transfer sizes from replayed response")
+	{
+		const auto path = std::string("MetricsTest.cap");
+		std::remove(path.c_str());
+		std::remove((path + ".idx").c_str());
+
+		auto raw = json({ {"err", 0}, {"errmsg", nullptr}, {"data", std::string(50000, 'x')} }).dump();
+		auto compressed = CompressString(raw);
+		{
+			TrafficCapture capture(path);
+			capture.Append("https://prod.escapefromtarkov.com/client/items", "", cpr::Header{}, 200, compressed);
+		}
+		{
+			TrafficReplay replay(path);
+
+			HttpClient client;
+			client.SetReplay(&replay);
+			client.PostJson("https://prod.escapefromtarkov.com/client/items", "", cpr::Header{});
+
+			const auto& transfer = client.GetLastTransfer();
+			REQUIRE(transfer.compressed_bytes == compressed.size());
+			REQUIRE(transfer.decompressed_bytes == raw.size());
+			REQUIRE(transfer.network_us == 0);
+		}
+
+		std::remove(path.c_str());
+		std::remove((path + ".idx").c_str());
+	}
+
+	registry.Reset();
+}
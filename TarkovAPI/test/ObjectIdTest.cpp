@@ -0,0 +1,70 @@
+#include <catch2/catch.hpp>
+#include <json.hpp>
+#include <unordered_set>
+#include <type_traits>
+
+#include "../src/ObjectId.hpp"
+#include "../src/Constants.hpp"
+#include "../src/Exception.hpp"
+
+using namespace TarkovAPI;
+using json = nlohmann::json;
+
+static_assert(sizeof(ObjectId) == ObjectId::SIZE, "ObjectId must stay 12 bytes");
+static_assert(std::is_trivially_copyable<ObjectId>::value, "ObjectId must be trivially copyable");
+
+TEST_CASE("Object id", "[multi-file:14]")
+{
+	SECTION("Text round trip")
+	{
+		for (const auto& text : { "5449016a4bdc2d6f028b456f", "000000000000000000000000", "ffffffffffffffffffffffff", "0123456789abcdef01234567" })
+		{
+			ObjectId id{};
+			REQUIRE(ObjectId::TryParse(text, id));
+			REQUIRE(id.ToString() == text);
+		}
+
+		auto id = ObjectId("5449016a4bdc2d6f028b456f");
+		REQUIRE(id.GetBytes()[0] == 0x54);
+		REQUIRE(id.GetBytes()[11] == 0x6f);
+		REQUIRE(id == ROUBLE_OBJECT_ID);
+		REQUIRE(ObjectId("5449016A4BDC2D6F028B456F") == ROUBLE_OBJECT_ID);
+		REQUIRE(ObjectId().IsNull());
+		REQUIRE_FALSE(ROUBLE_OBJECT_ID.IsNull());
+	}
+
+	SECTION("Malformed text is rejected")
+	{
+		ObjectId id = USD_OBJECT_ID;
+		for (const auto& text : { "", "5449016a4bdc2d6f028b456", "5449016a4bdc2d6f028b456f0", "5449016a4bdc2d6f028b456g", "g449016a4bdc2d6f028b456f", "5449016a4bdc2d6f0:8b456f", "5449016a4bdc2d6f028b45 f", "hideout" })
+		{
+			REQUIRE_FALSE(ObjectId::TryParse(text, id));
+		}
+		REQUIRE_FALSE(ObjectId::TryParse("5449016a4bdc2d6f\xE0" "28b456f", id));
+		REQUIRE(id == USD_OBJECT_ID);
+
+		REQUIRE_THROWS_AS(ObjectId("not an id"), TarkovAPIException);
+	}
+
+	SECTION("Order and hash")
+	{
+		REQUIRE(ObjectId("5449016a4bdc2d6f028b456f") < ObjectId("5696686a4bdc2da3298b456a"));
+		REQUIRE(ObjectId("5696686a4bdc2da3298b456a") < ObjectId("569668774bdc2da2298b4568"));
+		REQUIRE(USD_OBJECT_ID != EURO_OBJECT_ID);
+
+		std::unordered_set <ObjectId> ids{ ROUBLE_OBJECT_ID, USD_OBJECT_ID, EURO_OBJECT_ID, ROUBLE_OBJECT_ID };
+		REQUIRE(ids.size() == 3);
+		REQUIRE(ids.count(ObjectId(EURO_ITEM_ID)) == 1);
+	}
+
+	SECTION("Json form is the hex string")
+	{
+		auto item = json::parse(R"({ "id": "5449016a4bdc2d6f028b456f", "count": 1500 })").get<quicktype::TraderBarterItem>();
+		REQUIRE(item._tpl == ROUBLE_OBJECT_ID);
+
+		json out = item;
+		REQUIRE(out["id"] == ROUBLE_ITEM_ID);
+
+		REQUIRE_THROWS_AS(json("hideout").get<ObjectId>(), TarkovAPIException);
+	}
+}
@@ -0,0 +1,309 @@
+#include <catch2/catch.hpp>
+#include <thread>
+#include <vector>
+#include <mutex>
+#include <atomic>
+#include <chrono>
+#include <algorithm>
+#include <future>
+
+#include "../src/RequestScheduler.hpp"
+
+using namespace TarkovAPI;
+using namespace std::chrono_literals;
+
+static const auto PROD_URL = std::string("https://prod.escapefromtarkov.com/client/items");
+static const auto RAGFAIR_URL = std::string("https://ragfair.escapefromtarkov.com/client/ragfair/find");
+
+static RateBudget MakeBudget(double requests_per_second, double burst)
+{
+	auto budget = RateBudget{};
+	budget.requests_per_second = requests_per_second;
+	budget.burst = burst;
+	return budget;
+}
+
+static double SecondsSince(std::chrono::steady_clock::time_point begin)
+{
+	return std::chrono::duration<double>(std::chrono::steady_clock::now() - begin).count();
+}
+
+TEST_CASE("Lock-free request queue", "[multi-file:10]")
+{
+	struct Node : MpscNode
+	{
+		int producer;
+		int index;
+	};
+
+	const auto producers = 4;
+	const auto per_producer = 5000;
+
+	MpscQueue queue;
+	std::vector <Node> nodes(producers * per_producer);
+
+	std::vector <std::thread> threads;
+	for (auto p = 0; p < producers; ++p)
+	{
+		threads.emplace_back([&, p] {
+			for (auto i = 0; i < per_producer; ++i)
+			{
+				auto& node = nodes[p * per_producer + i];
+				node.producer = p;
+				node.index = i;
+				queue.Push(&node);
+			}
+		});
+	}
+
+	// Per producer order is kept
+	std::vector <int> next(producers, 0);
+	auto popped = 0;
+	while (popped < producers * per_producer)
+	{
+		auto node = static_cast<Node*>(queue.Pop());
+		if (!node)
+		{
+			std::this_thread::yield();
+			continue;
+		}
+		REQUIRE(node->index == next[node->producer]);
+		next[node->producer]++;
+		popped++;
+	}
+
+	for (auto& thread : threads)
+	{
+		thread.join();
+	}
+	REQUIRE(queue.Pop() == nullptr);
+}
+
+TEST_CASE("Request scheduler", "[multi-file:10]")
+{
+	RequestScheduler scheduler;
+
+	SECTION("Token bucket limits request rate per host")
+	{
+		scheduler.SetDefaultBudget(MakeBudget(20.0, 2.0));
+
+		auto begin = std::chrono::steady_clock::now();
+		for (auto i = 0; i < 10; ++i)
+		{
+			REQUIRE(scheduler.Run(RequestPriority::Interactive, PROD_URL, [i] { return i; }) == i);
+		}
+		// Burst of 2, then 8 requests at 20/s
+		REQUIRE(SecondsSince(begin) >= 0.35);
+
+		// Other host has its own bucket
+		begin = std::chrono::steady_clock::now();
+		scheduler.Run(RequestPriority::Interactive, RAGFAIR_URL, [] { return 0; });
+		scheduler.Run(RequestPriority::Interactive, RAGFAIR_URL, [] { return 0; });
+		REQUIRE(SecondsSince(begin) < 0.1);
+
+		REQUIRE(scheduler.GetAdmittedCount(RequestPriority::Interactive) == 12);
+	}
+
+	SECTION("Interactive requests overtake queued bulk requests")
+	{
+		scheduler.SetDefaultBudget(MakeBudget(0.0, 0.0));
+
+		std::atomic <bool> release{ false };
+		std::atomic <bool> started{ false };
+		std::mutex order_mutex;
+		std::vector <std::string> order;
+
+		// Occupies the only in flight slot of host
+		std::thread blocker([&] {
+			scheduler.Run(RequestPriority::Bulk, PROD_URL, [&] {
+				started = true;
+				while (!release)
+				{
+					std::this_thread::sleep_for(1ms);
+				}
+				return 0;
+			});
+		});
+		while (!started)
+		{
+			std::this_thread::sleep_for(1ms);
+		}
+
+		auto submit = [&](RequestPriority priority, const std::string& name) {
+			return std::thread([&, priority, name] {
+				scheduler.Run(priority, PROD_URL, [&] {
+					std::lock_guard <std::mutex> lock(order_mutex);
+					order.emplace_back(name);
+					return 0;
+				});
+			});
+		};
+
+		std::vector <std::thread> threads;
+		for (auto i = 0; i < 5; ++i)
+		{
+			threads.emplace_back(submit(RequestPriority::Bulk, "bulk"));
+		}
+		while (scheduler.GetQueuedCount() < 5)
+		{
+			std::this_thread::sleep_for(1ms);
+		}
+		threads.emplace_back(submit(RequestPriority::Interactive, "interactive"));
+		threads.emplace_back(submit(RequestPriority::Session, "session"));
+		while (scheduler.GetQueuedCount() < 7)
+		{
+			std::this_thread::sleep_for(1ms);
+		}
+
+		release = true;
+		blocker.join();
+		for (auto& thread : threads)
+		{
+			thread.join();
+		}
+
+		REQUIRE(order.size() == 7);
+		REQUIRE(order[0] == "session");
+		REQUIRE(order[1] == "interactive");
+		REQUIRE(scheduler.GetQueuedCount() == 0);
+	}
+
+	SECTION("Session requests are not throttled")
+	{
+		scheduler.SetDefaultBudget(MakeBudget(0.5, 1.0));
+		scheduler.Run(RequestPriority::Interactive, PROD_URL, [] { return 0; });
+
+		auto begin = std::chrono::steady_clock::now();
+		scheduler.Run(RequestPriority::Session, PROD_URL, [] { return 0; });
+		scheduler.Run(RequestPriority::Session, PROD_URL, [] { return 0; });
+		REQUIRE(SecondsSince(begin) < 0.2);
+	}
+
+	SECTION("Rate limited host cools down")
+	{
+		auto budget = MakeBudget(100.0, 10.0);
+		budget.rate_limited_cooldown = 300ms;
+		scheduler.SetHostBudget(PROD_URL, budget);
+
+		scheduler.Run(RequestPriority::Interactive, PROD_URL, [] { return 0; });
+		scheduler.OnRateLimited(PROD_URL);
+
+		auto begin = std::chrono::steady_clock::now();
+		scheduler.Run(RequestPriority::Interactive, PROD_URL, [] { return 0; });
+		REQUIRE(SecondsSince(begin) >= 0.25);
+	}
+
+	SECTION("Async admission takes tokens but no in flight slot")
+	{
+		scheduler.SetDefaultBudget(MakeBudget(5.0, 2.0));
+
+		// Pooled request still running doesn't hold back requests on another client
+		std::atomic <bool> release{ false };
+		std::thread running([&] {
+			scheduler.Run(RequestPriority::Interactive, PROD_URL, [&] {
+				while (!release)
+				{
+					std::this_thread::sleep_for(1ms);
+				}
+				return 0;
+			});
+		});
+		while (scheduler.GetAdmittedCount(RequestPriority::Interactive) < 1)
+		{
+			std::this_thread::sleep_for(1ms);
+		}
+
+		std::promise <double> first;
+		std::promise <double> second;
+		auto first_admitted = first.get_future();
+		auto second_admitted = second.get_future();
+
+		auto begin = std::chrono::steady_clock::now();
+		scheduler.AcquireAsync(RequestPriority::Bulk, PROD_URL, [&] { first.set_value(SecondsSince(begin)); });
+		scheduler.AcquireAsync(RequestPriority::Bulk, PROD_URL, [&] { second.set_value(SecondsSince(begin)); });
+
+		// Callers never wait for tokens
+		REQUIRE(SecondsSince(begin) < 0.05);
+
+		REQUIRE(first_admitted.get() < 0.1);
+		// Burst is spent, next token takes 1 / 5 s
+		REQUIRE(second_admitted.get() >= 0.15);
+		REQUIRE(scheduler.GetAdmittedCount(RequestPriority::Bulk) == 2);
+
+		release = true;
+		running.join();
+	}
+
+	SECTION("In flight is limited to pooled clients")
+	{
+		// Pool with two clients per host
+		RequestScheduler pooled(2);
+		pooled.SetDefaultBudget(MakeBudget(0.0, 0.0));
+
+		std::atomic <bool> release{ false };
+		std::atomic <int> running{ 0 };
+		std::atomic <int> max_running{ 0 };
+
+		std::vector <std::thread> threads;
+		for (auto i = 0; i < 4; ++i)
+		{
+			threads.emplace_back([&] {
+				pooled.Run(RequestPriority::Interactive, PROD_URL, [&] {
+					auto count = ++running;
+					auto max = max_running.load();
+					while (count > max && !max_running.compare_exchange_weak(max, count))
+						;
+					while (!release)
+					{
+						std::this_thread::sleep_for(1ms);
+					}
+					--running;
+					return 0;
+				});
+			});
+		}
+		while (running < 2 || pooled.GetQueuedCount() < 2)
+		{
+			std::this_thread::sleep_for(1ms);
+		}
+
+		release = true;
+		for (auto& thread : threads)
+		{
+			thread.join();
+		}
+
+		REQUIRE(max_running == 2);
+		REQUIRE(pooled.GetAdmittedCount(RequestPriority::Interactive) == 4);
+	}
+
+	SECTION("Exceptions give in flight slot back")
+	{
+		scheduler.SetDefaultBudget(MakeBudget(0.0, 0.0));
+
+		REQUIRE_THROWS_AS(scheduler.Run(RequestPriority::Interactive, PROD_URL, []() -> int { throw std::runtime_error("failed"); }), std::runtime_error);
+		REQUIRE(scheduler.Run(RequestPriority::Interactive, PROD_URL, [] { return 1; }) == 1);
+	}
+
+	SECTION("Stopped scheduler admits everything")
+	{
+		scheduler.SetDefaultBudget(MakeBudget(0.001, 0.0));
+
+		std::thread waiting([&] {
+			scheduler.Run(RequestPriority::Bulk, PROD_URL, [] { return 0; });
+		});
+		while (scheduler.GetQueuedCount() < 1)
+		{
+			std::this_thread::sleep_for(1ms);
+		}
+
+		scheduler.Stop();
+		waiting.join();
+
+		REQUIRE(scheduler.Run(RequestPriority::Bulk, PROD_URL, [] { return 2; }) == 2);
+
+		auto admitted = false;
+		scheduler.AcquireAsync(RequestPriority::Bulk, PROD_URL, [&] { admitted = true; });
+		REQUIRE(admitted);
+	}
+}
@@ -0,0 +1,78 @@
+#include <catch2/catch.hpp>
+
+#include "../src/StashHelper.hpp"
+
+using namespace TarkovAPI;
+
+TEST_CASE("Stash grid", "[multi-file:16]")
+{
+	auto stash = StashHelper{ 10, 28 };
+
+	SECTION("Put, IsEmpty and Clear")
+	{
+		REQUIRE(stash.IsEmpty(1, 10, 28));
+
+		REQUIRE(stash.Put(stash.GetStashPos(2, 3), 2, 2));
+		REQUIRE_FALSE(stash.IsEmpty(stash.GetStashPos(3, 4), 1, 1));
+		REQUIRE_FALSE(stash.IsEmpty(stash.GetStashPos(0, 2), 3, 2));
+		REQUIRE(stash.IsEmpty(stash.GetStashPos(4, 3), 6, 2));
+		REQUIRE(stash.IsEmpty(stash.GetStashPos(2, 5), 2, 2));
+
+		// Out of grid
+		REQUIRE_FALSE(stash.IsEmpty(stash.GetStashPos(9, 0), 2, 1));
+		REQUIRE_FALSE(stash.IsEmpty(stash.GetStashPos(0, 27), 1, 2));
+		REQUIRE_FALSE(stash.Put(stash.GetStashPos(9, 0), 2, 1));
+		REQUIRE_FALSE(stash.IsEmpty(0, 1, 1));
+
+		stash.Clear(stash.GetStashPos(2, 3), 2, 2);
+		REQUIRE(stash.IsEmpty(1, 10, 28));
+	}
+
+	SECTION("First fit in row major order")
+	{
+		REQUIRE(stash.FindBlank(1, 1) == 1);
+		REQUIRE(stash.FindBlank(10, 28) == 1);
+		REQUIRE(stash.FindBlank(11, 1) == -1);
+		REQUIRE(stash.FindBlank(1, 29) == -1);
+
+		stash.Put(stash.GetStashPos(0, 0), 4, 1);
+		stash.Put(stash.GetStashPos(6, 0), 4, 2);
+		REQUIRE(stash.FindBlank(2, 1) == stash.GetStashPos(4, 0));
+		REQUIRE(stash.FindBlank(3, 1) == stash.GetStashPos(0, 1));
+		REQUIRE(stash.FindBlank(2, 2) == stash.GetStashPos(4, 0));
+		REQUIRE(stash.FindBlank(5, 2) == stash.GetStashPos(0, 1));
+		REQUIRE(stash.FindBlank(7, 2) == stash.GetStashPos(0, 2));
+
+		// Every free cell is reported once each other cell is taken
+		auto full = StashHelper{ 10, 28 };
+		full.Put(1, 10, 28);
+		full.Clear(full.GetStashPos(7, 19), 1, 1);
+		REQUIRE(full.FindBlank(1, 1) == full.GetStashPos(7, 19));
+		REQUIRE(full.FindBlank(1, 2) == -1);
+	}
+
+	SECTION("Rotation")
+	{
+		// Only a 1 wide column is left on the right side of first 5 rows
+		stash.Put(stash.GetStashPos(0, 0), 9, 5);
+		stash.Put(stash.GetStashPos(0, 5), 10, 23);
+
+		auto rotated = false;
+		REQUIRE(stash.FindBlank(5, 1, rotated) == stash.GetStashPos(9, 0));
+		REQUIRE(rotated);
+		REQUIRE(stash.FindBlank(5, 1) == -1);
+
+		REQUIRE(stash.FindBlank(1, 3, rotated) == stash.GetStashPos(9, 0));
+		REQUIRE_FALSE(rotated);
+	}
+
+	SECTION("Full width rows")
+	{
+		auto wide = StashHelper{ 64, 4 };
+		wide.Put(1, 63, 1);
+		REQUIRE(wide.FindBlank(1, 1) == wide.GetStashPos(63, 0));
+		REQUIRE(wide.FindBlank(64, 3) == wide.GetStashPos(0, 1));
+
+		REQUIRE_THROWS(StashHelper{ 65, 1 });
+	}
+}
@@ -0,0 +1,175 @@
+#include <catch2/catch.hpp>
+#include <thread>
+#include <atomic>
+#include <chrono>
+#include <stdexcept>
+
+#include "../src/TimerService.hpp"
+#include "../src/Metrics.hpp"
+
+using namespace TarkovAPI;
+using namespace std::chrono_literals;
+
+template <typename P>
+static bool WaitFor(P predicate, std::chrono::milliseconds timeout = 3000ms)
+{
+	auto deadline = std::chrono::steady_clock::now() + timeout;
+	while (!predicate())
+	{
+		if (std::chrono::steady_clock::now() > deadline)
+		{
+			return false;
+		}
+		std::this_thread::sleep_for(5ms);
+	}
+	return true;
+}
+
+static const TimerJobStats* FindStats(const std::vector <TimerJobStats>& stats, TimerJobId id)
+{
+	for (const auto& job : stats)
+	{
+		if (job.id == id)
+		{
+			return &job;
+		}
+	}
+	return nullptr;
+}
+
+TEST_CASE("Timer service", "[multi-file:11]")
+{
+	TimerService service;
+
+	SECTION("Periodic job runs repeatedly")
+	{
+		std::atomic <int> runs{ 0 };
+		auto id = service.Schedule("Periodic", 100ms, [&] { runs++; }, 0ms);
+
+		REQUIRE(WaitFor([&] { return runs >= 3; }));
+
+		auto stats = service.GetJobStats();
+		auto job = FindStats(stats, id);
+		REQUIRE(job);
+		REQUIRE(job->name == "Periodic");
+		REQUIRE(job->runs >= 3);
+		REQUIRE(job->failures == 0);
+	}
+
+	SECTION("Cancelled job does not run again")
+	{
+		std::atomic <int> runs{ 0 };
+		auto id = service.Schedule("Cancelled", 100ms, [&] { runs++; }, 0ms);
+
+		REQUIRE(WaitFor([&] { return runs >= 1; }));
+		REQUIRE(service.Cancel(id));
+		REQUIRE_FALSE(service.Cancel(id));
+
+		auto after_cancel = runs.load();
+		std::this_thread::sleep_for(300ms);
+		REQUIRE(runs == after_cancel);
+		REQUIRE(service.GetJobCount() == 0);
+	}
+
+	SECTION("Cancel waits for running invocation")
+	{
+		std::atomic <bool> started{ false };
+		std::atomic <bool> finished{ false };
+		auto id = service.Schedule("Slow", 100ms, [&] {
+			started = true;
+			std::this_thread::sleep_for(200ms);
+			finished = true;
+		}, 0ms);
+
+		REQUIRE(WaitFor([&] { return started.load(); }));
+		REQUIRE(service.Cancel(id));
+		REQUIRE(finished);
+	}
+
+	SECTION("Job may cancel itself")
+	{
+		std::atomic <int> runs{ 0 };
+		TimerJobId id = 0;
+		std::atomic <bool> scheduled{ false };
+		id = service.Schedule("Once", 100ms, [&] {
+			while (!scheduled)
+			{
+				std::this_thread::yield();
+			}
+			runs++;
+			service.Cancel(id);
+		}, 0ms);
+		scheduled = true;
+
+		REQUIRE(WaitFor([&] { return runs >= 1; }));
+		std::this_thread::sleep_for(300ms);
+		REQUIRE(runs == 1);
+	}
+
+	SECTION("Failing job is counted and stays scheduled")
+	{
+		MetricsRegistry::Instance().Reset();
+
+		std::atomic <int> runs{ 0 };
+		auto id = service.Schedule("Failing", 100ms, [&] {
+			runs++;
+			throw std::runtime_error("refresh failed");
+		}, 0ms);
+
+		REQUIRE(WaitFor([&] { return runs >= 2; }));
+		service.Cancel(id);
+
+		auto stats = service.GetJobStats();
+		REQUIRE(FindStats(stats, id) == nullptr);
+
+		auto jobs = MetricsRegistry::Instance().GetJobSnapshot();
+		REQUIRE(jobs.size() == 1);
+		REQUIRE(jobs[0].name == "Failing");
+		REQUIRE(jobs[0].runs == static_cast<uint64_t>(runs.load()));
+		REQUIRE(jobs[0].failures == jobs[0].runs);
+		REQUIRE(MetricsRegistry::Instance().ToPrometheus().find("tarkovapi_job_failures_total{job=\"Failing\"}") != std::string::npos);
+	}
+
+	SECTION("Last error is reported")
+	{
+		std::atomic <int> runs{ 0 };
+		auto id = service.Schedule("Error", 100ms, [&] {
+			runs++;
+			throw std::runtime_error("no session");
+		}, 0ms);
+
+		REQUIRE(WaitFor([&] {
+			auto stats = service.GetJobStats();
+			auto job = FindStats(stats, id);
+			return job && job->failures >= 1;
+		}));
+
+		auto stats = service.GetJobStats();
+		REQUIRE(FindStats(stats, id)->last_error == "no session");
+	}
+
+	SECTION("Long delay spans several wheel rounds")
+	{
+		std::atomic <int> runs{ 0 };
+		service.Schedule("Hourly", 1h, [&] { runs++; });
+
+		std::this_thread::sleep_for(300ms);
+		REQUIRE(runs == 0);
+		REQUIRE(service.GetJobCount() == 1);
+	}
+
+	SECTION("Stop cancels everything and joins")
+	{
+		std::atomic <int> runs{ 0 };
+		service.Schedule("First", 100ms, [&] { runs++; }, 0ms);
+		service.Schedule("Second", 100ms, [&] { runs++; }, 0ms);
+
+		REQUIRE(WaitFor([&] { return runs >= 2; }));
+		service.Stop();
+
+		auto after_stop = runs.load();
+		std::this_thread::sleep_for(200ms);
+		REQUIRE(runs == after_stop);
+		REQUIRE(service.GetJobCount() == 0);
+	}
+}
@@ -0,0 +1,125 @@
+#include <catch2/catch.hpp>
+#include <json.hpp>
+#include <thread>
+#include <vector>
+#include <set>
+
+#include "../src/Trace.hpp"
+
+using namespace TarkovAPI;
+using json = nlohmann::json;
+
+static void TracedLeaf()
+{
+	TRACE_SCOPE_DETAIL("Leaf", "/client/items");
+}
+
+static void TracedParent()
+{
+	TRACE_SCOPE("Parent");
+	TracedLeaf();
+}
+
+TEST_CASE("Trace span collector", "[multi-file:9]")
+{
+	auto& collector = TraceCollector::Instance();
+	collector.Clear();
+
+	SECTION("Disabled collector records nothing")
+	{
+		collector.Disable();
+		TracedParent();
+
+		auto trace = json::parse(collector.ExportJson());
+		REQUIRE(trace["traceEvents"].empty());
+	}
+
+	SECTION("Nested spans")
+	{
+		collector.Enable();
+		TracedParent();
+		collector.Disable();
+
+		auto events = json::parse(collector.ExportJson())["traceEvents"];
+		REQUIRE(events.size() == 2);
+
+		// Inner span closes first
+		const auto& leaf = events[0];
+		const auto& parent = events[1];
+		REQUIRE(leaf["name"] == "Leaf");
+		REQUIRE(leaf["ph"] == "X");
+		REQUIRE(leaf["args"]["detail"] == "/client/items");
+		REQUIRE(parent["name"] == "Parent");
+		REQUIRE_FALSE(parent.contains("args"));
+		REQUIRE(leaf["tid"] == parent["tid"]);
+		REQUIRE(leaf["ts"].get<uint64_t>() >= parent["ts"].get<uint64_t>());
+		REQUIRE(leaf["ts"].get<uint64_t>() + leaf["dur"].get<uint64_t>() <= parent["ts"].get<uint64_t>() + parent["dur"].get<uint64_t>());
+
+		// Exported events are drained
+		REQUIRE(json::parse(collector.ExportJson())["traceEvents"].empty());
+	}
+
+	SECTION("Spans from many threads span several chunks")
+	{
+		const auto spans_per_thread = TRACE_CHUNK_EVENTS * 3 + 7;
+
+		collector.Enable();
+
+		std::vector <std::thread> threads;
+		for (auto i = 0; i < 4; ++i)
+		{
+			threads.emplace_back([spans_per_thread] {
+				for (size_t n = 0; n < spans_per_thread; ++n)
+				{
+					TRACE_SCOPE("Worker");
+				}
+			});
+		}
+
+		// Exporting while threads record must not lose or duplicate events
+		auto exported = size_t(0);
+		auto tids = std::set <uint32_t>();
+		auto collect = [&] {
+			auto trace = json::parse(collector.ExportJson());
+			for (const auto& event : trace["traceEvents"])
+			{
+				if (event["name"] == "Worker")
+				{
+					exported++;
+					tids.emplace(event["tid"].get<uint32_t>());
+				}
+			}
+		};
+		for (auto i = 0; i < 5; ++i)
+		{
+			collect();
+			std::this_thread::yield();
+		}
+
+		for (auto& thread : threads)
+		{
+			thread.join();
+		}
+		collector.Disable();
+		collect();
+
+		REQUIRE(exported == spans_per_thread * 4);
+		REQUIRE(tids.size() == 4);
+	}
+
+	SECTION("Long details are truncated")
+	{
+		collector.Enable();
+		{
+			TRACE_SCOPE_DETAIL("Long", std::string(200, 'a'));
+		}
+		collector.Disable();
+
+		auto events = json::parse(collector.ExportJson())["traceEvents"];
+		REQUIRE(events.size() == 1);
+		REQUIRE(events[0]["args"]["detail"].get<std::string>().size() == TRACE_DETAIL_SIZE - 1);
+	}
+
+	collector.Disable();
+	collector.Clear();
+}
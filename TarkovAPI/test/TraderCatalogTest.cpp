@@ -0,0 +1,78 @@
+#include <catch2/catch.hpp>
+#include <string>
+#include <vector>
+
+#include "../src/TraderCatalog.hpp"
+
+using namespace TarkovAPI;
+
+static quicktype::TraderItem MakeOffer(const char* id, const char* tpl, int64_t loyalty_level)
+{
+	auto offer = quicktype::TraderItem{};
+	offer._id = ObjectId(id);
+	offer._tpl = ObjectId(tpl);
+	offer.loyalty_level = loyalty_level;
+	offer.costs.emplace_back(quicktype::TraderBarterItem{ ObjectId("5449016a4bdc2d6f028b456f"), 1000.0 });
+	return offer;
+}
+
+static std::vector <uint32_t> ToVector(const ItemRange& range)
+{
+	return std::vector <uint32_t>(range.begin(), range.end());
+}
+
+TEST_CASE("Trader catalog", "[multi-file:19]")
+{
+	auto assorts = std::vector <std::pair <std::string, std::vector <quicktype::TraderItem>>>();
+	assorts.emplace_back("54cb50c76803fa8b248b4571", std::vector <quicktype::TraderItem>{
+		MakeOffer("700000000000000000000001", "5448be9a4bdc2dfd2f8b456a", 2),
+		MakeOffer("700000000000000000000002", "544fb3364bdc2d34748b456a", 1),
+		MakeOffer("700000000000000000000003", "5448be9a4bdc2dfd2f8b456a", 1)
+	});
+	assorts.emplace_back("5c0647fdd443bc2504c2d371", std::vector <quicktype::TraderItem>{
+		MakeOffer("700000000000000000000004", "5448be9a4bdc2dfd2f8b456a", 3)
+	});
+	assorts.emplace_back("5ac3b934156ae10c4430e83c", std::vector <quicktype::TraderItem>());
+
+	auto catalog = TraderCatalog(std::move(assorts));
+
+	SECTION("Offers in trader order")
+	{
+		REQUIRE(catalog.GetCount() == 4);
+		REQUIRE(catalog.GetTraderCount() == 3);
+		REQUIRE(catalog.GetOffer(0)._id == ObjectId("700000000000000000000001"));
+		REQUIRE(catalog.GetOffer(3)._id == ObjectId("700000000000000000000004"));
+		REQUIRE(catalog.GetOffer(3).costs.size() == 1);
+		REQUIRE(catalog.GetTraderId(2) == "54cb50c76803fa8b248b4571");
+		REQUIRE(catalog.GetTraderId(3) == "5c0647fdd443bc2504c2d371");
+	}
+
+	SECTION("By trader and loyalty level")
+	{
+		// Lowest level first, assort order inside a level
+		REQUIRE(ToVector(catalog.FindByTrader("54cb50c76803fa8b248b4571")) == std::vector <uint32_t>{ 1, 2, 0 });
+		REQUIRE(ToVector(catalog.FindByTrader("54cb50c76803fa8b248b4571", 1)) == std::vector <uint32_t>{ 1, 2 });
+		REQUIRE(catalog.FindByTrader("54cb50c76803fa8b248b4571", 0).empty());
+		REQUIRE(catalog.FindByTrader("5c0647fdd443bc2504c2d371", 2).empty());
+		REQUIRE(catalog.FindByTrader("5c0647fdd443bc2504c2d371", 4).size() == 1);
+
+		// Trader without offers is counted, but has nothing to find
+		REQUIRE(catalog.FindByTrader("5ac3b934156ae10c4430e83c").empty());
+		REQUIRE(catalog.FindByTrader("unknown").empty());
+	}
+
+	SECTION("By template")
+	{
+		REQUIRE(ToVector(catalog.FindByTemplate(ObjectId("5448be9a4bdc2dfd2f8b456a"))) == std::vector <uint32_t>{ 0, 2, 3 });
+		REQUIRE(catalog.FindByTemplate(ObjectId("544fb3364bdc2d34748b456a")).size() == 1);
+		REQUIRE(catalog.FindByTemplate(ObjectId("5449016a4bdc2d6f028b456f")).empty());
+	}
+
+	SECTION("Empty catalog")
+	{
+		auto empty = TraderCatalog();
+		REQUIRE(empty.GetCount() == 0);
+		REQUIRE(empty.FindByTrader("54cb50c76803fa8b248b4571").empty());
+		REQUIRE(empty.FindByTemplate(ObjectId("5448be9a4bdc2dfd2f8b456a")).empty());
+	}
+}
@@ -0,0 +1,163 @@
+#include <catch2/catch.hpp>
+#include <json.hpp>
+#include <zlib.h>
+#include <cstdio>
+#include <fstream>
+#include <future>
+
+#include "../src/TrafficCapture.hpp"
+#include "../src/HttpClient.hpp"
+#include "../src/AsyncHttpClient.hpp"
+#include "../src/Exception.hpp"
+
+using namespace TarkovAPI;
+using json = nlohmann::json;
+
+static std::string CompressJson(const json& data)
+{
+	auto raw = data.dump();
+	auto out = std::string(compressBound(static_cast<uLong>(raw.size())), '\0');
+
+	auto out_size = static_cast<uLongf>(out.size());
+	auto ret = compress(reinterpret_cast<Bytef*>(&out[0]), &out_size, reinterpret_cast<const Bytef*>(raw.data()), static_cast<uLong>(raw.size()));
+	REQUIRE(ret == Z_OK);
+
+	out.resize(out_size);
+	return out;
+}
+
+TEST_CASE("Traffic capture and replay", "[multi-file:7]")
+{
+	const auto path = std::string("TrafficCaptureTest.cap");
+	std::remove(path.c_str());
+	std::remove((path + ".idx").c_str());
+
+	const auto headers = cpr::Header{
+		{"Content-Type", "application/json"},
+		{"Cookie", "PHPSESSID=secret-session"},
+		{"Authorization", "secret-token"}
+	};
+
+	{
+		TrafficCapture capture(path);
+		capture.Append("https://prod.escapefromtarkov.com/client/items", "", headers, 200, CompressJson({ {"err", 0}, {"errmsg", nullptr}, {"data", {{"step", 1}}} }));
+		capture.Append("https://prod.escapefromtarkov.com/client/items", "", headers, 200, CompressJson({ {"err", 0}, {"errmsg", nullptr}, {"data", {{"step", 2}}} }));
+		capture.Append("https://launcher.escapefromtarkov.com/launcher/login?branch=live", R"({"email":"a@b.c","pass":"hash","hwCode":"hw"})", headers, 200, CompressJson({ {"err", 0}, {"errmsg", nullptr}, {"data", {{"access_token", "t"}}} }));
+		capture.Append("https://prod.escapefromtarkov.com/client/weather", "", headers, 502, "Bad Gateway");
+		REQUIRE(capture.GetRecordCount() == 4);
+	}
+
+	SECTION("Secrets are not written")
+	{
+		auto records = TrafficCapture::ReadRecords(path);
+		REQUIRE(records.size() == 4);
+
+		for (const auto& record : records)
+		{
+			REQUIRE(record.headers.find("secret") == std::string::npos);
+			REQUIRE(record.headers.find("Content-Type: application/json") != std::string::npos);
+		}
+		REQUIRE(records[2].body.find("a@b.c") == std::string::npos);
+		REQUIRE(records[2].body.find("hash") == std::string::npos);
+		REQUIRE(json::parse(records[2].body)["pass"] == "<redacted>");
+	}
+
+	SECTION("Index is rebuilt from data file")
+	{
+		std::remove((path + ".idx").c_str());
+		REQUIRE(TrafficCapture::ReadRecords(path).size() == 4);
+
+		// Torn tail record is ignored
+		std::ofstream(path, std::ios::binary | std::ios::app) << "TKVR-partial";
+		REQUIRE(TrafficCapture::ReadRecords(path).size() == 4);
+	}
+
+	SECTION("Replay in recorded order")
+	{
+		TrafficReplay replay(path);
+		REQUIRE(replay.GetRecordCount() == 4);
+
+		HttpClient client;
+		client.SetReplay(&replay);
+
+		// Host is not part of the key, capture can be replayed against overridden endpoints
+		REQUIRE(client.PostJson("http://127.0.0.1:8080/client/items", "", headers)["data"]["step"] == 1);
+		REQUIRE(client.PostJson("https://prod.escapefromtarkov.com/client/items", "", headers)["data"]["step"] == 2);
+		REQUIRE(client.PostJson("https://prod.escapefromtarkov.com/client/items", "", headers)["data"]["step"] == 2); // last one repeats
+
+		REQUIRE(client.PostJson("https://launcher.escapefromtarkov.com/launcher/login?branch=live", R"({"email":"x@y.z","pass":"other","hwCode":"hw2"})", headers)["data"]["access_token"] == "t");
+
+		try
+		{
+			client.PostJson("https://prod.escapefromtarkov.com/client/weather", "", headers);
+			FAIL("Captured status code is not replayed");
+		}
+		catch (const TarkovAPIException& ex)
+		{
+			REQUIRE(ex.getErrorID() == Error::CprPostFailed);
+			REQUIRE(ex.getErrorDesc() == "502");
+		}
+
+		try
+		{
+			client.PostJson("https://prod.escapefromtarkov.com/client/locations", "", headers);
+			FAIL("Unknown request is replayed");
+		}
+		catch (const TarkovAPIException& ex)
+		{
+			REQUIRE(ex.getErrorID() == Error::ReplayNotFound);
+		}
+	}
+
+	SECTION("Async replay")
+	{
+		AsyncHttpClient client;
+		client.SetReplay(std::make_shared<TrafficReplay>(path));
+
+		auto post = [&client, &headers](const std::string& url) {
+			auto promise = std::make_shared<std::promise <std::pair <json, TransferMetrics>>>();
+			auto future = promise->get_future();
+			client.PostJson(url, "", headers, [promise](json&& response, std::exception_ptr error, const TransferMetrics& transfer) {
+				if (error)
+				{
+					promise->set_exception(error);
+					return;
+				}
+				promise->set_value(std::make_pair(std::move(response), transfer));
+			});
+			return future.get();
+		};
+
+		auto first = post("http://127.0.0.1:8080/client/items");
+		REQUIRE(first.first["data"]["step"] == 1);
+		REQUIRE(first.second.compressed_bytes > 0);
+		REQUIRE(first.second.decompressed_bytes == first.first.dump().size());
+		REQUIRE(first.second.network_us == 0);
+
+		REQUIRE(post("https://prod.escapefromtarkov.com/client/items").first["data"]["step"] == 2);
+
+		try
+		{
+			post("https://prod.escapefromtarkov.com/client/weather");
+			FAIL("Captured status code is not replayed");
+		}
+		catch (const TarkovAPIException& ex)
+		{
+			REQUIRE(ex.getErrorID() == Error::CprPostFailed);
+			REQUIRE(ex.getErrorDesc() == "502");
+		}
+
+		try
+		{
+			post("https://prod.escapefromtarkov.com/client/locations");
+			FAIL("Unknown request is replayed");
+		}
+		catch (const TarkovAPIException& ex)
+		{
+			REQUIRE(ex.getErrorID() == Error::ReplayNotFound);
+		}
+	}
+
+	std::remove(path.c_str());
+	std::remove((path + ".idx").c_str());
+}